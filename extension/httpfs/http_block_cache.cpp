@@ -0,0 +1,333 @@
+#include "http_block_cache.hpp"
+
+#include "duckdb/common/random_engine.hpp"
+#include "duckdb/common/string_util.hpp"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+constexpr idx_t HTTPBlockCache::BLOCK_SIZE;
+constexpr idx_t HTTPBlockCache::DEFAULT_MEMORY_LIMIT;
+constexpr idx_t HTTPBlockCache::DEFAULT_DISK_LIMIT;
+constexpr const char *HTTPBlockCache::DISK_FILE_PREFIX;
+
+static string UniqueFilePrefix() {
+#ifdef _WIN32
+	auto pid = _getpid();
+#else
+	auto pid = getpid();
+#endif
+	RandomEngine random;
+	return StringUtil::Format("%s%d_%08x%08x_", HTTPBlockCache::DISK_FILE_PREFIX, (int64_t)pid,
+	                          random.NextRandomInteger(), random.NextRandomInteger());
+}
+
+HTTPBlockCache::HTTPBlockCache()
+    : local_fs(FileSystem::CreateLocal()), memory_limit(DEFAULT_MEMORY_LIMIT), memory_usage(0),
+      disk_file_prefix(UniqueFilePrefix()), disk_limit(DEFAULT_DISK_LIMIT), disk_usage(0), disk_file_count(0),
+      memory_hits(0), disk_hits(0), fetched_blocks(0) {
+}
+
+HTTPBlockCache::~HTTPBlockCache() {
+	// the disk cache does not outlive the database
+	for (auto &entry : disk_blocks) {
+		try {
+			local_fs->RemoveFile(entry.second.path);
+		} catch (...) {
+		}
+	}
+}
+
+static string BlockKey(const string &file_key, idx_t block_idx) {
+	return file_key + "\n" + std::to_string(block_idx);
+}
+
+void HTTPBlockCache::SetLimits(idx_t memory_limit_p, const string &disk_directory_p, idx_t disk_limit_p) {
+	vector<pair<string, shared_ptr<HTTPCachedBlock>>> evicted;
+	{
+		lock_guard<mutex> guard(lock);
+		if (memory_limit == memory_limit_p && disk_directory == disk_directory_p && disk_limit == disk_limit_p) {
+			return;
+		}
+		if (disk_directory != disk_directory_p) {
+			// the blocks in the old directory are no longer used
+			while (!disk_blocks.empty()) {
+				RemoveDiskEntry(disk_blocks.begin());
+			}
+			disk_directory = disk_directory_p;
+			// the directory can be shared with other processes: we only ever remove the files this instance wrote
+			if (!disk_directory.empty() && !local_fs->DirectoryExists(disk_directory)) {
+				local_fs->CreateDirectory(disk_directory);
+			}
+		}
+		memory_limit = memory_limit_p;
+		disk_limit = disk_limit_p;
+		evicted = EvictFromMemory();
+		EvictFromDisk();
+	}
+	WriteToDisk(move(evicted));
+}
+
+HTTPBlockCacheStatistics HTTPBlockCache::GetStatistics() {
+	lock_guard<mutex> guard(lock);
+	HTTPBlockCacheStatistics statistics;
+	statistics.memory_usage = memory_usage;
+	statistics.disk_usage = disk_usage;
+	statistics.memory_hits = memory_hits;
+	statistics.disk_hits = disk_hits;
+	statistics.fetched_blocks = fetched_blocks;
+	return statistics;
+}
+
+void HTTPBlockCache::Read(const string &file_key, idx_t file_size, idx_t location, char *buffer, idx_t size,
+                          const fetch_function_t &fetch) {
+	if (size == 0) {
+		return;
+	}
+	D_ASSERT(location + size <= file_size);
+	auto copy_block = [&](const HTTPCachedBlock &block, idx_t block_idx) {
+		auto block_start = block_idx * BLOCK_SIZE;
+		auto copy_start = MaxValue<idx_t>(location, block_start);
+		auto copy_end = MinValue<idx_t>(location + size, block_start + block.size);
+		D_ASSERT(copy_start < copy_end);
+		memcpy(buffer + (copy_start - location), block.data.get() + (copy_start - block_start), copy_end - copy_start);
+	};
+
+	auto last_block = (location + size - 1) / BLOCK_SIZE;
+	auto block_idx = location / BLOCK_SIZE;
+	while (block_idx <= last_block) {
+		auto block = Lookup(BlockKey(file_key, block_idx));
+		if (block) {
+			copy_block(*block, block_idx);
+			block_idx++;
+			continue;
+		}
+		// coalesce the run of adjacent blocks that are not cached into a single request
+		auto run_end = block_idx + 1;
+		while (run_end <= last_block && !IsCached(BlockKey(file_key, run_end))) {
+			run_end++;
+		}
+		auto fetch_start = block_idx * BLOCK_SIZE;
+		auto fetch_end = MinValue<idx_t>(run_end * BLOCK_SIZE, file_size);
+		auto fetch_buffer = unique_ptr<data_t[]>(new data_t[fetch_end - fetch_start]);
+		fetch(fetch_start, (char *)fetch_buffer.get(), fetch_end - fetch_start);
+		{
+			lock_guard<mutex> guard(lock);
+			fetched_blocks += run_end - block_idx;
+		}
+
+		for (; block_idx < run_end; block_idx++) {
+			auto block_start = block_idx * BLOCK_SIZE;
+			auto block_size = MinValue<idx_t>(BLOCK_SIZE, file_size - block_start);
+			auto block_data = unique_ptr<data_t[]>(new data_t[block_size]);
+			memcpy(block_data.get(), fetch_buffer.get() + (block_start - fetch_start), block_size);
+			auto new_block = make_shared<HTTPCachedBlock>(move(block_data), block_size);
+			copy_block(*new_block, block_idx);
+			Insert(BlockKey(file_key, block_idx), move(new_block));
+		}
+	}
+}
+
+shared_ptr<HTTPCachedBlock> HTTPBlockCache::Lookup(const string &key) {
+	string disk_path;
+	idx_t disk_size;
+	{
+		lock_guard<mutex> guard(lock);
+		auto entry = memory_blocks.find(key);
+		if (entry != memory_blocks.end()) {
+			memory_lru.splice(memory_lru.begin(), memory_lru, entry->second.lru_position);
+			memory_hits++;
+			return entry->second.block;
+		}
+		auto disk_entry = disk_blocks.find(key);
+		if (disk_entry == disk_blocks.end()) {
+			return nullptr;
+		}
+		disk_lru.splice(disk_lru.begin(), disk_lru, disk_entry->second.lru_position);
+		disk_path = disk_entry->second.path;
+		disk_size = disk_entry->second.size;
+	}
+	// read the block from disk outside of the lock, and move it back into memory
+	auto block_data = unique_ptr<data_t[]>(new data_t[disk_size]);
+	try {
+		auto handle = local_fs->OpenFile(disk_path, FileFlags::FILE_FLAGS_READ);
+		handle->Read(block_data.get(), disk_size, 0);
+	} catch (...) {
+		// the block was evicted from disk in the meantime
+		return nullptr;
+	}
+	{
+		lock_guard<mutex> guard(lock);
+		disk_hits++;
+	}
+	auto block = make_shared<HTTPCachedBlock>(move(block_data), disk_size);
+	Insert(key, block);
+	return block;
+}
+
+bool HTTPBlockCache::IsCached(const string &key) {
+	lock_guard<mutex> guard(lock);
+	return memory_blocks.find(key) != memory_blocks.end() || disk_blocks.find(key) != disk_blocks.end();
+}
+
+void HTTPBlockCache::Insert(const string &key, shared_ptr<HTTPCachedBlock> block) {
+	vector<pair<string, shared_ptr<HTTPCachedBlock>>> evicted;
+	{
+		lock_guard<mutex> guard(lock);
+		if (memory_blocks.find(key) != memory_blocks.end()) {
+			// another thread fetched the same block concurrently
+			return;
+		}
+		memory_lru.push_front(key);
+		memory_usage += block->size;
+		MemoryEntry entry;
+		entry.block = move(block);
+		entry.lru_position = memory_lru.begin();
+		memory_blocks[key] = move(entry);
+		evicted = EvictFromMemory();
+	}
+	WriteToDisk(move(evicted));
+}
+
+vector<pair<string, shared_ptr<HTTPCachedBlock>>> HTTPBlockCache::EvictFromMemory() {
+	vector<pair<string, shared_ptr<HTTPCachedBlock>>> evicted;
+	while (memory_usage > memory_limit && !memory_lru.empty()) {
+		auto entry = memory_blocks.find(memory_lru.back());
+		D_ASSERT(entry != memory_blocks.end());
+		memory_usage -= entry->second.block->size;
+		if (!disk_directory.empty() && disk_limit > 0 && disk_blocks.find(entry->first) == disk_blocks.end()) {
+			evicted.emplace_back(entry->first, move(entry->second.block));
+		}
+		memory_blocks.erase(entry);
+		memory_lru.pop_back();
+	}
+	return evicted;
+}
+
+void HTTPBlockCache::WriteToDisk(vector<pair<string, shared_ptr<HTTPCachedBlock>>> blocks) {
+	for (auto &evicted : blocks) {
+		string directory;
+		idx_t file_number;
+		{
+			lock_guard<mutex> guard(lock);
+			if (disk_directory.empty() || disk_blocks.find(evicted.first) != disk_blocks.end()) {
+				continue;
+			}
+			directory = disk_directory;
+			file_number = disk_file_count++;
+		}
+		// the block is written outside of the lock
+		auto path = local_fs->JoinPath(directory, disk_file_prefix + std::to_string(file_number));
+		auto &block = *evicted.second;
+		auto handle = local_fs->OpenFile(path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		handle->Write(block.data.get(), block.size, 0);
+		handle.reset();
+
+		lock_guard<mutex> guard(lock);
+		if (directory != disk_directory || disk_blocks.find(evicted.first) != disk_blocks.end()) {
+			local_fs->RemoveFile(path);
+			continue;
+		}
+		disk_lru.push_front(evicted.first);
+		disk_usage += block.size;
+		DiskEntry entry;
+		entry.path = path;
+		entry.size = block.size;
+		entry.lru_position = disk_lru.begin();
+		disk_blocks[evicted.first] = move(entry);
+		EvictFromDisk();
+	}
+}
+
+void HTTPBlockCache::EvictFromDisk() {
+	while (disk_usage > disk_limit && !disk_lru.empty()) {
+		RemoveDiskEntry(disk_blocks.find(disk_lru.back()));
+	}
+}
+
+void HTTPBlockCache::RemoveDiskEntry(unordered_map<string, DiskEntry>::iterator entry) {
+	D_ASSERT(entry != disk_blocks.end());
+	try {
+		local_fs->RemoveFile(entry->second.path);
+	} catch (...) {
+	}
+	disk_usage -= entry->second.size;
+	disk_lru.erase(entry->second.lru_position);
+	disk_blocks.erase(entry);
+}
+
+//===--------------------------------------------------------------------===//
+// Statistics
+//===--------------------------------------------------------------------===//
+struct HTTPBlockCacheFunctionInfo : public TableFunctionInfo {
+	explicit HTTPBlockCacheFunctionInfo(shared_ptr<HTTPBlockCache> block_cache) : block_cache(move(block_cache)) {
+	}
+
+	shared_ptr<HTTPBlockCache> block_cache;
+};
+
+struct HTTPBlockCacheStatisticsBindData : public TableFunctionData {
+	explicit HTTPBlockCacheStatisticsBindData(shared_ptr<HTTPBlockCache> block_cache)
+	    : block_cache(move(block_cache)) {
+	}
+
+	shared_ptr<HTTPBlockCache> block_cache;
+};
+
+struct HTTPBlockCacheStatisticsData : public GlobalTableFunctionState {
+	HTTPBlockCacheStatisticsData() : finished(false) {
+	}
+
+	bool finished;
+};
+
+static unique_ptr<FunctionData> HTTPBlockCacheStatisticsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                             vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("memory_usage");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("disk_usage");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("memory_hits");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("disk_hits");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("fetched_blocks");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	auto &info = (HTTPBlockCacheFunctionInfo &)*input.info;
+	return make_unique<HTTPBlockCacheStatisticsBindData>(info.block_cache);
+}
+
+static unique_ptr<GlobalTableFunctionState> HTTPBlockCacheStatisticsInit(ClientContext &context,
+                                                                         TableFunctionInitInput &input) {
+	return make_unique<HTTPBlockCacheStatisticsData>();
+}
+
+static void HTTPBlockCacheStatisticsImplementation(ClientContext &context, TableFunctionInput &data_p,
+                                                   DataChunk &output) {
+	auto &bind_data = (HTTPBlockCacheStatisticsBindData &)*data_p.bind_data;
+	auto &data = (HTTPBlockCacheStatisticsData &)*data_p.global_state;
+	if (data.finished) {
+		return;
+	}
+	auto statistics = bind_data.block_cache->GetStatistics();
+	output.SetCardinality(1);
+	output.SetValue(0, 0, Value::UBIGINT(statistics.memory_usage));
+	output.SetValue(1, 0, Value::UBIGINT(statistics.disk_usage));
+	output.SetValue(2, 0, Value::UBIGINT(statistics.memory_hits));
+	output.SetValue(3, 0, Value::UBIGINT(statistics.disk_hits));
+	output.SetValue(4, 0, Value::UBIGINT(statistics.fetched_blocks));
+	data.finished = true;
+}
+
+HTTPBlockCacheStatisticsFunction::HTTPBlockCacheStatisticsFunction(shared_ptr<HTTPBlockCache> block_cache)
+    : TableFunction("http_block_cache_statistics", {}, HTTPBlockCacheStatisticsImplementation,
+                    HTTPBlockCacheStatisticsBind, HTTPBlockCacheStatisticsInit) {
+	function_info = make_shared<HTTPBlockCacheFunctionInfo>(move(block_cache));
+}
+
+} // namespace duckdb
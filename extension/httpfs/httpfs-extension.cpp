@@ -5,14 +5,29 @@
 
 #include "s3fs.hpp"
 
+#ifndef DUCKDB_AMALGAMATION
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/parser/parsed_data/create_table_function_info.hpp"
+#endif
+
 namespace duckdb {
 
 static void LoadInternal(DatabaseInstance &instance) {
 	S3FileSystem::Verify(); // run some tests to see if all the hashes work out
 	auto &fs = instance.GetFileSystem();
 
-	fs.RegisterSubSystem(make_unique<HTTPFileSystem>());
-	fs.RegisterSubSystem(make_unique<S3FileSystem>(BufferManager::GetBufferManager(instance)));
+	// HTTP and S3 files share the block cache, so its size limits apply to the whole database
+	auto block_cache = make_shared<HTTPBlockCache>();
+	fs.RegisterSubSystem(make_unique<HTTPFileSystem>(block_cache));
+	fs.RegisterSubSystem(make_unique<S3FileSystem>(BufferManager::GetBufferManager(instance), block_cache));
+
+	HTTPBlockCacheStatisticsFunction statistics_fun(block_cache);
+	CreateTableFunctionInfo statistics_info(statistics_fun);
+	Connection con(instance);
+	con.BeginTransaction();
+	auto &context = *con.context;
+	Catalog::GetCatalog(context).CreateTableFunction(context, &statistics_info);
+	con.Commit();
 
 	auto &config = DBConfig::GetConfig(instance);
 
@@ -20,6 +35,15 @@ static void LoadInternal(DatabaseInstance &instance) {
 	// Single timeout value is used for all 4 types of timeouts, we could split it into 4 if users need that
 	config.AddExtensionOption("httpfs_timeout", "HTTP timeout read/write/connection/retry (default 30000ms)",
 	                          LogicalType::UBIGINT);
+	config.AddExtensionOption("http_cache_size",
+	                          "Size of the in-memory cache for blocks of remote files, 0 disables it (default 256MiB)",
+	                          LogicalType::VARCHAR);
+	config.AddExtensionOption("http_cache_directory",
+	                          "Directory to keep blocks of remote files that are evicted from memory (default none)",
+	                          LogicalType::VARCHAR);
+	config.AddExtensionOption("http_cache_disk_size",
+	                          "Size of the on-disk cache for blocks of remote files (default 4GiB)",
+	                          LogicalType::VARCHAR);
 
 	// Global S3 config
 	config.AddExtensionOption("s3_region", "S3 Region", LogicalType::VARCHAR);
@@ -38,6 +62,10 @@ static void LoadInternal(DatabaseInstance &instance) {
 	                          LogicalType::UBIGINT);
 	config.AddExtensionOption("s3_uploader_thread_limit", "S3 Uploader global thread limit (default 50)",
 	                          LogicalType::UBIGINT);
+	config.AddExtensionOption("s3_uploader_part_size",
+	                          "S3 Uploader part size (at least 5MB, by default the max filesize divided by the max "
+	                          "parts per file)",
+	                          LogicalType::VARCHAR);
 }
 
 void HTTPFsExtension::Load(DuckDB &db) {
@@ -4,6 +4,7 @@
 #include "duckdb/common/file_opener.hpp"
 #include "duckdb/common/thread.hpp"
 #include "duckdb/function/scalar/strftime.hpp"
+#include "duckdb/main/config.hpp"
 
 #define CPPHTTPLIB_OPENSSL_SUPPORT
 #include "httplib.hpp"
@@ -22,6 +23,9 @@ static unique_ptr<duckdb_httplib_openssl::Headers> initialize_http_headers(Heade
 
 HTTPParams HTTPParams::ReadFrom(FileOpener *opener) {
 	uint64_t timeout;
+	uint64_t cache_size;
+	string cache_directory;
+	uint64_t cache_disk_size;
 	Value value;
 
 	if (opener->TryGetCurrentSetting("http_timeout", value)) {
@@ -30,7 +34,23 @@ HTTPParams HTTPParams::ReadFrom(FileOpener *opener) {
 		timeout = DEFAULT_TIMEOUT;
 	}
 
-	return {timeout};
+	if (opener->TryGetCurrentSetting("http_cache_size", value)) {
+		cache_size = DBConfig::ParseMemoryLimit(value.GetValue<string>());
+	} else {
+		cache_size = HTTPBlockCache::DEFAULT_MEMORY_LIMIT;
+	}
+
+	if (opener->TryGetCurrentSetting("http_cache_directory", value)) {
+		cache_directory = value.GetValue<string>();
+	}
+
+	if (opener->TryGetCurrentSetting("http_cache_disk_size", value)) {
+		cache_disk_size = DBConfig::ParseMemoryLimit(value.GetValue<string>());
+	} else {
+		cache_disk_size = HTTPBlockCache::DEFAULT_DISK_LIMIT;
+	}
+
+	return {timeout, cache_size, cache_directory, cache_disk_size};
 }
 
 void HTTPFileSystem::ParseUrl(string &url, string &path_out, string &proto_host_port_out) {
@@ -146,8 +166,9 @@ unique_ptr<ResponseWrapper> HTTPFileSystem::GetRangeRequest(FileHandle &handle,
 	idx_t tries = 0;
 	idx_t max_tries = 2;
 
+	auto client = hfs.AcquireClient(proto_host_port);
 	while (true) {
-		auto res = hfs.http_client->Get(
+		auto res = client->Get(
 		    path.c_str(), *headers,
 		    [&](const duckdb_httplib_openssl::Response &response) {
 			    if (response.status >= 400) {
@@ -170,6 +191,7 @@ unique_ptr<ResponseWrapper> HTTPFileSystem::GetRangeRequest(FileHandle &handle,
 		    });
 
 		if (res.error() == duckdb_httplib_openssl::Error::Success) {
+			hfs.ReleaseClient(move(client));
 			return make_unique<ResponseWrapper>(res.value());
 		} else {
 			// Retry mechanism for the keep-alive connection: sometimes the connection times out and the request will
@@ -177,7 +199,7 @@ unique_ptr<ResponseWrapper> HTTPFileSystem::GetRangeRequest(FileHandle &handle,
 
 			if (res.error() == duckdb_httplib_openssl::Error::Read) {
 				tries += 1;
-				hfs.http_client = GetClient(hfs.http_params, proto_host_port.c_str());
+				client = GetClient(hfs.http_params, proto_host_port.c_str());
 			}
 
 			if (tries >= max_tries) {
@@ -189,8 +211,8 @@ unique_ptr<ResponseWrapper> HTTPFileSystem::GetRangeRequest(FileHandle &handle,
 }
 
 HTTPFileHandle::HTTPFileHandle(FileSystem &fs, std::string path, uint8_t flags, const HTTPParams &http_params)
-    : FileHandle(fs, path), http_params(http_params), flags(flags), length(0), buffer_available(0), buffer_idx(0),
-      file_offset(0), buffer_start(0), buffer_end(0) {
+    : FileHandle(fs, path), http_params(http_params), flags(flags), length(0), last_modified(0), file_offset(0),
+      buffer_start(0), buffer_end(0) {
 }
 
 std::unique_ptr<HTTPFileHandle> HTTPFileSystem::CreateHandle(const string &path, uint8_t flags, FileLockType lock,
@@ -204,12 +226,18 @@ std::unique_ptr<FileHandle> HTTPFileSystem::OpenFile(const string &path, uint8_t
                                                      FileCompressionType compression, FileOpener *opener) {
 	D_ASSERT(compression == FileCompressionType::UNCOMPRESSED);
 	auto handle = CreateHandle(path, flags, lock, compression, opener);
+	if (opener) {
+		block_cache->SetLimits(handle->http_params.cache_size, handle->http_params.cache_directory,
+		                       handle->http_params.cache_disk_size);
+	}
 	handle->Initialize();
 	return move(handle);
 }
 
 // Buffered read from http file.
 // Note that buffering is disabled when FileFlags::FILE_FLAGS_DIRECT_IO is set
+// Reads at a location can be issued concurrently on the same handle (e.g. when prefetching): they do not move the
+// file offset and only reads going through the read buffer are serialized
 void HTTPFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
 	auto &hfh = (HTTPFileHandle &)handle;
 	idx_t to_read = nr_bytes;
@@ -218,59 +246,48 @@ void HTTPFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, id
 		throw std::runtime_error("out of file");
 	}
 
-	// Don't buffer when DirectIO is set.
-	if (hfh.flags & FileFlags::FILE_FLAGS_DIRECT_IO && to_read > 0) {
-		GetRangeRequest(hfh, hfh.path, {}, location, (char *)buffer, to_read);
-		hfh.buffer_available = 0;
-		hfh.buffer_idx = 0;
-		hfh.file_offset = location + nr_bytes;
+	// Read through the shared block cache if it is enabled, this is also done for DirectIO: the cache is not
+	// private to the handle
+	if (!hfh.cache_key.empty()) {
+		block_cache->Read(hfh.cache_key, hfh.length, location, (char *)buffer, to_read,
+		                  [&](idx_t fetch_offset, char *fetch_buffer, idx_t fetch_len) {
+			                  GetRangeRequest(hfh, hfh.path, {}, fetch_offset, fetch_buffer, fetch_len);
+		                  });
 		return;
 	}
 
-	if (location >= hfh.buffer_start && location < hfh.buffer_end) {
-		hfh.file_offset = location;
-		hfh.buffer_idx = location - hfh.buffer_start;
-		hfh.buffer_available = (hfh.buffer_end - hfh.buffer_start) - hfh.buffer_idx;
-	} else {
-		// reset buffer
-		hfh.buffer_available = 0;
-		hfh.buffer_idx = 0;
-		hfh.file_offset = location;
+	// Don't buffer when DirectIO is set, or when the read is larger than the buffer anyway
+	if ((hfh.flags & FileFlags::FILE_FLAGS_DIRECT_IO || to_read >= hfh.READ_BUFFER_LEN) && to_read > 0) {
+		GetRangeRequest(hfh, hfh.path, {}, location, (char *)buffer, to_read);
+		return;
 	}
 
+	lock_guard<mutex> guard(hfh.read_lock);
+	auto read_offset = location;
 	while (to_read > 0) {
-		auto buffer_read_len = MinValue<idx_t>(hfh.buffer_available, to_read);
-		if (buffer_read_len > 0) {
-			D_ASSERT(hfh.buffer_start + hfh.buffer_idx + buffer_read_len <= hfh.buffer_end);
-			memcpy((char *)buffer + buffer_offset, hfh.read_buffer.get() + hfh.buffer_idx, buffer_read_len);
+		if (read_offset >= hfh.buffer_start && read_offset < hfh.buffer_end) {
+			auto buffer_idx = read_offset - hfh.buffer_start;
+			auto buffer_read_len = MinValue<idx_t>(hfh.buffer_end - read_offset, to_read);
+			memcpy((char *)buffer + buffer_offset, hfh.read_buffer.get() + buffer_idx, buffer_read_len);
 
 			buffer_offset += buffer_read_len;
 			to_read -= buffer_read_len;
-
-			hfh.buffer_idx += buffer_read_len;
-			hfh.buffer_available -= buffer_read_len;
-			hfh.file_offset += buffer_read_len;
+			read_offset += buffer_read_len;
+			continue;
 		}
 
-		if (to_read > 0 && hfh.buffer_available == 0) {
-			auto new_buffer_available = MinValue<idx_t>(hfh.READ_BUFFER_LEN, hfh.length - hfh.file_offset);
-
-			// Bypass buffer if we read more than buffer size
-			if (to_read > new_buffer_available) {
-				GetRangeRequest(hfh, hfh.path, {}, location + buffer_offset, (char *)buffer + buffer_offset, to_read);
-				hfh.buffer_available = 0;
-				hfh.buffer_idx = 0;
-				hfh.file_offset += to_read;
-				break;
-			} else {
-				GetRangeRequest(hfh, hfh.path, {}, hfh.file_offset, (char *)hfh.read_buffer.get(),
-				                new_buffer_available);
-				hfh.buffer_available = new_buffer_available;
-				hfh.buffer_idx = 0;
-				hfh.buffer_start = hfh.file_offset;
-				hfh.buffer_end = hfh.buffer_start + new_buffer_available;
-			}
+		auto new_buffer_available = MinValue<idx_t>(hfh.READ_BUFFER_LEN, hfh.length - read_offset);
+		// Bypass buffer if we read more than buffer size
+		if (to_read > new_buffer_available) {
+			GetRangeRequest(hfh, hfh.path, {}, read_offset, (char *)buffer + buffer_offset, to_read);
+			return;
 		}
+		// Invalidate the buffer first, it is not valid if the request fails
+		hfh.buffer_start = 0;
+		hfh.buffer_end = 0;
+		GetRangeRequest(hfh, hfh.path, {}, read_offset, (char *)hfh.read_buffer.get(), new_buffer_available);
+		hfh.buffer_start = read_offset;
+		hfh.buffer_end = read_offset + new_buffer_available;
 	}
 }
 
@@ -279,6 +296,7 @@ int64_t HTTPFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes)
 	idx_t max_read = hfh.length - hfh.file_offset;
 	nr_bytes = MinValue<idx_t>(max_read, nr_bytes);
 	Read(handle, buffer, nr_bytes, hfh.file_offset);
+	hfh.file_offset += nr_bytes;
 	return nr_bytes;
 }
 
@@ -348,28 +366,34 @@ unique_ptr<ResponseWrapper> HTTPFileHandle::Initialize() {
 		}
 	}
 
-	// Initialize the read buffer now that we know the file exists
-	if (flags & FileFlags::FILE_FLAGS_READ) {
-		read_buffer = std::unique_ptr<data_t[]>(new data_t[READ_BUFFER_LEN]);
-	}
-
 	length = std::atoll(res->headers["Content-Length"].c_str());
+	etag = res->headers["ETag"];
+
+	auto last_modified_str = res->headers["Last-Modified"];
+	if (!last_modified_str.empty()) {
+		auto result = StrpTimeFormat::Parse("%a, %d %h %Y %T %Z", last_modified_str);
+
+		struct tm tm {};
+		tm.tm_year = result.data[0] - 1900;
+		tm.tm_mon = result.data[1] - 1;
+		tm.tm_mday = result.data[2];
+		tm.tm_hour = result.data[3];
+		tm.tm_min = result.data[4];
+		tm.tm_sec = result.data[5];
+		tm.tm_isdst = 0;
+		last_modified = std::mktime(&tm);
+	}
 
-	auto last_modified = res->headers["Last-Modified"];
-	if (last_modified.empty()) {
-		return res;
+	// Initialize the read buffer now that we know the file exists
+	if (flags & FileFlags::FILE_FLAGS_READ) {
+		if (http_params.cache_size > 0 && (!etag.empty() || !last_modified_str.empty())) {
+			// The ETag and modification time change when the file changes, so cached blocks are never stale. Without
+			// either of them we cannot tell whether the file changed, and the file is not cached.
+			cache_key = path + "\n" + etag + "\n" + std::to_string(last_modified) + "\n" + std::to_string(length);
+		} else {
+			read_buffer = std::unique_ptr<data_t[]>(new data_t[READ_BUFFER_LEN]);
+		}
 	}
-	auto result = StrpTimeFormat::Parse("%a, %d %h %Y %T %Z", last_modified);
-
-	struct tm tm {};
-	tm.tm_year = result.data[0] - 1900;
-	tm.tm_mon = result.data[1] - 1;
-	tm.tm_mday = result.data[2];
-	tm.tm_hour = result.data[3];
-	tm.tm_min = result.data[4];
-	tm.tm_sec = result.data[5];
-	tm.tm_isdst = 0;
-	last_modified = std::mktime(&tm);
 	return res;
 }
 
@@ -379,6 +403,30 @@ void HTTPFileHandle::InitializeClient() {
 	http_client = HTTPFileSystem::GetClient(this->http_params, proto_host_port.c_str());
 }
 
+unique_ptr<duckdb_httplib_openssl::Client> HTTPFileHandle::AcquireClient(const string &proto_host_port) {
+	{
+		lock_guard<mutex> guard(client_lock);
+		if (http_client) {
+			return move(http_client);
+		}
+		if (!idle_clients.empty()) {
+			auto client = move(idle_clients.back());
+			idle_clients.pop_back();
+			return client;
+		}
+	}
+	return HTTPFileSystem::GetClient(http_params, proto_host_port.c_str());
+}
+
+void HTTPFileHandle::ReleaseClient(unique_ptr<duckdb_httplib_openssl::Client> client) {
+	lock_guard<mutex> guard(client_lock);
+	if (!http_client) {
+		http_client = move(client);
+	} else {
+		idle_clients.push_back(move(client));
+	}
+}
+
 ResponseWrapper::ResponseWrapper(duckdb_httplib_openssl::Response &res) {
 	code = res.status;
 	error = res.reason;
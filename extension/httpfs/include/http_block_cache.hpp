@@ -0,0 +1,113 @@
+#pragma once
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/pair.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/function/table_function.hpp"
+
+#include <functional>
+#include <list>
+
+namespace duckdb {
+
+struct HTTPCachedBlock {
+	HTTPCachedBlock(unique_ptr<data_t[]> data, idx_t size) : data(move(data)), size(size) {
+	}
+
+	unique_ptr<data_t[]> data;
+	idx_t size;
+};
+
+struct HTTPBlockCacheStatistics {
+	// Bytes of blocks currently held in memory and on disk
+	idx_t memory_usage;
+	idx_t disk_usage;
+	// Blocks that were read from memory or from disk instead of being fetched
+	idx_t memory_hits;
+	idx_t disk_hits;
+	// Blocks that were fetched from the remote file
+	idx_t fetched_blocks;
+};
+
+// Database-wide cache for the blocks of remote files. Blocks are kept in memory up to a maximum size. Blocks that are
+// evicted from memory can be kept in a directory on local disk, up to a separate maximum size.
+class HTTPBlockCache {
+public:
+	// Files are cached in aligned blocks of this size
+	constexpr static idx_t BLOCK_SIZE = 1 << 20;
+	constexpr static idx_t DEFAULT_MEMORY_LIMIT = 256 * BLOCK_SIZE;
+	constexpr static idx_t DEFAULT_DISK_LIMIT = 4096 * BLOCK_SIZE;
+	// Prefix of the files in the disk cache directory, followed by the unique name of the cache instance
+	constexpr static const char *DISK_FILE_PREFIX = "duckdb_http_block_";
+
+	// Reads the bytes [offset, offset + size) of the remote file into the buffer
+	typedef std::function<void(idx_t offset, char *buffer, idx_t size)> fetch_function_t;
+
+public:
+	HTTPBlockCache();
+	~HTTPBlockCache();
+
+	// Sets the maximum size of the memory cache, and the directory and maximum size of the disk cache (the disk cache
+	// is not used if the directory is empty)
+	void SetLimits(idx_t memory_limit, const string &disk_directory, idx_t disk_limit);
+
+	// Reads [location, location + size) of a file. The file_key must identify the version of the file (e.g. the URL
+	// and the ETag), so stale blocks are never returned. Runs of adjacent blocks that are not cached are fetched with a
+	// single request.
+	void Read(const string &file_key, idx_t file_size, idx_t location, char *buffer, idx_t size,
+	          const fetch_function_t &fetch);
+
+	HTTPBlockCacheStatistics GetStatistics();
+
+private:
+	struct MemoryEntry {
+		shared_ptr<HTTPCachedBlock> block;
+		std::list<string>::iterator lru_position;
+	};
+	struct DiskEntry {
+		string path;
+		idx_t size;
+		std::list<string>::iterator lru_position;
+	};
+
+	shared_ptr<HTTPCachedBlock> Lookup(const string &key);
+	bool IsCached(const string &key);
+	void Insert(const string &key, shared_ptr<HTTPCachedBlock> block);
+	// Evicts blocks from memory until the memory limit is respected, returns the blocks that should go to disk
+	vector<pair<string, shared_ptr<HTTPCachedBlock>>> EvictFromMemory();
+	void WriteToDisk(vector<pair<string, shared_ptr<HTTPCachedBlock>>> blocks);
+	void EvictFromDisk();
+	void RemoveDiskEntry(unordered_map<string, DiskEntry>::iterator entry);
+
+private:
+	mutex lock;
+	unique_ptr<FileSystem> local_fs;
+
+	idx_t memory_limit;
+	idx_t memory_usage;
+	unordered_map<string, MemoryEntry> memory_blocks;
+	// Most recently used keys are at the front
+	std::list<string> memory_lru;
+
+	// The prefix of the files written by this instance: the directory can be shared with other processes and databases
+	string disk_file_prefix;
+	string disk_directory;
+	idx_t disk_limit;
+	idx_t disk_usage;
+	idx_t disk_file_count;
+	unordered_map<string, DiskEntry> disk_blocks;
+	std::list<string> disk_lru;
+
+	idx_t memory_hits;
+	idx_t disk_hits;
+	idx_t fetched_blocks;
+};
+
+// The http_block_cache_statistics() table function, which returns the statistics of the block cache of the database
+class HTTPBlockCacheStatisticsFunction : public TableFunction {
+public:
+	explicit HTTPBlockCacheStatisticsFunction(shared_ptr<HTTPBlockCache> block_cache);
+};
+
+} // namespace duckdb
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/common/pair.hpp"
 #include "duckdb/common/unordered_map.hpp"
+#include "http_block_cache.hpp"
 
 namespace duckdb_httplib_openssl {
 struct Response;
@@ -26,6 +28,10 @@ struct HTTPParams {
 	static constexpr uint64_t DEFAULT_TIMEOUT = 30000; // 30 sec
 
 	uint64_t timeout;
+	// Block cache config, a cache size of 0 disables the cache
+	uint64_t cache_size;
+	string cache_directory;
+	uint64_t cache_disk_size;
 
 	static HTTPParams ReadFrom(FileOpener *opener);
 };
@@ -39,6 +45,10 @@ public:
 
 	// We keep an http client stored for connection reuse with keep-alive headers
 	unique_ptr<duckdb_httplib_openssl::Client> http_client;
+	// Range requests can be issued concurrently on the same handle (e.g. when prefetching), each request takes its own
+	// client. Additional clients are kept around for reuse once the requests finish.
+	mutex client_lock;
+	vector<unique_ptr<duckdb_httplib_openssl::Client>> idle_clients;
 
 	const HTTPParams http_params;
 
@@ -46,15 +56,18 @@ public:
 	uint8_t flags;
 	idx_t length;
 	time_t last_modified;
+	string etag;
 
-	// Read info
-	idx_t buffer_available;
-	idx_t buffer_idx;
+	// Identifies this version of the file in the block cache, empty if reads do not go through the cache
+	string cache_key;
+
+	// Read info, the file offset is only used by sequential reads
 	idx_t file_offset;
+
+	// Read buffer, holding the file range [buffer_start, buffer_end)
+	mutex read_lock;
 	idx_t buffer_start;
 	idx_t buffer_end;
-
-	// Read buffer
 	std::unique_ptr<data_t[]> read_buffer;
 	constexpr static idx_t READ_BUFFER_LEN = 1000000;
 
@@ -62,12 +75,21 @@ public:
 	void Close() override {
 	}
 
+	// Takes a client for a request to proto_host_port, creating a new client if all clients are in use
+	unique_ptr<duckdb_httplib_openssl::Client> AcquireClient(const string &proto_host_port);
+	// Hands back a client after the request finished, so its connection can be reused
+	void ReleaseClient(unique_ptr<duckdb_httplib_openssl::Client> client);
+
 protected:
 	virtual void InitializeClient();
 };
 
 class HTTPFileSystem : public FileSystem {
 public:
+	explicit HTTPFileSystem(shared_ptr<HTTPBlockCache> block_cache_p = make_shared<HTTPBlockCache>())
+	    : block_cache(move(block_cache_p)) {
+	}
+
 	static unique_ptr<duckdb_httplib_openssl::Client> GetClient(const HTTPParams &http_params,
 	                                                            const char *proto_host_port);
 	static void ParseUrl(string &url, string &path_out, string &proto_host_port_out);
@@ -114,6 +136,9 @@ public:
 
 	static void Verify();
 
+	// Shared by all HTTP and S3 file handles of the database
+	shared_ptr<HTTPBlockCache> block_cache;
+
 protected:
 	virtual std::unique_ptr<HTTPFileHandle> CreateHandle(const string &path, uint8_t flags, FileLockType lock,
 	                                                     FileCompressionType compression, FileOpener *opener);
@@ -7,6 +7,7 @@
 #include "httpfs.hpp"
 
 #include <condition_variable>
+#include <exception>
 #include <iostream>
 
 namespace duckdb {
@@ -35,10 +36,14 @@ struct S3ConfigParams {
 	static constexpr uint64_t DEFAULT_MAX_FILESIZE = 800000000000; // 800GB
 	static constexpr uint64_t DEFAULT_MAX_PARTS_PER_FILE = 10000;  // AWS DEFAULT
 	static constexpr uint64_t DEFAULT_MAX_UPLOAD_THREADS = 50;
+	// 5 MiB https://docs.aws.amazon.com/AmazonS3/latest/userguide/qfacts.html
+	static constexpr uint64_t MINIMUM_PART_SIZE = 5242880;
 
 	uint64_t max_file_size;
 	uint64_t max_parts_per_file;
 	uint64_t max_upload_threads;
+	// The size of the parts of a multipart upload, 0 if the part size follows from the max file size
+	uint64_t part_size;
 
 	static S3ConfigParams ReadFrom(FileOpener *opener);
 };
@@ -84,6 +89,8 @@ public:
 			throw NotImplementedException("Cannot open an HTTP file for appending");
 		}
 	}
+	~S3FileHandle() override;
+
 	const S3AuthParams auth_params;
 	const S3ConfigParams config_params;
 
@@ -99,7 +106,9 @@ protected:
 
 	std::mutex uploads_in_progress_lock;
 	std::condition_variable uploads_in_progress_cv;
-	std::atomic<uint16_t> uploads_in_progress;
+	std::atomic<uint16_t> uploads_in_progress = {0};
+	// The first error of a part upload, parts are uploaded in the background so the error is thrown by the writer
+	std::exception_ptr upload_exception;
 
 	// Etags are stored for each part
 	std::mutex part_etags_lock;
@@ -115,13 +124,15 @@ class S3FileSystem : public HTTPFileSystem {
 public:
 	constexpr static int MULTIPART_UPLOAD_WAIT_BETWEEN_RETRIES_MS = 1000;
 
-	// Global limits to write buffers
+	// Global limits to write buffers: a writer blocks until a buffer is released by a finished upload if
+	// s3_uploader_thread_limit buffers are in use
 	std::mutex buffers_available_lock;
 	std::condition_variable buffers_available_cv;
-	std::atomic<uint16_t> buffers_available;
+	std::atomic<uint16_t> buffers_in_use = {0};
 	std::atomic<uint16_t> threads_waiting_for_memory = {0};
 
-	explicit S3FileSystem(BufferManager &buffer_manager) : buffer_manager(buffer_manager) {
+	S3FileSystem(BufferManager &buffer_manager, shared_ptr<HTTPBlockCache> block_cache_p)
+	    : HTTPFileSystem(move(block_cache_p)), buffer_manager(buffer_manager) {
 	}
 
 	BufferManager &buffer_manager;
@@ -157,6 +168,8 @@ public:
 	// Uploads the contents of write_buffer to S3.
 	// Note: caller is responsible to not call this method twice on the same buffer
 	static void UploadBuffer(S3FileHandle &file_handle, shared_ptr<S3WriteBuffer> write_buffer);
+	// Throws the error of a failed part upload of the file, if any
+	static void ThrowUploadException(S3FileHandle &file_handle);
 
 	vector<string> Glob(const string &glob_pattern, FileOpener *opener = nullptr) override;
 
@@ -165,6 +178,8 @@ protected:
 	                                             FileCompressionType compression, FileOpener *opener) override;
 
 	void FlushBuffer(S3FileHandle &handle, std::shared_ptr<S3WriteBuffer> write_buffer);
+	// Uploads a single part, throws if the upload fails
+	static void UploadPart(S3FileHandle &file_handle, S3WriteBuffer &write_buffer);
 	string GetPayloadHash(char *buffer, idx_t buffer_len);
 
 	// Allocate an S3WriteBuffer
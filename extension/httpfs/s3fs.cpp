@@ -182,6 +182,7 @@ S3ConfigParams S3ConfigParams::ReadFrom(FileOpener *opener) {
 	uint64_t uploader_max_filesize;
 	uint64_t max_parts_per_file;
 	uint64_t max_upload_threads;
+	uint64_t part_size;
 	Value value;
 
 	if (opener->TryGetCurrentSetting("s3_uploader_max_filesize", value)) {
@@ -202,7 +203,19 @@ S3ConfigParams S3ConfigParams::ReadFrom(FileOpener *opener) {
 		max_upload_threads = S3ConfigParams::DEFAULT_MAX_UPLOAD_THREADS;
 	}
 
-	return {uploader_max_filesize, max_parts_per_file, max_upload_threads};
+	if (opener->TryGetCurrentSetting("s3_uploader_part_size", value)) {
+		part_size = DBConfig::ParseMemoryLimit(value.GetValue<string>());
+	} else {
+		part_size = 0;
+	}
+
+	return {uploader_max_filesize, max_parts_per_file, max_upload_threads, part_size};
+}
+
+S3FileHandle::~S3FileHandle() {
+	// Uploads that are still in progress (e.g. if the upload failed) reference this handle
+	std::unique_lock<std::mutex> lck(uploads_in_progress_lock);
+	uploads_in_progress_cv.wait(lck, [this] { return uploads_in_progress.load() == 0; });
 }
 
 void S3FileHandle::Close() {
@@ -245,10 +258,10 @@ string S3FileSystem::InitializeMultipartUpload(S3FileHandle &file_handle) {
 	return result.substr(open_tag_pos, close_tag_pos - open_tag_pos);
 }
 
-void S3FileSystem::UploadBuffer(S3FileHandle &file_handle, shared_ptr<S3WriteBuffer> write_buffer) {
+void S3FileSystem::UploadPart(S3FileHandle &file_handle, S3WriteBuffer &write_buffer) {
 	auto &s3fs = (S3FileSystem &)file_handle.file_system;
 
-	string query_param = S3FileSystem::UrlEncode("partNumber") + "=" + to_string(write_buffer->part_no + 1) + "&" +
+	string query_param = S3FileSystem::UrlEncode("partNumber") + "=" + to_string(write_buffer.part_no + 1) + "&" +
 	                     S3FileSystem::UrlEncode("uploadId") + "=" +
 	                     S3FileSystem::UrlEncode(file_handle.multipart_upload_id, true);
 	unique_ptr<ResponseWrapper> res;
@@ -260,8 +273,8 @@ void S3FileSystem::UploadBuffer(S3FileHandle &file_handle, shared_ptr<S3WriteBuf
 	// Retry loop to make large uploads resilient to brief connection issues
 	while (true) {
 		try {
-			res = s3fs.PutRequest(file_handle, file_handle.path + "?" + query_param, {}, (char *)write_buffer->Ptr(),
-			                      write_buffer->idx);
+			res = s3fs.PutRequest(file_handle, file_handle.path + "?" + query_param, {}, (char *)write_buffer.Ptr(),
+			                      write_buffer.idx);
 			if (res->code == 200) {
 				success = true;
 				break;
@@ -300,19 +313,48 @@ void S3FileSystem::UploadBuffer(S3FileHandle &file_handle, shared_ptr<S3WriteBuf
 
 	// Insert etag
 	file_handle.part_etags_lock.lock();
-	file_handle.part_etags.insert(std::pair<uint16_t, string>(write_buffer->part_no, etag_lookup->second));
+	file_handle.part_etags.insert(std::pair<uint16_t, string>(write_buffer.part_no, etag_lookup->second));
 	file_handle.part_etags_lock.unlock();
 
 	file_handle.parts_uploaded++;
+}
+
+void S3FileSystem::UploadBuffer(S3FileHandle &file_handle, shared_ptr<S3WriteBuffer> write_buffer) {
+	auto &s3fs = (S3FileSystem &)file_handle.file_system;
+
+	try {
+		UploadPart(file_handle, *write_buffer);
+	} catch (...) {
+		// This runs on a background thread: the writer throws the error when it writes or flushes next
+		std::lock_guard<std::mutex> lck(file_handle.uploads_in_progress_lock);
+		if (!file_handle.upload_exception) {
+			file_handle.upload_exception = std::current_exception();
+		}
+	}
 
 	// Free up space for another thread to acquire an S3WriteBuffer
 	write_buffer.reset();
-	s3fs.buffers_available++;
-	s3fs.buffers_available_cv.notify_one();
+	{
+		std::lock_guard<std::mutex> lck(s3fs.buffers_available_lock);
+		s3fs.buffers_in_use--;
+		s3fs.buffers_available_cv.notify_all();
+	}
 
-	// Update uploads in progress
+	// Update uploads in progress, the handle can be destroyed as soon as the lock is released
+	std::lock_guard<std::mutex> lck(file_handle.uploads_in_progress_lock);
 	file_handle.uploads_in_progress--;
-	file_handle.uploads_in_progress_cv.notify_one();
+	file_handle.uploads_in_progress_cv.notify_all();
+}
+
+void S3FileSystem::ThrowUploadException(S3FileHandle &file_handle) {
+	std::exception_ptr upload_exception;
+	{
+		std::lock_guard<std::mutex> lck(file_handle.uploads_in_progress_lock);
+		upload_exception = file_handle.upload_exception;
+	}
+	if (upload_exception) {
+		std::rethrow_exception(upload_exception);
+	}
 }
 
 void S3FileSystem::FlushBuffer(S3FileHandle &file_handle, std::shared_ptr<S3WriteBuffer> write_buffer) {
@@ -332,7 +374,10 @@ void S3FileSystem::FlushBuffer(S3FileHandle &file_handle, std::shared_ptr<S3Writ
 	file_handle.write_buffers_lock.lock();
 	file_handle.write_buffers.erase(write_buffer->part_no);
 	file_handle.write_buffers_lock.unlock();
-	file_handle.uploads_in_progress++;
+	{
+		std::lock_guard<std::mutex> lck(file_handle.uploads_in_progress_lock);
+		file_handle.uploads_in_progress++;
+	}
 
 	thread upload_thread(UploadBuffer, std::ref(file_handle), write_buffer);
 	upload_thread.detach();
@@ -356,9 +401,13 @@ void S3FileSystem::FlushAllBuffers(S3FileHandle &file_handle) {
 			FlushBuffer(file_handle, write_buffer);
 		}
 	}
-	std::unique_lock<std::mutex> lck(file_handle.uploads_in_progress_lock);
-	file_handle.uploads_in_progress_cv.wait(lck,
-	                                        [&file_handle] { return file_handle.uploads_in_progress.load() == 0; });
+	{
+		std::unique_lock<std::mutex> lck(file_handle.uploads_in_progress_lock);
+		file_handle.uploads_in_progress_cv.wait(
+		    lck, [&file_handle] { return file_handle.uploads_in_progress.load() == 0; });
+	}
+	// The multipart upload cannot be finalized if any of the parts failed
+	ThrowUploadException(file_handle);
 }
 
 void S3FileSystem::FinalizeMultipartUpload(S3FileHandle &file_handle) {
@@ -406,11 +455,12 @@ std::shared_ptr<S3WriteBuffer> S3FileSystem::GetBuffer(S3FileHandle &file_handle
 		}
 	}
 
-	// Wait for a buffer to become available
+	// Wait for a buffer to become available: this blocks the writer while the maximum number of parts is uploading
+	auto max_buffers = file_handle.config_params.max_upload_threads;
 	{
 		std::unique_lock<std::mutex> lck(s3fs.buffers_available_lock);
-		s3fs.buffers_available_cv.wait(lck, [&s3fs] { return s3fs.buffers_available > 0; });
-		s3fs.buffers_available--;
+		s3fs.buffers_available_cv.wait(lck, [&s3fs, max_buffers] { return s3fs.buffers_in_use < max_buffers; });
+		s3fs.buffers_in_use++;
 	}
 
 	// Try to allocate a buffer from the buffer manager
@@ -430,10 +480,16 @@ std::shared_ptr<S3WriteBuffer> S3FileSystem::GetBuffer(S3FileHandle &file_handle
 				threads_waiting_for_memory++;
 				set_waiting_for_memory = true;
 			}
-			auto buffers_available = s3fs.buffers_available.load();
+			auto buffers_in_use = s3fs.buffers_in_use.load();
 
-			if (buffers_available >= file_handle.config_params.max_upload_threads - threads_waiting_for_memory) {
+			if (buffers_in_use <= threads_waiting_for_memory) {
 				// There exist no upload write buffers that can release more memory. We really ran out of memory here.
+				threads_waiting_for_memory--;
+				{
+					std::lock_guard<std::mutex> lck(s3fs.buffers_available_lock);
+					s3fs.buffers_in_use--;
+					s3fs.buffers_available_cv.notify_all();
+				}
 				throw e;
 			} else {
 
@@ -441,7 +497,7 @@ std::shared_ptr<S3WriteBuffer> S3FileSystem::GetBuffer(S3FileHandle &file_handle
 				{
 					std::unique_lock<std::mutex> lck(s3fs.buffers_available_lock);
 					s3fs.buffers_available_cv.wait(
-					    lck, [&s3fs, &buffers_available] { return s3fs.buffers_available > buffers_available; });
+					    lck, [&s3fs, &buffers_in_use] { return s3fs.buffers_in_use < buffers_in_use; });
 				}
 			}
 		}
@@ -456,9 +512,14 @@ std::shared_ptr<S3WriteBuffer> S3FileSystem::GetBuffer(S3FileHandle &file_handle
 
 		// Check if other thread has created the same buffer, if so we return theirs and drop ours.
 		if (lookup_result != file_handle.write_buffers.end()) {
-			// write_buffer_idx << std::endl;
 			std::shared_ptr<S3WriteBuffer> write_buffer = lookup_result->second;
-			file_handle.write_buffers_lock.unlock();
+			lck.unlock();
+			new_write_buffer.reset();
+			{
+				std::lock_guard<std::mutex> buffers_lck(s3fs.buffers_available_lock);
+				s3fs.buffers_in_use--;
+				s3fs.buffers_available_cv.notify_all();
+			}
 			return write_buffer;
 		}
 		file_handle.write_buffers.insert(
@@ -680,19 +741,23 @@ unique_ptr<ResponseWrapper> S3FileHandle::Initialize() {
 	auto &s3fs = (S3FileSystem &)file_system;
 
 	if (flags & FileFlags::FILE_FLAGS_WRITE) {
-		auto aws_minimum_part_size = 5242880; // 5 MiB https://docs.aws.amazon.com/AmazonS3/latest/userguide/qfacts.html
 		auto max_part_count = config_params.max_parts_per_file;
-		auto required_part_size = config_params.max_file_size / max_part_count;
-		auto minimum_part_size = MaxValue<idx_t>(aws_minimum_part_size, required_part_size);
+		idx_t minimum_part_size;
+		if (config_params.part_size > 0) {
+			// Smaller parts are uploaded concurrently sooner, but the maximum file size is part_size * max_part_count
+			minimum_part_size = MaxValue<idx_t>(S3ConfigParams::MINIMUM_PART_SIZE, config_params.part_size);
+		} else {
+			auto required_part_size = config_params.max_file_size / max_part_count;
+			minimum_part_size = MaxValue<idx_t>(S3ConfigParams::MINIMUM_PART_SIZE, required_part_size);
+		}
 
 		// Round part size up to multiple of BLOCK_SIZE
 		part_size = ((minimum_part_size + Storage::BLOCK_SIZE - 1) / Storage::BLOCK_SIZE) * Storage::BLOCK_SIZE;
-		D_ASSERT(part_size * max_part_count >= config_params.max_file_size);
+		D_ASSERT(config_params.part_size > 0 || part_size * max_part_count >= config_params.max_file_size);
 
 		multipart_upload_id = s3fs.InitializeMultipartUpload(*this);
 
-		// Threads are limited by limiting the amount of write buffers available, since each
-		s3fs.buffers_available = config_params.max_upload_threads;
+		// Threads are limited by limiting the amount of write buffers in use, see S3FileSystem::GetBuffer
 		uploads_in_progress = 0;
 		parts_uploaded = 0;
 		upload_finalized = false;
@@ -718,6 +783,9 @@ void S3FileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx
 	if (!(s3fh.flags & FileFlags::FILE_FLAGS_WRITE)) {
 		throw InternalException("Write called on file not opened in write mode");
 	}
+	// Stop writing as soon as the upload of a part failed
+	ThrowUploadException(s3fh);
+
 	int64_t bytes_written = 0;
 
 	while (bytes_written < nr_bytes) {
@@ -729,6 +797,11 @@ void S3FileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx
 
 		// Find buffer for writing
 		auto write_buffer_idx = curr_location / s3fh.part_size;
+		if (write_buffer_idx >= s3fh.config_params.max_parts_per_file) {
+			throw std::runtime_error("Cannot write more than " + to_string(s3fh.config_params.max_parts_per_file) +
+			                         " parts of " + to_string(s3fh.part_size) + " bytes to S3 file \"" + s3fh.path +
+			                         "\", increase s3_uploader_part_size or s3_uploader_max_parts_per_file");
+		}
 
 		// Get write buffer, may block until buffer is available
 		auto write_buffer = GetBuffer(s3fh, write_buffer_idx);
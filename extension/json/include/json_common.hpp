@@ -17,9 +17,34 @@
 
 namespace duckdb {
 
+enum class JSONPathElementType : uint8_t { KEY, INDEX, INDEX_FROM_BACK };
+
+struct JSONPathElement {
+	JSONPathElementType type;
+	//! The key of the object field (KEY)
+	string key;
+	//! The index of the array element (INDEX, INDEX_FROM_BACK)
+	idx_t index;
+};
+
+//! A constant JSON path query, which is compiled once when the function is bound instead of for every row
+struct JSONPath {
+public:
+	JSONPath() {
+	}
+	//! Compile a path that has been checked already
+	explicit JSONPath(string path_p);
+
+public:
+	//! The path query in '/' or '$' notation
+	string path;
+	//! The elements of a '$' path
+	vector<JSONPathElement> elements;
+};
+
 struct JSONReadFunctionData : public FunctionData {
 public:
-	JSONReadFunctionData(bool constant, string path_p, idx_t len);
+	JSONReadFunctionData(bool constant, JSONPath path_p);
 	unique_ptr<FunctionData> Copy() const override;
 	bool Equals(const FunctionData &other_p) const override;
 	static unique_ptr<FunctionData> Bind(ClientContext &context, ScalarFunction &bound_function,
@@ -27,23 +52,19 @@ public:
 
 public:
 	const bool constant;
-	const string path;
-	const char *ptr;
-	const size_t len;
+	const JSONPath path;
 };
 
 struct JSONReadManyFunctionData : public FunctionData {
 public:
-	JSONReadManyFunctionData(vector<string> paths_p, vector<size_t> lens_p);
+	explicit JSONReadManyFunctionData(vector<JSONPath> paths_p);
 	unique_ptr<FunctionData> Copy() const override;
 	bool Equals(const FunctionData &other_p) const override;
 	static unique_ptr<FunctionData> Bind(ClientContext &context, ScalarFunction &bound_function,
 	                                     vector<unique_ptr<Expression>> &arguments);
 
 public:
-	const vector<string> paths;
-	vector<const char *> ptrs;
-	const vector<size_t> lens;
+	const vector<JSONPath> paths;
 };
 
 template <class YYJSON_DOC_T>
@@ -194,6 +215,8 @@ public:
 public:
 	//! Validate path with $ syntax
 	static void ValidatePathDollar(const char *ptr, const idx_t &len);
+	//! Parse a (valid) path with $ syntax into its elements
+	static vector<JSONPathElement> CompilePathDollar(const char *ptr, const idx_t &len);
 
 	//! Get JSON value using JSON path query (safe, checks the path query)
 	template <class YYJSON_VAL_T>
@@ -219,6 +242,43 @@ public:
 		}
 	}
 
+	//! Get JSON value using a compiled JSON path query
+	template <class YYJSON_VAL_T>
+	static inline YYJSON_VAL_T *GetPointer(YYJSON_VAL_T *root, const JSONPath &path) {
+		if (path.path[0] == '/') {
+			return TemplatedGetPointer<YYJSON_VAL_T>(root, path.path.c_str(), path.path.size());
+		}
+		YYJSON_VAL_T *val = root;
+		for (const auto &element : path.elements) {
+			switch (element.type) {
+			case JSONPathElementType::KEY:
+				if (!IsObj<YYJSON_VAL_T>(val)) {
+					return nullptr;
+				}
+				val = ObjGetN<YYJSON_VAL_T>(val, element.key.c_str(), element.key.size());
+				break;
+			case JSONPathElementType::INDEX:
+				if (!IsArr<YYJSON_VAL_T>(val)) {
+					return nullptr;
+				}
+				val = ArrGet<YYJSON_VAL_T>(val, element.index);
+				break;
+			case JSONPathElementType::INDEX_FROM_BACK: {
+				if (!IsArr<YYJSON_VAL_T>(val)) {
+					return nullptr;
+				}
+				auto arr_size = ArrSize<YYJSON_VAL_T>(val);
+				val = ArrGet<YYJSON_VAL_T>(val, element.index > arr_size ? arr_size : arr_size - element.index);
+				break;
+			}
+			}
+			if (!val) {
+				return nullptr;
+			}
+		}
+		return val;
+	}
+
 	//! Get JSON value using JSON path query (unsafe)
 	template <class YYJSON_VAL_T>
 	static inline YYJSON_VAL_T *GetPointerUnsafe(YYJSON_VAL_T *root, const char *ptr, const idx_t &len) {
@@ -257,13 +317,12 @@ public:
 		auto &inputs = args.data[0];
 		if (info.constant) {
 			// Constant path
-			const char *ptr = info.ptr;
-			const idx_t &len = info.len;
+			const auto &path = info.path;
 			UnaryExecutor::ExecuteWithNulls<string_t, T>(
 			    inputs, result, args.size(), [&](string_t input, ValidityMask &mask, idx_t idx) {
 				    auto doc = ReadDocument(input);
 				    yyjson_val *val;
-				    if (!(val = GetPointerUnsafe<yyjson_val>(doc->root, ptr, len))) {
+				    if (!(val = GetPointer<yyjson_val>(doc->root, path))) {
 					    mask.SetInvalid(idx);
 					    return T {};
 				    } else {
@@ -293,10 +352,9 @@ public:
 	                        std::function<T(yyjson_val *, Vector &)> fun) {
 		auto &func_expr = (BoundFunctionExpression &)state.expr;
 		const auto &info = (JSONReadManyFunctionData &)*func_expr.bind_info;
-		D_ASSERT(info.ptrs.size() == info.lens.size());
 
 		const auto count = args.size();
-		const idx_t num_paths = info.ptrs.size();
+		const idx_t num_paths = info.paths.size();
 		const idx_t list_size = count * num_paths;
 
 		VectorData input_data;
@@ -321,10 +379,11 @@ public:
 				continue;
 			}
 
+			// The document is parsed once for all paths
 			auto doc = ReadDocument(inputs[idx]);
 			for (idx_t path_i = 0; path_i < num_paths; path_i++) {
 				auto child_idx = offset + path_i;
-				if (!(val = GetPointerUnsafe<yyjson_val>(doc->root, info.ptrs[path_i], info.lens[path_i]))) {
+				if (!(val = GetPointer<yyjson_val>(doc->root, info.paths[path_i]))) {
 					child_validity.SetInvalid(child_idx);
 				} else {
 					child_data[child_idx] = fun(val, child);
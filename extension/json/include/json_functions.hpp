@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/parser/parsed_data/create_scalar_function_info.hpp"
+#include "duckdb/parser/parsed_data/create_table_function_info.hpp"
 
 namespace duckdb {
 
@@ -41,6 +42,8 @@ public:
 		return functions;
 	}
 
+	static vector<CreateTableFunctionInfo> GetTableFunctions();
+
 private:
 	static CreateScalarFunctionInfo GetExtractFunction();
 	static CreateScalarFunctionInfo GetExtractStringFunction();
@@ -0,0 +1,25 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// json_structure.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "json_common.hpp"
+
+namespace duckdb {
+
+struct JSONStructure {
+public:
+	//! Get the structure of a JSON value, i.e., the value with all primitive values replaced by their JSON type
+	static yyjson_mut_val *GetStructure(yyjson_val *val, yyjson_mut_doc *structure_doc);
+	//! Merge the structures of multiple JSON values into one (throws if the structures are inconsistent)
+	static yyjson_mut_val *MergeStructures(const vector<yyjson_mut_val *> &structures, yyjson_mut_doc *structure_doc);
+	//! Get the LogicalType that json_transform would use for the structure (the structure cannot be used afterwards)
+	static LogicalType StructureToType(yyjson_mut_val *structure, yyjson_mut_doc *structure_doc);
+};
+
+} // namespace duckdb
@@ -0,0 +1,23 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// json_transform.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "json_common.hpp"
+
+namespace duckdb {
+
+struct JSONTransform {
+public:
+	//! Get the LogicalType of a JSON structure containing type strings
+	static LogicalType StructureToType(yyjson_val *structure);
+	//! Transform the JSON values to the type of the result vector (missing values become NULL)
+	static void Transform(yyjson_val *vals[], Vector &result, const idx_t count, bool strict);
+};
+
+} // namespace duckdb
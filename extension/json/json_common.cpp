@@ -2,14 +2,14 @@
 
 namespace duckdb {
 
-static void CheckPath(const Value &path_val, string &path, size_t &len) {
+static string CheckPath(const Value &path_val) {
 	string error;
 	Value path_str_val;
 	if (!path_val.TryCastAs(LogicalType::VARCHAR, path_str_val, &error)) {
 		throw InvalidInputException(error);
 	}
 	auto path_str = path_str_val.GetValueUnsafe<string_t>();
-	len = path_str.GetSize();
+	auto len = path_str.GetSize();
 	auto ptr = path_str.GetDataUnsafe();
 	// Empty strings and invalid $ paths yield an error
 	if (len == 0) {
@@ -20,54 +20,59 @@ static void CheckPath(const Value &path_val, string &path, size_t &len) {
 	}
 	// Copy over string to the bind data
 	if (*ptr == '/' || *ptr == '$') {
-		path = string(ptr, len);
+		return string(ptr, len);
 	} else {
-		path = "/" + string(ptr, len);
-		len++;
+		return "/" + string(ptr, len);
 	}
 }
 
-JSONReadFunctionData::JSONReadFunctionData(bool constant, string path_p, idx_t len)
-    : constant(constant), path(move(path_p)), ptr(path.c_str()), len(len) {
+JSONPath::JSONPath(string path_p) : path(move(path_p)) {
+	D_ASSERT(!path.empty());
+	if (path[0] == '$') {
+		elements = JSONCommon::CompilePathDollar(path.c_str(), path.size());
+	}
+}
+
+JSONReadFunctionData::JSONReadFunctionData(bool constant, JSONPath path_p) : constant(constant), path(move(path_p)) {
 }
 
 unique_ptr<FunctionData> JSONReadFunctionData::Copy() const {
-	return make_unique<JSONReadFunctionData>(constant, path, len);
+	return make_unique<JSONReadFunctionData>(constant, path);
 }
 
 bool JSONReadFunctionData::Equals(const FunctionData &other_p) const {
 	auto &other = (const JSONReadFunctionData &)other_p;
-	return constant == other.constant && path == other.path && len == other.len;
+	return constant == other.constant && path.path == other.path.path;
 }
 
 unique_ptr<FunctionData> JSONReadFunctionData::Bind(ClientContext &context, ScalarFunction &bound_function,
                                                     vector<unique_ptr<Expression>> &arguments) {
 	D_ASSERT(bound_function.arguments.size() == 2);
-	bool constant = false;
-	string path = "";
-	size_t len = 0;
 	if (arguments[1]->return_type.id() != LogicalTypeId::SQLNULL && arguments[1]->IsFoldable()) {
-		constant = true;
 		const auto path_val = ExpressionExecutor::EvaluateScalar(*arguments[1]);
-		CheckPath(path_val, path, len);
+		return make_unique<JSONReadFunctionData>(true, JSONPath(CheckPath(path_val)));
 	}
-	return make_unique<JSONReadFunctionData>(constant, move(path), len);
+	return make_unique<JSONReadFunctionData>(false, JSONPath());
 }
 
-JSONReadManyFunctionData::JSONReadManyFunctionData(vector<string> paths_p, vector<size_t> lens_p)
-    : paths(move(paths_p)), lens(move(lens_p)) {
-	for (const auto &path : paths) {
-		ptrs.push_back(path.c_str());
-	}
+JSONReadManyFunctionData::JSONReadManyFunctionData(vector<JSONPath> paths_p) : paths(move(paths_p)) {
 }
 
 unique_ptr<FunctionData> JSONReadManyFunctionData::Copy() const {
-	return make_unique<JSONReadManyFunctionData>(paths, lens);
+	return make_unique<JSONReadManyFunctionData>(paths);
 }
 
 bool JSONReadManyFunctionData::Equals(const FunctionData &other_p) const {
 	auto &other = (const JSONReadManyFunctionData &)other_p;
-	return paths == other.paths && lens == other.lens;
+	if (paths.size() != other.paths.size()) {
+		return false;
+	}
+	for (idx_t i = 0; i < paths.size(); i++) {
+		if (paths[i].path != other.paths[i].path) {
+			return false;
+		}
+	}
+	return true;
 }
 
 unique_ptr<FunctionData> JSONReadManyFunctionData::Bind(ClientContext &context, ScalarFunction &bound_function,
@@ -77,19 +82,16 @@ unique_ptr<FunctionData> JSONReadManyFunctionData::Bind(ClientContext &context,
 		throw InvalidInputException("List of paths must be constant");
 	}
 	if (arguments[1]->return_type.id() == LogicalTypeId::SQLNULL) {
-		return make_unique<JSONReadManyFunctionData>(vector<string>(), vector<size_t>());
+		return make_unique<JSONReadManyFunctionData>(vector<JSONPath>());
 	}
 
-	vector<string> paths;
-	vector<size_t> lens;
+	vector<JSONPath> paths;
 	auto paths_val = ExpressionExecutor::EvaluateScalar(*arguments[1]);
 	for (auto &path_val : ListValue::GetChildren(paths_val)) {
-		paths.emplace_back("");
-		lens.push_back(0);
-		CheckPath(path_val, paths.back(), lens.back());
+		paths.emplace_back(CheckPath(path_val));
 	}
 
-	return make_unique<JSONReadManyFunctionData>(move(paths), move(lens));
+	return make_unique<JSONReadManyFunctionData>(move(paths));
 }
 
 string ThrowPathError(const char *ptr, const char *end) {
@@ -149,4 +151,56 @@ void JSONCommon::ValidatePathDollar(const char *ptr, const idx_t &len) {
 	}
 }
 
-} // namespace duckdb
\ No newline at end of file
+vector<JSONPathElement> JSONCommon::CompilePathDollar(const char *ptr, const idx_t &len) {
+	vector<JSONPathElement> result;
+	const char *const end = ptr + len;
+	// Skip past '$'
+	ptr++;
+	while (ptr != end) {
+		const auto &c = *ptr++;
+		JSONPathElement element;
+		if (c == '.') {
+			// Object
+			bool escaped = false;
+			if (*ptr == '"') {
+				// Skip past opening '"'
+				ptr++;
+				escaped = true;
+			}
+			auto key_len = ReadString(ptr, end, escaped);
+			element.type = JSONPathElementType::KEY;
+			element.key = string(ptr, key_len);
+			ptr += key_len;
+			if (escaped) {
+				// Skip past closing '"'
+				ptr++;
+			}
+		} else {
+			// Array
+			D_ASSERT(c == '[');
+			element.type = JSONPathElementType::INDEX;
+			if (*ptr == '#') {
+				// Index from back of array
+				element.type = JSONPathElementType::INDEX_FROM_BACK;
+				ptr++;
+				if (*ptr == ']') {
+					// '[#]' is past the end of the array, i.e., index 0 from the back
+					element.index = 0;
+					ptr++;
+					result.push_back(move(element));
+					continue;
+				}
+				// Skip past '-'
+				ptr++;
+			}
+			auto idx_len = ReadIndex(ptr, end, element.index);
+			ptr += idx_len;
+			// Skip past closing ']'
+			ptr++;
+		}
+		result.push_back(move(element));
+	}
+	return result;
+}
+
+} // namespace duckdb
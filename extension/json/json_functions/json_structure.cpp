@@ -1,5 +1,7 @@
 #include "json_common.hpp"
 #include "json_functions.hpp"
+#include "json_structure.hpp"
+#include "json_transform.hpp"
 
 namespace duckdb {
 
@@ -208,6 +210,24 @@ static void StructureFunction(DataChunk &args, ExpressionState &state, Vector &r
 	JSONCommon::UnaryExecute<string_t>(args, state, result, Structure);
 }
 
+yyjson_mut_val *JSONStructure::GetStructure(yyjson_val *val, yyjson_mut_doc *structure_doc) {
+	return duckdb::BuildStructure(val, structure_doc);
+}
+
+yyjson_mut_val *JSONStructure::MergeStructures(const vector<yyjson_mut_val *> &structures,
+                                               yyjson_mut_doc *structure_doc) {
+	return GetConsistentArrayStructure(structures, structure_doc);
+}
+
+LogicalType JSONStructure::StructureToType(yyjson_mut_val *structure, yyjson_mut_doc *structure_doc) {
+	// Convert to type strings, and read the result back in so we can use the json_transform logic
+	yyjson_mut_doc_set_root(structure_doc, ConvertStructure(structure, structure_doc));
+	idx_t len;
+	auto data = JSONCommon::MutWrite(structure_doc, len);
+	auto doc = JSONCommon::ReadDocument(string_t(data.get(), len));
+	return JSONTransform::StructureToType(doc->root);
+}
+
 CreateScalarFunctionInfo JSONFunctions::GetStructureFunction() {
 	return CreateScalarFunctionInfo(ScalarFunction("json_structure", {LogicalType::JSON}, LogicalType::JSON,
 	                                               StructureFunction, false, nullptr, nullptr, nullptr));
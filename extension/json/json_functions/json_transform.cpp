@@ -2,6 +2,7 @@
 #include "duckdb/function/scalar/nested_functions.hpp"
 #include "json_common.hpp"
 #include "json_functions.hpp"
+#include "json_transform.hpp"
 
 namespace duckdb {
 
@@ -389,6 +390,14 @@ static void TransformFunction(DataChunk &args, ExpressionState &state, Vector &r
 	Transform(vals, result, count, strict);
 }
 
+LogicalType JSONTransform::StructureToType(yyjson_val *structure) {
+	return duckdb::StructureToType(structure);
+}
+
+void JSONTransform::Transform(yyjson_val *vals[], Vector &result, const idx_t count, bool strict) {
+	duckdb::Transform(vals, result, count, strict);
+}
+
 CreateScalarFunctionInfo JSONFunctions::GetTransformFunction() {
 	return CreateScalarFunctionInfo(ScalarFunction("json_transform", {LogicalType::JSON, LogicalType::JSON},
 	                                               LogicalType::ANY, TransformFunction<false>, false, JSONTransformBind,
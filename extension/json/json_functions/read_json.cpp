@@ -0,0 +1,425 @@
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/main/config.hpp"
+#include "json_common.hpp"
+#include "json_functions.hpp"
+#include "json_structure.hpp"
+#include "json_transform.hpp"
+
+namespace duckdb {
+
+//! Files are split into ranges of this size, which are read in parallel
+static constexpr const idx_t JSON_RANGE_SIZE = 1 << 20;
+//! How much to read at a time when looking for the end of the last record of a range
+static constexpr const idx_t JSON_READ_AHEAD_SIZE = 1 << 16;
+//! Number of records that are sampled to detect the schema
+static constexpr const idx_t JSON_DEFAULT_SAMPLE_SIZE = 2 * STANDARD_VECTOR_SIZE;
+
+struct ReadJSONBindData : public TableFunctionData {
+	//! The files to read
+	vector<string> files;
+	//! The column names and types
+	vector<string> names;
+	vector<LogicalType> types;
+	//! Whether the columns are the fields of the records (true), or the records themselves (false)
+	bool unpack_objects = true;
+	//! Whether values that cannot be converted to the type of their column are read as NULL (true), or throw (false)
+	bool ignore_errors = false;
+};
+
+//! Reads the newline-delimited JSON records that start within a byte range of a file
+class JSONRangeReader {
+public:
+	JSONRangeReader(FileSystem &fs, FileOpener *opener) : fs(fs), opener(opener) {
+	}
+
+	//! Read the records that start within [start, end)
+	void Open(const string &file_path, idx_t start, idx_t end);
+	//! Get the next record, returns false if there are none left
+	bool NextRecord(const char *&record, idx_t &length);
+
+	const string &GetFilePath() const {
+		return file_path;
+	}
+	idx_t GetFileSize() const {
+		return file_size;
+	}
+
+private:
+	void Read(idx_t location, idx_t size);
+
+private:
+	FileSystem &fs;
+	FileOpener *opener;
+
+	string file_path;
+	unique_ptr<FileHandle> handle;
+	idx_t file_size = 0;
+
+	unique_ptr<char[]> buffer;
+	idx_t buffer_capacity = 0;
+	idx_t buffer_size = 0;
+	idx_t buffer_offset = 0;
+};
+
+void JSONRangeReader::Open(const string &file_path_p, idx_t start, idx_t end) {
+	if (!handle || file_path != file_path_p) {
+		file_path = file_path_p;
+		handle = fs.OpenFile(file_path, FileFlags::FILE_FLAGS_READ, FileLockType::NO_LOCK,
+		                     FileCompressionType::UNCOMPRESSED, opener);
+		file_size = handle->GetFileSize();
+	}
+	end = MinValue<idx_t>(end, file_size);
+	buffer_size = 0;
+	buffer_offset = 0;
+	if (start >= end) {
+		return;
+	}
+	// a record starts within the range if it is preceded by a newline, so we also read the byte before the range
+	auto read_start = start == 0 ? 0 : start - 1;
+	Read(read_start, end - read_start);
+	// the last record that starts within the range ends at the first newline at or after the last byte of the range
+	idx_t search_offset = end - 1 - read_start;
+	idx_t location = end;
+	while (true) {
+		auto newline = (char *)memchr(buffer.get() + search_offset, '\n', buffer_size - search_offset);
+		if (newline) {
+			buffer_size = newline - buffer.get() + 1;
+			break;
+		}
+		if (location >= file_size) {
+			break;
+		}
+		search_offset = buffer_size;
+		auto read_size = MinValue<idx_t>(JSON_READ_AHEAD_SIZE, file_size - location);
+		Read(location, read_size);
+		location += read_size;
+	}
+	if (start > 0) {
+		// skip the (remainder of the) record that started before the range
+		auto newline = (char *)memchr(buffer.get(), '\n', buffer_size);
+		buffer_offset = newline ? newline - buffer.get() + 1 : buffer_size;
+	}
+}
+
+void JSONRangeReader::Read(idx_t location, idx_t size) {
+	if (buffer_size + size > buffer_capacity) {
+		auto new_capacity = MaxValue<idx_t>(buffer_capacity * 2, buffer_size + size);
+		auto new_buffer = unique_ptr<char[]>(new char[new_capacity]);
+		if (buffer_size > 0) {
+			memcpy(new_buffer.get(), buffer.get(), buffer_size);
+		}
+		buffer = move(new_buffer);
+		buffer_capacity = new_capacity;
+	}
+	handle->Read(buffer.get() + buffer_size, size, location);
+	buffer_size += size;
+}
+
+static inline bool IsJSONWhitespace(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool JSONRangeReader::NextRecord(const char *&record, idx_t &length) {
+	while (buffer_offset < buffer_size) {
+		auto record_start = buffer.get() + buffer_offset;
+		auto remaining = buffer_size - buffer_offset;
+		auto newline = (char *)memchr(record_start, '\n', remaining);
+		auto record_end = newline ? newline : record_start + remaining;
+		buffer_offset += record_end - record_start + (newline ? 1 : 0);
+		// skip empty lines
+		while (record_start < record_end && IsJSONWhitespace(*record_start)) {
+			record_start++;
+		}
+		if (record_start == record_end) {
+			continue;
+		}
+		record = record_start;
+		length = record_end - record_start;
+		return true;
+	}
+	return false;
+}
+
+static DocPointer<yyjson_doc> ReadJSONRecord(const JSONRangeReader &reader, const char *record, idx_t length) {
+	auto doc = JSONCommon::ReadDocumentUnsafe(string_t(record, length));
+	if (doc.IsNull()) {
+		throw InvalidInputException("Malformed JSON in file \"%s\": %s", reader.GetFilePath(),
+		                            string(record, MinValue<idx_t>(length, 100)));
+	}
+	return doc;
+}
+
+//! Fields that were NULL (or empty objects) in all sampled records are read as JSON
+static LogicalType ReplaceUnknownTypes(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::SQLNULL:
+		return LogicalType::JSON;
+	case LogicalTypeId::LIST:
+		return LogicalType::LIST(ReplaceUnknownTypes(ListType::GetChildType(type)));
+	case LogicalTypeId::STRUCT: {
+		auto &child_types = StructType::GetChildTypes(type);
+		if (child_types.empty()) {
+			return LogicalType::JSON;
+		}
+		child_list_t<LogicalType> new_child_types;
+		for (auto &child_type : child_types) {
+			new_child_types.emplace_back(child_type.first, ReplaceUnknownTypes(child_type.second));
+		}
+		return LogicalType::STRUCT(move(new_child_types));
+	}
+	default:
+		return type;
+	}
+}
+
+//! Detect the columns from the structure of the first sample_size records
+static void ReadJSONDetectColumns(ClientContext &context, ReadJSONBindData &bind_data, idx_t sample_size) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	JSONRangeReader reader(fs, FileSystem::GetFileOpener(context));
+
+	vector<DocPointer<yyjson_doc>> docs;
+	auto structure_doc = JSONCommon::CreateDocument();
+	vector<yyjson_mut_val *> structures;
+	for (idx_t file_idx = 0; file_idx < bind_data.files.size() && structures.size() < sample_size; file_idx++) {
+		auto &file = bind_data.files[file_idx];
+		for (idx_t start = 0; structures.size() < sample_size; start += JSON_RANGE_SIZE) {
+			reader.Open(file, start, start + JSON_RANGE_SIZE);
+			const char *record;
+			idx_t length;
+			while (structures.size() < sample_size && reader.NextRecord(record, length)) {
+				// the structure references the keys of the document, so we need to keep it alive
+				docs.push_back(ReadJSONRecord(reader, record, length));
+				structures.push_back(JSONStructure::GetStructure(docs.back()->root, *structure_doc));
+			}
+			if (start + JSON_RANGE_SIZE >= reader.GetFileSize()) {
+				break;
+			}
+		}
+	}
+
+	if (structures.empty()) {
+		// nothing to detect, read the records as JSON
+		bind_data.unpack_objects = false;
+		bind_data.names.emplace_back("json");
+		bind_data.types.push_back(LogicalType::JSON);
+		return;
+	}
+	auto structure = JSONStructure::MergeStructures(structures, *structure_doc);
+	auto type = ReplaceUnknownTypes(JSONStructure::StructureToType(structure, *structure_doc));
+	if (type.id() == LogicalTypeId::STRUCT) {
+		// the records are objects: every field becomes a column
+		bind_data.unpack_objects = true;
+		for (auto &child_type : StructType::GetChildTypes(type)) {
+			bind_data.names.push_back(child_type.first);
+			bind_data.types.push_back(child_type.second);
+		}
+	} else {
+		bind_data.unpack_objects = false;
+		bind_data.names.emplace_back("json");
+		bind_data.types.push_back(type);
+	}
+}
+
+static unique_ptr<FunctionData> ReadJSONBind(ClientContext &context, TableFunctionBindInput &input,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	auto &config = DBConfig::GetConfig(context);
+	if (!config.enable_external_access) {
+		throw PermissionException("Scanning JSON files is disabled through configuration");
+	}
+	auto result = make_unique<ReadJSONBindData>();
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto file_pattern = StringValue::Get(input.inputs[0]);
+	result->files = fs.Glob(file_pattern, context);
+	if (result->files.empty()) {
+		throw IOException("No files found that match the pattern \"%s\"", file_pattern);
+	}
+
+	idx_t sample_size = JSON_DEFAULT_SAMPLE_SIZE;
+	for (auto &kv : input.named_parameters) {
+		auto loption = StringUtil::Lower(kv.first);
+		if (loption == "columns") {
+			auto &child_type = kv.second.type();
+			if (child_type.id() != LogicalTypeId::STRUCT) {
+				throw BinderException("read_json \"columns\" parameter requires a struct as input");
+			}
+			auto &struct_children = StructValue::GetChildren(kv.second);
+			D_ASSERT(StructType::GetChildCount(child_type) == struct_children.size());
+			for (idx_t i = 0; i < struct_children.size(); i++) {
+				auto &val = struct_children[i];
+				if (val.type().id() != LogicalTypeId::VARCHAR) {
+					throw BinderException("read_json \"columns\" parameter requires a type specification as string");
+				}
+				result->names.push_back(StructType::GetChildName(child_type, i));
+				result->types.push_back(TransformStringToLogicalType(StringValue::Get(val)));
+			}
+			if (result->names.empty()) {
+				throw BinderException("read_json \"columns\" parameter needs at least one column");
+			}
+		} else if (loption == "sample_size") {
+			auto arg = BigIntValue::Get(kv.second);
+			if (arg <= 0) {
+				throw BinderException("read_json \"sample_size\" parameter must be positive");
+			}
+			sample_size = arg;
+		} else if (loption == "ignore_errors") {
+			result->ignore_errors = BooleanValue::Get(kv.second);
+		}
+	}
+	if (result->names.empty()) {
+		ReadJSONDetectColumns(context, *result, sample_size);
+	}
+
+	return_types = result->types;
+	names = result->names;
+	return move(result);
+}
+
+struct ReadJSONGlobalState : public GlobalTableFunctionState {
+	mutex lock;
+	//! The sizes of the files
+	vector<idx_t> file_sizes;
+	//! The next range to read
+	idx_t file_index = 0;
+	idx_t file_offset = 0;
+	//! The index of the next range over all files, which is the batch index of its records
+	idx_t range_index = 0;
+	//! The total number of ranges
+	idx_t range_count = 0;
+
+	idx_t MaxThreads() const override {
+		return MaxValue<idx_t>(range_count, 1);
+	}
+};
+
+struct ReadJSONLocalState : public LocalTableFunctionState {
+	ReadJSONLocalState(FileSystem &fs, FileOpener *opener) : reader(fs, opener) {
+	}
+
+	JSONRangeReader reader;
+	vector<column_t> column_ids;
+	//! The index of the range that is being read
+	idx_t batch_index = 0;
+};
+
+static unique_ptr<GlobalTableFunctionState> ReadJSONInitGlobal(ClientContext &context,
+                                                               TableFunctionInitInput &input) {
+	auto &bind_data = (ReadJSONBindData &)*input.bind_data;
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto opener = FileSystem::GetFileOpener(context);
+	auto result = make_unique<ReadJSONGlobalState>();
+	for (auto &file : bind_data.files) {
+		auto handle = fs.OpenFile(file, FileFlags::FILE_FLAGS_READ, FileLockType::NO_LOCK,
+		                          FileCompressionType::UNCOMPRESSED, opener);
+		auto file_size = handle->GetFileSize();
+		result->file_sizes.push_back(file_size);
+		result->range_count += (file_size + JSON_RANGE_SIZE - 1) / JSON_RANGE_SIZE;
+	}
+	return move(result);
+}
+
+static unique_ptr<LocalTableFunctionState> ReadJSONInitLocal(ClientContext &context, TableFunctionInitInput &input,
+                                                             GlobalTableFunctionState *gstate_p) {
+	auto result = make_unique<ReadJSONLocalState>(FileSystem::GetFileSystem(context),
+	                                              FileSystem::GetFileOpener(context));
+	result->column_ids = input.column_ids;
+	return move(result);
+}
+
+//! Assigns the next range to the local state, returns false if there are no ranges left
+static bool ReadJSONNextRange(const ReadJSONBindData &bind_data, ReadJSONGlobalState &gstate,
+                              ReadJSONLocalState &lstate) {
+	idx_t file_index;
+	idx_t start;
+	{
+		lock_guard<mutex> guard(gstate.lock);
+		while (gstate.file_index < bind_data.files.size() &&
+		       gstate.file_offset >= gstate.file_sizes[gstate.file_index]) {
+			gstate.file_index++;
+			gstate.file_offset = 0;
+		}
+		if (gstate.file_index >= bind_data.files.size()) {
+			return false;
+		}
+		file_index = gstate.file_index;
+		start = gstate.file_offset;
+		gstate.file_offset += JSON_RANGE_SIZE;
+		lstate.batch_index = gstate.range_index++;
+	}
+	// the I/O happens outside of the lock
+	lstate.reader.Open(bind_data.files[file_index], start, start + JSON_RANGE_SIZE);
+	return true;
+}
+
+static void ReadJSONFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = (ReadJSONBindData &)*data_p.bind_data;
+	auto &gstate = (ReadJSONGlobalState &)*data_p.global_state;
+	auto &lstate = (ReadJSONLocalState &)*data_p.local_state;
+
+	// parse the next STANDARD_VECTOR_SIZE records
+	vector<DocPointer<yyjson_doc>> docs;
+	yyjson_val *vals[STANDARD_VECTOR_SIZE];
+	idx_t count = 0;
+	const char *record;
+	idx_t length;
+	while (count < STANDARD_VECTOR_SIZE) {
+		if (!lstate.reader.NextRecord(record, length)) {
+			if (count > 0) {
+				// a chunk only holds the records of a single range, so that its batch index is well-defined
+				break;
+			}
+			if (!ReadJSONNextRange(bind_data, gstate, lstate)) {
+				break;
+			}
+			continue;
+		}
+		docs.push_back(ReadJSONRecord(lstate.reader, record, length));
+		vals[count++] = docs.back()->root;
+	}
+	if (count == 0) {
+		return;
+	}
+
+	// transform the records into the projected columns
+	bool strict = !bind_data.ignore_errors;
+	yyjson_val *field_vals[STANDARD_VECTOR_SIZE];
+	for (idx_t col_idx = 0; col_idx < lstate.column_ids.size(); col_idx++) {
+		auto column_id = lstate.column_ids[col_idx];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
+			continue;
+		}
+		if (!bind_data.unpack_objects) {
+			JSONTransform::Transform(vals, output.data[col_idx], count, strict);
+			continue;
+		}
+		auto &name = bind_data.names[column_id];
+		for (idx_t i = 0; i < count; i++) {
+			field_vals[i] = yyjson_obj_getn(vals[i], name.c_str(), name.size());
+		}
+		JSONTransform::Transform(field_vals, output.data[col_idx], count, strict);
+	}
+	output.SetCardinality(count);
+}
+
+static idx_t ReadJSONGetBatchIndex(ClientContext &context, const FunctionData *bind_data_p,
+                                   LocalTableFunctionState *local_state, GlobalTableFunctionState *global_state) {
+	auto &lstate = (ReadJSONLocalState &)*local_state;
+	return lstate.batch_index;
+}
+
+vector<CreateTableFunctionInfo> JSONFunctions::GetTableFunctions() {
+	TableFunction read_json("read_json", {LogicalType::VARCHAR}, ReadJSONFunction, ReadJSONBind, ReadJSONInitGlobal,
+	                        ReadJSONInitLocal);
+	read_json.named_parameters["columns"] = LogicalType::ANY;
+	read_json.named_parameters["sample_size"] = LogicalType::BIGINT;
+	read_json.named_parameters["ignore_errors"] = LogicalType::BOOLEAN;
+	read_json.projection_pushdown = true;
+	read_json.get_batch_index = ReadJSONGetBatchIndex;
+
+	vector<CreateTableFunctionInfo> functions;
+	functions.emplace_back(read_json);
+	read_json.name = "read_ndjson";
+	functions.emplace_back(read_json);
+	return functions;
+}
+
+} // namespace duckdb
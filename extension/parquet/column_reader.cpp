@@ -31,10 +31,22 @@ using duckdb_parquet::format::Encoding;
 using duckdb_parquet::format::PageType;
 using duckdb_parquet::format::Type;
 
-const uint32_t ParquetDecodeUtils::BITPACK_MASKS[] = {
-    0,       1,       3,        7,        15,       31,        63,        127,       255,        511,       1023,
-    2047,    4095,    8191,     16383,    32767,    65535,     131071,    262143,    524287,     1048575,   2097151,
-    4194303, 8388607, 16777215, 33554431, 67108863, 134217727, 268435455, 536870911, 1073741823, 2147483647};
+const uint64_t ParquetDecodeUtils::BITPACK_MASKS[] = {
+    0,                    0x1ULL,                0x3ULL,                0x7ULL,                0xFULL,
+    0x1FULL,              0x3FULL,               0x7FULL,               0xFFULL,               0x1FFULL,
+    0x3FFULL,             0x7FFULL,              0xFFFULL,              0x1FFFULL,             0x3FFFULL,
+    0x7FFFULL,            0xFFFFULL,             0x1FFFFULL,            0x3FFFFULL,            0x7FFFFULL,
+    0xFFFFFULL,           0x1FFFFFULL,           0x3FFFFFULL,           0x7FFFFFULL,           0xFFFFFFULL,
+    0x1FFFFFFULL,         0x3FFFFFFULL,          0x7FFFFFFULL,          0xFFFFFFFULL,          0x1FFFFFFFULL,
+    0x3FFFFFFFULL,        0x7FFFFFFFULL,         0xFFFFFFFFULL,         0x1FFFFFFFFULL,        0x3FFFFFFFFULL,
+    0x7FFFFFFFFULL,       0xFFFFFFFFFULL,        0x1FFFFFFFFFULL,       0x3FFFFFFFFFULL,       0x7FFFFFFFFFULL,
+    0xFFFFFFFFFFULL,      0x1FFFFFFFFFFULL,      0x3FFFFFFFFFFULL,      0x7FFFFFFFFFFULL,      0xFFFFFFFFFFFULL,
+    0x1FFFFFFFFFFFULL,    0x3FFFFFFFFFFFULL,     0x7FFFFFFFFFFFULL,     0xFFFFFFFFFFFFULL,     0x1FFFFFFFFFFFFULL,
+    0x3FFFFFFFFFFFFULL,   0x7FFFFFFFFFFFFULL,    0xFFFFFFFFFFFFFULL,    0x1FFFFFFFFFFFFFULL,   0x3FFFFFFFFFFFFFULL,
+    0x7FFFFFFFFFFFFFULL,  0xFFFFFFFFFFFFFFULL,   0x1FFFFFFFFFFFFFFULL,  0x3FFFFFFFFFFFFFFULL,  0x7FFFFFFFFFFFFFFULL,
+    0xFFFFFFFFFFFFFFFULL, 0x1FFFFFFFFFFFFFFFULL, 0x3FFFFFFFFFFFFFFFULL, 0x7FFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL};
+
+const uint8_t ParquetDecodeUtils::BITPACK_MASKS_SIZE = sizeof(ParquetDecodeUtils::BITPACK_MASKS) / sizeof(uint64_t);
 
 const uint8_t ParquetDecodeUtils::BITPACK_DLEN = 8;
 
@@ -159,11 +171,15 @@ void ColumnReader::InitializeRead(const std::vector<ColumnChunk> &columns, TProt
 		chunk_read_offset = chunk->meta_data.dictionary_page_offset;
 	}
 	group_rows_available = chunk->meta_data.num_values;
+	// any skips or page data left over from the previous row group no longer apply
+	pending_skips = 0;
+	page_rows_available = 0;
 }
 
 void ColumnReader::PrepareRead(parquet_filter_t &filter) {
 	dict_decoder.reset();
 	defined_decoder.reset();
+	dbp_decoder.reset();
 	block.reset();
 
 	PageHeader page_hdr;
@@ -327,8 +343,64 @@ void ColumnReader::PrepareDataPage(PageHeader &page_hdr) {
 	}
 	case Encoding::DELTA_BINARY_PACKED: {
 		dbp_decoder = make_unique<DbpDecoder>((const uint8_t *)block->ptr, block->len);
+		if (schema.type == Type::INT32 && (dbp_decoder->StartValue() < NumericLimits<int32_t>::Minimum() ||
+		                                   dbp_decoder->StartValue() > NumericLimits<int32_t>::Maximum())) {
+			throw std::runtime_error("DELTA_BINARY_PACKED first value does not fit in an INT32 column");
+		}
 		block->inc(block->len);
 		break;
+	}
+	case Encoding::DELTA_LENGTH_BYTE_ARRAY: {
+		// the lengths of all strings are stored up front (DELTA_BINARY_PACKED), followed by the concatenated strings
+		// we convert the page to the plain encoding so we can read the strings directly below
+		DbpDecoder length_decoder((const uint8_t *)block->ptr, block->len);
+		auto value_count = length_decoder.TotalValues();
+		ResizeableBuffer lengths(reader.allocator, sizeof(uint32_t) * value_count);
+		length_decoder.GetBatch<uint32_t>(lengths.ptr, value_count);
+		auto string_data = length_decoder.BufferPtr();
+
+		auto plain_block =
+		    make_shared<ResizeableBuffer>(reader.allocator, sizeof(uint32_t) * value_count + string_data.len);
+		auto length_ptr = (uint32_t *)lengths.ptr;
+		auto plain_ptr = (data_ptr_t)plain_block->ptr;
+		for (idx_t i = 0; i < value_count; i++) {
+			Store<uint32_t>(length_ptr[i], plain_ptr);
+			plain_ptr += sizeof(uint32_t);
+			string_data.copy_to((char *)plain_ptr, length_ptr[i]);
+			string_data.inc(length_ptr[i]);
+			plain_ptr += length_ptr[i];
+		}
+		plain_block->len = plain_ptr - (data_ptr_t)plain_block->ptr;
+		encoded_block = move(block);
+		block = move(plain_block);
+		break;
+	}
+	case Encoding::BYTE_STREAM_SPLIT: {
+		// the k-th byte of every value is stored in the k-th stream: convert the page to the plain encoding
+		idx_t value_width;
+		switch (schema.type) {
+		case Type::FLOAT:
+			value_width = sizeof(float);
+			break;
+		case Type::DOUBLE:
+			value_width = sizeof(double);
+			break;
+		default:
+			throw std::runtime_error("BYTE_STREAM_SPLIT should only be FLOAT or DOUBLE");
+		}
+		auto value_count = block->len / value_width;
+		auto plain_block = make_shared<ResizeableBuffer>(reader.allocator, value_count * value_width);
+		auto src = (const_data_ptr_t)block->ptr;
+		auto dst = (data_ptr_t)plain_block->ptr;
+		for (idx_t byte_idx = 0; byte_idx < value_width; byte_idx++) {
+			auto stream = src + byte_idx * value_count;
+			for (idx_t i = 0; i < value_count; i++) {
+				dst[i * value_width + byte_idx] = stream[i];
+			}
+		}
+		encoded_block = move(block);
+		block = move(plain_block);
+		break;
 	}
 		/*
 	case Encoding::DELTA_BYTE_ARRAY: {
@@ -377,15 +449,15 @@ void ColumnReader::PrepareDataPage(PageHeader &page_hdr) {
 
 idx_t ColumnReader::Read(uint64_t num_values, parquet_filter_t &filter, uint8_t *define_out, uint8_t *repeat_out,
                          Vector &result) {
-	// we need to reset the location because multiple column readers share the same protocol
-	auto &trans = (ThriftFileTransport &)*protocol->getTransport();
-	trans.SetLocation(chunk_read_offset);
-
 	// Perform any skips that were not applied yet.
 	if (pending_skips > 0) {
 		ApplyPendingSkips(pending_skips);
 	}
 
+	// we need to reset the location because multiple column readers share the same protocol
+	auto &trans = (ThriftFileTransport &)*protocol->getTransport();
+	trans.SetLocation(chunk_read_offset);
+
 	idx_t result_offset = 0;
 	auto to_read = num_values;
 
@@ -429,13 +501,14 @@ idx_t ColumnReader::Read(uint64_t num_values, parquet_filter_t &filter, uint8_t
 			// TODO keep this in the state
 			auto read_buf = make_shared<ResizeableBuffer>();
 
-			switch (type.id()) {
-			case LogicalTypeId::INTEGER:
+			// decode into the physical type, the conversion to the logical type happens in Plain()
+			switch (schema.type) {
+			case Type::INT32:
 				read_buf->resize(reader.allocator, sizeof(int32_t) * (read_now - null_count));
 				dbp_decoder->GetBatch<int32_t>(read_buf->ptr, read_now - null_count);
 
 				break;
-			case LogicalTypeId::BIGINT:
+			case Type::INT64:
 				read_buf->resize(reader.allocator, sizeof(int64_t) * (read_now - null_count));
 				dbp_decoder->GetBatch<int64_t>(read_buf->ptr, read_now - null_count);
 				break;
@@ -464,9 +537,54 @@ void ColumnReader::Skip(idx_t num_values) {
 	pending_skips += num_values;
 }
 
+idx_t ColumnReader::SkipPages(idx_t num_values) {
+	if (HasRepeats()) {
+		// with repeats the number of values in a page is not the number of rows
+		return 0;
+	}
+	auto &trans = (ThriftFileTransport &)*protocol->getTransport();
+	idx_t skipped = 0;
+	while (page_rows_available == 0 && skipped < num_values && group_rows_available > 0) {
+		trans.SetLocation(chunk_read_offset);
+		PageHeader page_hdr;
+		page_hdr.read(protocol);
+
+		idx_t page_rows;
+		if (page_hdr.type == PageType::DATA_PAGE && page_hdr.__isset.data_page_header) {
+			page_rows = page_hdr.data_page_header.num_values;
+		} else if (page_hdr.type == PageType::DATA_PAGE_V2 && page_hdr.__isset.data_page_header_v2) {
+			page_rows = page_hdr.data_page_header_v2.num_values;
+		} else if (page_hdr.type == PageType::DICTIONARY_PAGE) {
+			// the dictionary is required by the remaining pages: always read it
+			PreparePage(page_hdr.compressed_page_size, page_hdr.uncompressed_page_size);
+			Dictionary(move(block), page_hdr.dictionary_page_header.num_values);
+			chunk_read_offset = trans.GetLocation();
+			continue;
+		} else {
+			// we cannot skip this page without looking at it
+			break;
+		}
+		if (page_rows > num_values - skipped) {
+			// only part of this page is skipped: we have to decode it
+			break;
+		}
+		// the entire page is skipped: jump over the (compressed) page data
+		chunk_read_offset = trans.GetLocation() + page_hdr.compressed_page_size;
+		group_rows_available -= page_rows;
+		skipped += page_rows;
+	}
+	return skipped;
+}
+
 void ColumnReader::ApplyPendingSkips(idx_t num_values) {
 	pending_skips -= num_values;
 
+	// first skip over any pages that are skipped entirely, without decompressing or decoding them
+	num_values -= SkipPages(num_values);
+	if (num_values == 0) {
+		return;
+	}
+
 	dummy_define.zero();
 	dummy_repeat.zero();
 
@@ -697,10 +815,17 @@ void ListColumnReader::ApplyPendingSkips(idx_t num_values) {
 	pending_skips -= num_values;
 
 	parquet_filter_t filter;
-	auto define_out = unique_ptr<uint8_t[]>(new uint8_t[num_values]);
-	auto repeat_out = unique_ptr<uint8_t[]>(new uint8_t[num_values]);
-	Vector result_out(Type());
-	Read(num_values, filter, define_out.get(), repeat_out.get(), result_out);
+	auto define_out = unique_ptr<uint8_t[]>(new uint8_t[STANDARD_VECTOR_SIZE]);
+	auto repeat_out = unique_ptr<uint8_t[]>(new uint8_t[STANDARD_VECTOR_SIZE]);
+
+	// the result vector only has room for a single vector of lists
+	idx_t remaining = num_values;
+	while (remaining > 0) {
+		idx_t to_read = MinValue<idx_t>(remaining, STANDARD_VECTOR_SIZE);
+		Vector result_out(Type());
+		Read(to_read, filter, define_out.get(), repeat_out.get(), result_out);
+		remaining -= to_read;
+	}
 }
 //===--------------------------------------------------------------------===//
 // Cast Column Reader
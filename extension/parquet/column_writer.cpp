@@ -1,5 +1,7 @@
 #include "column_writer.hpp"
 #include "parquet_writer.hpp"
+#include "parquet_bloom_filter.hpp"
+#include "parquet_dbp_encoder.hpp"
 #include "parquet_rle_bp_decoder.hpp"
 #include "parquet_rle_bp_encoder.hpp"
 
@@ -39,7 +41,7 @@ using duckdb_parquet::format::Type;
 
 #define PARQUET_DEFINE_VALID 65535
 
-static void VarintEncode(uint32_t val, Serializer &ser) {
+static void VarintEncode(uint64_t val, Serializer &ser) {
 	do {
 		uint8_t byte = val & 127;
 		val >>= 7;
@@ -166,6 +168,107 @@ void RleBpEncoder::FinishWrite(Serializer &writer) {
 	WriteRun(writer);
 }
 
+//===--------------------------------------------------------------------===//
+// DbpEncoder
+//===--------------------------------------------------------------------===//
+static uint64_t ZigzagEncode(int64_t val) {
+	return (uint64_t(val) << 1) ^ uint64_t(val >> 63);
+}
+
+constexpr const idx_t DbpEncoder::BLOCK_SIZE;
+constexpr const idx_t DbpEncoder::MINIBLOCKS_PER_BLOCK;
+constexpr const idx_t DbpEncoder::VALUES_PER_MINIBLOCK;
+
+void DbpEncoder::Write(Serializer &writer, const int64_t *values, idx_t count, idx_t bit_width) {
+	D_ASSERT(bit_width == 32 || bit_width == 64);
+	const uint64_t mask = bit_width == 64 ? NumericLimits<uint64_t>::Maximum() : (uint64_t(1) << bit_width) - 1;
+	const idx_t sign_shift = 64 - bit_width;
+
+	// <block size in values> <number of miniblocks in a block> <total value count> <first value>
+	VarintEncode(BLOCK_SIZE, writer);
+	VarintEncode(MINIBLOCKS_PER_BLOCK, writer);
+	VarintEncode(count, writer);
+	// the first value is wrapped to the width of the physical type, e.g. UINTEGER values are stored as (signed) INT32
+	auto first_value = count > 0 ? int64_t(uint64_t(values[0]) << sign_shift) >> sign_shift : 0;
+	VarintEncode(ZigzagEncode(first_value), writer);
+
+	int64_t deltas[BLOCK_SIZE];
+	uint64_t relative_deltas[BLOCK_SIZE];
+	uint8_t bit_widths[MINIBLOCKS_PER_BLOCK];
+	for (idx_t block_start = 1; block_start < count; block_start += BLOCK_SIZE) {
+		auto block_count = MinValue<idx_t>(BLOCK_SIZE, count - block_start);
+		// compute the deltas (wrapping around at the width of the physical type) and the minimum delta of the block
+		int64_t min_delta = NumericLimits<int64_t>::Maximum();
+		for (idx_t i = 0; i < block_count; i++) {
+			auto idx = block_start + i;
+			auto delta = (uint64_t(values[idx]) - uint64_t(values[idx - 1])) << sign_shift;
+			deltas[i] = int64_t(delta) >> sign_shift;
+			min_delta = MinValue<int64_t>(min_delta, deltas[i]);
+		}
+		// the deltas are stored relative to the minimum delta, using the smallest bit width per miniblock
+		for (idx_t miniblock_idx = 0; miniblock_idx < MINIBLOCKS_PER_BLOCK; miniblock_idx++) {
+			auto miniblock_start = miniblock_idx * VALUES_PER_MINIBLOCK;
+			auto miniblock_end = MinValue<idx_t>(miniblock_start + VALUES_PER_MINIBLOCK, block_count);
+			uint64_t bits = 0;
+			for (idx_t i = miniblock_start; i < miniblock_end; i++) {
+				relative_deltas[i] = (uint64_t(deltas[i]) - uint64_t(min_delta)) & mask;
+				bits |= relative_deltas[i];
+			}
+			uint8_t width = 0;
+			while (width < 64 && (bits >> width) != 0) {
+				width++;
+			}
+			bit_widths[miniblock_idx] = width;
+		}
+
+		// <min delta> <list of bitwidths of miniblocks> <miniblocks>
+		VarintEncode(ZigzagEncode(min_delta), writer);
+		for (idx_t miniblock_idx = 0; miniblock_idx < MINIBLOCKS_PER_BLOCK; miniblock_idx++) {
+			writer.Write<uint8_t>(bit_widths[miniblock_idx]);
+		}
+		for (idx_t miniblock_start = 0; miniblock_start < block_count; miniblock_start += VALUES_PER_MINIBLOCK) {
+			WriteMiniblock(writer, relative_deltas + miniblock_start,
+			               MinValue<idx_t>(VALUES_PER_MINIBLOCK, block_count - miniblock_start),
+			               bit_widths[miniblock_start / VALUES_PER_MINIBLOCK]);
+		}
+	}
+}
+
+void DbpEncoder::WriteMiniblock(Serializer &writer, const uint64_t *values, idx_t count, uint8_t width) {
+	// miniblocks are always padded to the full number of values
+	data_t packed[VALUES_PER_MINIBLOCK * sizeof(uint64_t)];
+	memset(packed, 0, sizeof(packed));
+	idx_t bit_pos = 0;
+	for (idx_t i = 0; i < count; i++) {
+		auto value = values[i];
+		idx_t bits_left = width;
+		while (bits_left > 0) {
+			auto bit_offset = bit_pos % 8;
+			auto bits_now = MinValue<idx_t>(8 - bit_offset, bits_left);
+			packed[bit_pos / 8] |= uint8_t((value & ((uint64_t(1) << bits_now) - 1)) << bit_offset);
+			value >>= bits_now;
+			bits_left -= bits_now;
+			bit_pos += bits_now;
+		}
+	}
+	writer.WriteData(packed, VALUES_PER_MINIBLOCK * width / 8);
+}
+
+//===--------------------------------------------------------------------===//
+// ByteStreamSplit
+//===--------------------------------------------------------------------===//
+static void WriteByteStreamSplit(Serializer &writer, const_data_ptr_t values, idx_t count, idx_t value_width) {
+	// the k-th byte of every value is written to the k-th stream
+	auto streams = unique_ptr<data_t[]>(new data_t[count * value_width]);
+	for (idx_t byte_idx = 0; byte_idx < value_width; byte_idx++) {
+		auto stream = streams.get() + byte_idx * count;
+		for (idx_t i = 0; i < count; i++) {
+			stream[i] = values[i * value_width + byte_idx];
+		}
+	}
+	writer.WriteData(streams.get(), count * value_width);
+}
+
 //===--------------------------------------------------------------------===//
 // ColumnWriter
 //===--------------------------------------------------------------------===//
@@ -263,10 +366,15 @@ public:
 	vector<PageWriteInformation> write_info;
 	unique_ptr<ColumnWriterStatistics> stats_state;
 	idx_t current_page = 0;
+	//! Whether or not we are writing a bloom filter for this column chunk
+	bool write_bloom_filter = false;
+	//! The hashes of all values written to this column chunk (if we are writing a bloom filter)
+	vector<uint64_t> bloom_hashes;
 };
 
 unique_ptr<ColumnWriterState> ColumnWriter::InitializeWriteState(duckdb_parquet::format::RowGroup &row_group) {
 	auto result = make_unique<StandardColumnWriterState>(row_group, row_group.columns.size());
+	result->write_bloom_filter = writer.write_bloom_filter && CanWriteBloomFilter();
 
 	duckdb_parquet::format::ColumnChunk column_chunk;
 	column_chunk.__isset.meta_data = true;
@@ -367,7 +475,7 @@ unique_ptr<ColumnWriterPageState> ColumnWriter::InitializePageState() {
 void ColumnWriter::FlushPageState(Serializer &temp_writer, ColumnWriterPageState *state) {
 }
 
-duckdb_parquet::format::Encoding::type ColumnWriter::GetEncoding() {
+duckdb_parquet::format::Encoding::type ColumnWriter::GetEncoding(ColumnWriterPageState *state) {
 	return Encoding::PLAIN;
 }
 
@@ -392,7 +500,6 @@ void ColumnWriter::BeginWrite(ColumnWriterState &state_p) {
 		hdr.__isset.data_page_header = true;
 
 		hdr.data_page_header.num_values = page_info.row_count;
-		hdr.data_page_header.encoding = GetEncoding();
 		hdr.data_page_header.definition_level_encoding = Encoding::RLE;
 		hdr.data_page_header.repetition_level_encoding = Encoding::RLE;
 
@@ -473,6 +580,8 @@ void ColumnWriter::FlushPage(ColumnWriterState &state_p) {
 	auto &hdr = write_info.page_header;
 
 	FlushPageState(temp_writer, write_info.page_state.get());
+	// the encoding can depend on the contents of the page, so we only know it after flushing the page state
+	hdr.data_page_header.encoding = GetEncoding(write_info.page_state.get());
 
 	// now that we have finished writing the data we know the uncompressed size
 	if (temp_writer.blob.size > idx_t(NumericLimits<int32_t>::Maximum())) {
@@ -508,6 +617,14 @@ idx_t ColumnWriter::GetRowSize(Vector &vector, idx_t index) {
 	throw InternalException("GetRowSize unsupported for struct/list column writers");
 }
 
+bool ColumnWriter::CanWriteBloomFilter() {
+	return false;
+}
+
+void ColumnWriter::HashVector(Vector &input_column, idx_t chunk_start, idx_t chunk_end, vector<uint64_t> &hashes) {
+	throw InternalException("HashVector unsupported for this column writer");
+}
+
 void ColumnWriter::Write(ColumnWriterState &state_p, Vector &vector, idx_t count) {
 	auto &state = (StandardColumnWriterState &)state_p;
 
@@ -524,6 +641,9 @@ void ColumnWriter::Write(ColumnWriterState &state_p, Vector &vector, idx_t count
 
 		WriteVector(temp_writer, state.stats_state.get(), write_info.page_state.get(), vector, offset,
 		            offset + write_count);
+		if (state.write_bloom_filter) {
+			HashVector(vector, offset, offset + write_count, state.bloom_hashes);
+		}
 
 		write_info.write_count += write_count;
 		if (write_info.write_count == write_info.max_write_count) {
@@ -569,6 +689,49 @@ void ColumnWriter::SetParquetStatistics(StandardColumnWriterState &state,
 	}
 }
 
+static void AddEncoding(vector<Encoding::type> &encodings, Encoding::type encoding) {
+	if (std::find(encodings.begin(), encodings.end(), encoding) == encodings.end()) {
+		encodings.push_back(encoding);
+	}
+}
+
+void ColumnWriter::SetParquetEncodings(StandardColumnWriterState &state,
+                                       duckdb_parquet::format::ColumnChunk &column_chunk) {
+	auto &encodings = column_chunk.meta_data.encodings;
+	encodings.clear();
+	for (auto &write_info : state.write_info) {
+		auto &hdr = write_info.page_header;
+		if (hdr.type == PageType::DICTIONARY_PAGE) {
+			AddEncoding(encodings, hdr.dictionary_page_header.encoding);
+		} else {
+			AddEncoding(encodings, hdr.data_page_header.encoding);
+		}
+	}
+	if (!state.repetition_levels.empty() || !state.definition_levels.empty()) {
+		// the repetition and definition levels are always RLE encoded
+		AddEncoding(encodings, Encoding::RLE);
+	}
+}
+
+void ColumnWriter::WriteBloomFilter(StandardColumnWriterState &state,
+                                    duckdb_parquet::format::ColumnChunk &column_chunk) {
+	// size the bloom filter based on the number of distinct hashes in this column chunk
+	auto &hashes = state.bloom_hashes;
+	std::sort(hashes.begin(), hashes.end());
+	hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+
+	ParquetBloomFilter bloom_filter(
+	    ParquetBloomFilter::OptimalNumBytes(hashes.size(), writer.bloom_filter_false_positive_ratio));
+	for (auto &hash : hashes) {
+		bloom_filter.Insert(hash);
+	}
+	hashes.clear();
+
+	column_chunk.meta_data.bloom_filter_offset = writer.writer->GetTotalWritten();
+	column_chunk.meta_data.__isset.bloom_filter_offset = true;
+	bloom_filter.Write(*writer.protocol);
+}
+
 void ColumnWriter::FinalizeWrite(ColumnWriterState &state_p) {
 	auto &state = (StandardColumnWriterState &)state_p;
 	auto &column_chunk = state.row_group.columns[state.col_idx];
@@ -581,6 +744,7 @@ void ColumnWriter::FinalizeWrite(ColumnWriterState &state_p) {
 	// record the start position of the pages for this column
 	column_chunk.meta_data.data_page_offset = writer.writer->GetTotalWritten();
 	SetParquetStatistics(state, column_chunk);
+	SetParquetEncodings(state, column_chunk);
 
 	// write the individual pages to disk
 	for (auto &write_info : state.write_info) {
@@ -590,6 +754,11 @@ void ColumnWriter::FinalizeWrite(ColumnWriterState &state_p) {
 	}
 	column_chunk.meta_data.total_compressed_size =
 	    writer.writer->GetTotalWritten() - column_chunk.meta_data.data_page_offset;
+
+	// the bloom filter (if any) is written directly after the pages of the column chunk
+	if (state.write_bloom_filter && !state.bloom_hashes.empty()) {
+		WriteBloomFilter(state, column_chunk);
+	}
 }
 
 void ColumnWriter::WriteDictionary(ColumnWriterState &state_p, unique_ptr<BufferedSerializer> temp_writer,
@@ -726,6 +895,15 @@ static void TemplatedWritePlain(Vector &col, ColumnWriterStatistics *stats, idx_
 	}
 }
 
+template <class TGT>
+class StandardWriterPageState : public ColumnWriterPageState {
+public:
+	//! The non-null values of the page, these are only encoded once the page is complete
+	vector<TGT> values;
+	//! The encoding that was used to write the page
+	Encoding::type encoding = Encoding::PLAIN;
+};
+
 template <class SRC, class TGT, class OP = ParquetCastOperator>
 class StandardColumnWriter : public ColumnWriter {
 public:
@@ -740,15 +918,88 @@ public:
 		return OP::template InitializeStats<SRC, TGT>();
 	}
 
-	void WriteVector(Serializer &temp_writer, ColumnWriterStatistics *stats, ColumnWriterPageState *page_state,
+	void WriteVector(Serializer &temp_writer, ColumnWriterStatistics *stats, ColumnWriterPageState *page_state_p,
 	                 Vector &input_column, idx_t chunk_start, idx_t chunk_end) override {
 		auto &mask = FlatVector::Validity(input_column);
-		TemplatedWritePlain<SRC, TGT, OP>(input_column, stats, chunk_start, chunk_end, mask, temp_writer);
+		if (!page_state_p) {
+			TemplatedWritePlain<SRC, TGT, OP>(input_column, stats, chunk_start, chunk_end, mask, temp_writer);
+			return;
+		}
+		// the values are encoded when the page is flushed
+		auto &page_state = (StandardWriterPageState<TGT> &)*page_state_p;
+		auto *ptr = FlatVector::GetData<SRC>(input_column);
+		for (idx_t r = chunk_start; r < chunk_end; r++) {
+			if (mask.RowIsValid(r)) {
+				TGT target_value = OP::template Operation<SRC, TGT>(ptr[r]);
+				OP::template HandleStats<SRC, TGT>(stats, ptr[r], target_value);
+				page_state.values.push_back(target_value);
+			}
+		}
+	}
+
+	unique_ptr<ColumnWriterPageState> InitializePageState() override {
+		if (writer.GetParquetVersion() == ParquetVersion::V1) {
+			// pages are written directly using the plain encoding
+			return nullptr;
+		}
+		return make_unique<StandardWriterPageState<TGT>>();
+	}
+
+	void FlushPageState(Serializer &temp_writer, ColumnWriterPageState *state_p) override {
+		if (!state_p) {
+			return;
+		}
+		auto &page_state = (StandardWriterPageState<TGT> &)*state_p;
+		auto &values = page_state.values;
+		auto plain_size = values.size() * sizeof(TGT);
+		if (std::is_floating_point<TGT>::value) {
+			// splitting the bytes of floating point values into separate streams makes them compress a lot better
+			WriteByteStreamSplit(temp_writer, (const_data_ptr_t)values.data(), values.size(), sizeof(TGT));
+			page_state.encoding = Encoding::BYTE_STREAM_SPLIT;
+			return;
+		}
+		// delta encode integers if this makes the page smaller, e.g. for sorted keys or timestamps
+		vector<int64_t> delta_values;
+		delta_values.reserve(values.size());
+		for (auto &value : values) {
+			delta_values.push_back(int64_t(value));
+		}
+		BufferedSerializer delta_writer;
+		DbpEncoder::Write(delta_writer, delta_values.data(), delta_values.size(), sizeof(TGT) * 8);
+		if (delta_writer.blob.size < plain_size) {
+			temp_writer.WriteData(delta_writer.blob.data.get(), delta_writer.blob.size);
+			page_state.encoding = Encoding::DELTA_BINARY_PACKED;
+		} else {
+			temp_writer.WriteData((const_data_ptr_t)values.data(), plain_size);
+			page_state.encoding = Encoding::PLAIN;
+		}
+	}
+
+	duckdb_parquet::format::Encoding::type GetEncoding(ColumnWriterPageState *state_p) override {
+		if (!state_p) {
+			return Encoding::PLAIN;
+		}
+		return ((StandardWriterPageState<TGT> &)*state_p).encoding;
 	}
 
 	idx_t GetRowSize(Vector &vector, idx_t index) override {
 		return sizeof(TGT);
 	}
+
+	bool CanWriteBloomFilter() override {
+		return true;
+	}
+
+	void HashVector(Vector &input_column, idx_t chunk_start, idx_t chunk_end, vector<uint64_t> &hashes) override {
+		auto &mask = FlatVector::Validity(input_column);
+		auto *ptr = FlatVector::GetData<SRC>(input_column);
+		for (idx_t r = chunk_start; r < chunk_end; r++) {
+			if (mask.RowIsValid(r)) {
+				TGT target_value = OP::template Operation<SRC, TGT>(ptr[r]);
+				hashes.push_back(ParquetBloomFilter::Hash((const_data_ptr_t)&target_value, sizeof(TGT)));
+			}
+		}
+	}
 };
 
 //===--------------------------------------------------------------------===//
@@ -1093,6 +1344,14 @@ public:
 	}
 };
 
+class StringWriterPageState : public ColumnWriterPageState {
+public:
+	//! The lengths of the non-null strings of the page
+	vector<int64_t> lengths;
+	//! The concatenated data of the non-null strings of the page
+	BufferedSerializer data;
+};
+
 class StringColumnWriter : public ColumnWriter {
 public:
 	StringColumnWriter(ParquetWriter &writer, idx_t schema_idx, vector<string> schema_path_p, idx_t max_repeat,
@@ -1106,12 +1365,24 @@ public:
 		return make_unique<StringStatisticsState>();
 	}
 
-	void WriteVector(Serializer &temp_writer, ColumnWriterStatistics *stats_p, ColumnWriterPageState *page_state,
+	void WriteVector(Serializer &temp_writer, ColumnWriterStatistics *stats_p, ColumnWriterPageState *page_state_p,
 	                 Vector &input_column, idx_t chunk_start, idx_t chunk_end) override {
 		auto &mask = FlatVector::Validity(input_column);
 		auto &stats = (StringStatisticsState &)*stats_p;
 
 		auto *ptr = FlatVector::GetData<string_t>(input_column);
+		if (page_state_p) {
+			// DELTA_LENGTH_BYTE_ARRAY: the lengths are written up front when the page is flushed
+			auto &page_state = (StringWriterPageState &)*page_state_p;
+			for (idx_t r = chunk_start; r < chunk_end; r++) {
+				if (mask.RowIsValid(r)) {
+					stats.Update(ptr[r]);
+					page_state.lengths.push_back(ptr[r].GetSize());
+					page_state.data.WriteData((const_data_ptr_t)ptr[r].GetDataUnsafe(), ptr[r].GetSize());
+				}
+			}
+			return;
+		}
 		for (idx_t r = chunk_start; r < chunk_end; r++) {
 			if (mask.RowIsValid(r)) {
 				stats.Update(ptr[r]);
@@ -1121,10 +1392,45 @@ public:
 		}
 	}
 
+	unique_ptr<ColumnWriterPageState> InitializePageState() override {
+		if (writer.GetParquetVersion() == ParquetVersion::V1) {
+			// pages are written directly using the plain encoding
+			return nullptr;
+		}
+		return make_unique<StringWriterPageState>();
+	}
+
+	void FlushPageState(Serializer &temp_writer, ColumnWriterPageState *state_p) override {
+		if (!state_p) {
+			return;
+		}
+		auto &page_state = (StringWriterPageState &)*state_p;
+		DbpEncoder::Write(temp_writer, page_state.lengths.data(), page_state.lengths.size(), sizeof(uint32_t) * 8);
+		temp_writer.WriteData(page_state.data.blob.data.get(), page_state.data.blob.size);
+	}
+
+	duckdb_parquet::format::Encoding::type GetEncoding(ColumnWriterPageState *state_p) override {
+		return state_p ? Encoding::DELTA_LENGTH_BYTE_ARRAY : Encoding::PLAIN;
+	}
+
 	idx_t GetRowSize(Vector &vector, idx_t index) override {
 		auto strings = FlatVector::GetData<string_t>(vector);
 		return strings[index].GetSize();
 	}
+
+	bool CanWriteBloomFilter() override {
+		return true;
+	}
+
+	void HashVector(Vector &input_column, idx_t chunk_start, idx_t chunk_end, vector<uint64_t> &hashes) override {
+		auto &mask = FlatVector::Validity(input_column);
+		auto *ptr = FlatVector::GetData<string_t>(input_column);
+		for (idx_t r = chunk_start; r < chunk_end; r++) {
+			if (mask.RowIsValid(r)) {
+				hashes.push_back(ParquetBloomFilter::Hash((const_data_ptr_t)ptr[r].GetDataUnsafe(), ptr[r].GetSize()));
+			}
+		}
+	}
 };
 
 //===--------------------------------------------------------------------===//
@@ -1211,7 +1517,7 @@ public:
 		page_state.encoder.FinishWrite(temp_writer);
 	}
 
-	duckdb_parquet::format::Encoding::type GetEncoding() override {
+	duckdb_parquet::format::Encoding::type GetEncoding(ColumnWriterPageState *state) override {
 		return Encoding::RLE_DICTIONARY;
 	}
 
@@ -86,6 +86,8 @@ protected:
 
 	// applies any skips that were registered using Skip()
 	virtual void ApplyPendingSkips(idx_t num_values);
+	// skips over entire pages that fall within the next num_values rows, returns the amount of rows skipped
+	idx_t SkipPages(idx_t num_values);
 
 	bool HasDefines() {
 		return max_define > 0;
@@ -121,6 +123,9 @@ private:
 	idx_t chunk_read_offset;
 
 	shared_ptr<ResizeableBuffer> block;
+	// the original page data if the values of a page were converted to the plain encoding, the level decoders still
+	// point into it
+	shared_ptr<ResizeableBuffer> encoded_block;
 
 	ResizeableBuffer offset_buffer;
 
@@ -78,7 +78,8 @@ protected:
 	void WriteLevels(Serializer &temp_writer, const vector<uint16_t> &levels, idx_t max_value, idx_t start_offset,
 	                 idx_t count);
 
-	virtual duckdb_parquet::format::Encoding::type GetEncoding();
+	//! Returns the encoding of a page. Called after the page state of the page has been flushed.
+	virtual duckdb_parquet::format::Encoding::type GetEncoding(ColumnWriterPageState *state);
 
 	void NextPage(ColumnWriterState &state_p);
 	void FlushPage(ColumnWriterState &state_p);
@@ -99,10 +100,18 @@ protected:
 	//! Flushes the writer for a specific page. Only used for scalar types.
 	virtual void FlushPageState(Serializer &temp_writer, ColumnWriterPageState *state);
 
+	//! Whether or not a bloom filter can be written for this column. Only used for scalar types.
+	virtual bool CanWriteBloomFilter();
+	//! Hashes the plain encoding of the values of a (subset of a) vector for the bloom filter. Only used for scalar
+	//! types.
+	virtual void HashVector(Vector &input_column, idx_t chunk_start, idx_t chunk_end, vector<uint64_t> &hashes);
+
 	void CompressPage(BufferedSerializer &temp_writer, size_t &compressed_size, data_ptr_t &compressed_data,
 	                  unique_ptr<data_t[]> &compressed_buf);
 
 	void SetParquetStatistics(StandardColumnWriterState &state, duckdb_parquet::format::ColumnChunk &column);
+	void SetParquetEncodings(StandardColumnWriterState &state, duckdb_parquet::format::ColumnChunk &column);
+	void WriteBloomFilter(StandardColumnWriterState &state, duckdb_parquet::format::ColumnChunk &column);
 };
 
 } // namespace duckdb
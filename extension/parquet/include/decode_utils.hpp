@@ -8,25 +8,30 @@ class ParquetDecodeUtils {
 public:
 	template <class T>
 	static T ZigzagToInt(const T n) {
-		return (n >> 1) ^ -(n & 1);
+		// shift as unsigned so that the sign bit of large zigzag-encoded values is not smeared
+		return T(typename std::make_unsigned<T>::type(n) >> 1) ^ -(n & 1);
 	}
 
-	static const uint32_t BITPACK_MASKS[];
+	static const uint64_t BITPACK_MASKS[];
+	static const uint8_t BITPACK_MASKS_SIZE;
 	static const uint8_t BITPACK_DLEN;
 
 	template <typename T>
 	static uint32_t BitUnpack(ByteBuffer &buffer, uint8_t &bitpack_pos, T *dest, uint32_t count, uint8_t width) {
+		if (width >= BITPACK_MASKS_SIZE) {
+			throw std::runtime_error("The width (" + std::to_string(width) + ") of the bitpacked values is too large");
+		}
 		auto mask = BITPACK_MASKS[width];
 
 		for (uint32_t i = 0; i < count; i++) {
-			T val = (buffer.get<uint8_t>() >> bitpack_pos) & mask;
+			uint64_t val = (buffer.get<uint8_t>() >> bitpack_pos) & mask;
 			bitpack_pos += width;
 			while (bitpack_pos > BITPACK_DLEN) {
 				buffer.inc(1);
-				val |= (buffer.get<uint8_t>() << (BITPACK_DLEN - (bitpack_pos - width))) & mask;
+				val |= (uint64_t(buffer.get<uint8_t>()) << (BITPACK_DLEN - (bitpack_pos - width))) & mask;
 				bitpack_pos -= BITPACK_DLEN;
 			}
-			dest[i] = val;
+			dest[i] = T(val);
 		}
 		return count;
 	}
@@ -37,7 +42,7 @@ public:
 		uint8_t shift = 0;
 		while (true) {
 			auto byte = buf.read<uint8_t>();
-			result |= (byte & 127) << shift;
+			result |= T(byte & 127) << shift;
 			if ((byte & 128) == 0)
 				break;
 			shift += 7;
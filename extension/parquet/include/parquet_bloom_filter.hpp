@@ -0,0 +1,64 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// parquet_bloom_filter.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "parquet_types.h"
+#include "thrift/protocol/TProtocol.h"
+
+namespace duckdb {
+
+//! The split block bloom filter (SBBF) as defined by the Parquet format specification. The filter consists of a
+//! number of 256-bit blocks, every inserted hash sets exactly one bit in each of the eight 32-bit words of a block.
+class ParquetBloomFilter {
+public:
+	static constexpr const idx_t BYTES_PER_BLOCK = 32;
+	static constexpr const idx_t WORDS_PER_BLOCK = 8;
+	//! The minimum and maximum size of a bloom filter in bytes
+	static constexpr const idx_t MINIMUM_BYTES = 32;
+	static constexpr const idx_t MAXIMUM_BYTES = 128 * 1024 * 1024;
+	//! The default false positive ratio used when sizing the bloom filter
+	static constexpr const double DEFAULT_FALSE_POSITIVE_RATIO = 0.01;
+
+public:
+	explicit ParquetBloomFilter(idx_t num_bytes);
+
+	//! Returns the optimal size of the bloom filter (in bytes) for the given distinct count and false positive ratio
+	static idx_t OptimalNumBytes(idx_t distinct_count, double false_positive_ratio);
+
+	//! Hash a plain-encoded value using the hash function required by the specification (XXH64, seed 0)
+	static uint64_t Hash(const_data_ptr_t data, idx_t size);
+	//! Hash a constant using the plain encoding of the column it is compared against. Returns false if the value
+	//! cannot be converted to the physical representation used in the file.
+	static bool HashConstant(const LogicalType &type, const duckdb_parquet::format::SchemaElement &schema,
+	                         const Value &constant, uint64_t &result);
+
+	void Insert(uint64_t hash);
+	bool FindHash(uint64_t hash) const;
+
+	idx_t Size() const {
+		return num_bytes;
+	}
+	const_data_ptr_t Data() const {
+		return (const_data_ptr_t)blocks.get();
+	}
+
+	//! Writes the BloomFilterHeader followed by the bitset
+	void Write(duckdb_apache::thrift::protocol::TProtocol &oprot) const;
+	//! Reads a bloom filter from the current position of the protocol. Returns nullptr if the filter uses an
+	//! algorithm, hash or compression that we do not support.
+	static unique_ptr<ParquetBloomFilter> Read(duckdb_apache::thrift::protocol::TProtocol &iprot);
+
+private:
+	idx_t num_bytes;
+	idx_t num_blocks;
+	unique_ptr<uint32_t[]> blocks;
+};
+
+} // namespace duckdb
@@ -26,7 +26,21 @@ public:
 		is_first_value = true;
 	};
 
+	idx_t TotalValues() const {
+		return total_value_count;
+	}
+
+	int64_t StartValue() const {
+		return start_value;
+	}
+
 	ByteBuffer BufferPtr() {
+		if (values_left_in_miniblock > 0) {
+			// the last miniblock is padded to the full miniblock size, which is always a multiple of 8 bits
+			buffer_.inc((bitpack_pos + values_left_in_miniblock * miniblock_bit_widths[miniblock_offset]) / 8);
+			values_left_in_miniblock = 0;
+			bitpack_pos = 0;
+		}
 		if (bitpack_pos != 0) {
 			buffer_.inc(1);
 			bitpack_pos = 0;
@@ -80,7 +94,9 @@ public:
 			ParquetDecodeUtils::BitUnpack<T>(buffer_, bitpack_pos, &values[value_offset], read_now,
 			                                 miniblock_bit_widths[miniblock_offset]);
 			for (idx_t i = value_offset; i < value_offset + read_now; i++) {
-				values[i] = ((i == 0) ? start_value : values[i - 1]) + min_delta + values[i];
+				// deltas wrap around at the width of the physical type: add them as unsigned values
+				auto previous_value = (i == 0) ? uint64_t(start_value) : uint64_t(values[i - 1]);
+				values[i] = T(previous_value + uint64_t(min_delta) + uint64_t(values[i]));
 			}
 			value_offset += read_now;
 			values_left_in_miniblock -= read_now;
@@ -0,0 +1,33 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// parquet_dbp_encoder.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "parquet_types.h"
+#include "thrift_tools.hpp"
+#include "resizable_buffer.hpp"
+
+namespace duckdb {
+
+//! Encoder for the DELTA_BINARY_PACKED encoding: values are stored as blocks of bit-packed deltas
+class DbpEncoder {
+public:
+	static constexpr const idx_t BLOCK_SIZE = 128;
+	static constexpr const idx_t MINIBLOCKS_PER_BLOCK = 4;
+	static constexpr const idx_t VALUES_PER_MINIBLOCK = BLOCK_SIZE / MINIBLOCKS_PER_BLOCK;
+
+public:
+	//! Writes the values using the DELTA_BINARY_PACKED encoding. Only the lower bit_width bits (32 or 64, the width of
+	//! the physical type) of the values are encoded: deltas wrap around just like they do for the reader.
+	static void Write(Serializer &writer, const int64_t *values, idx_t count, idx_t bit_width);
+
+private:
+	static void WriteMiniblock(Serializer &writer, const uint64_t *values, idx_t count, uint8_t width);
+};
+
+} // namespace duckdb
@@ -22,4 +22,9 @@ public:
 	ParquetSchemaFunction();
 };
 
+class ParquetScanStatisticsFunction : public TableFunction {
+public:
+	ParquetScanStatisticsFunction();
+};
+
 } // namespace duckdb
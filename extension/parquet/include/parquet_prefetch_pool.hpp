@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// parquet_prefetch_pool.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#ifndef DUCKDB_AMALGAMATION
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#endif
+#include <condition_variable>
+#include <deque>
+#include <functional>
+
+namespace duckdb {
+
+//! Pool of threads that issue the concurrent reads of remote file prefetches. The pool is kept in the object cache of
+//! the database, so the threads are shared by all Parquet scans of the database and are joined when it is closed.
+//! Threads are started on demand and are reused by all later prefetches.
+class ParquetPrefetchPool : public ObjectCacheEntry {
+public:
+	~ParquetPrefetchPool() override;
+
+	//! Runs the task on a pool thread, starting a new thread if none is idle and fewer than max_threads exist
+	void Schedule(std::function<void()> task, idx_t max_threads);
+
+public:
+	static string ObjectType() {
+		return "parquet_prefetch_pool";
+	}
+
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+	//! Returns the pool of the database, creating it if it does not exist yet
+	static shared_ptr<ParquetPrefetchPool> Get(ClientContext &context) {
+		static mutex create_lock;
+		lock_guard<mutex> guard(create_lock);
+		auto &cache = ObjectCache::GetObjectCache(context);
+		auto pool = cache.Get<ParquetPrefetchPool>(ObjectType());
+		if (!pool) {
+			pool = make_shared<ParquetPrefetchPool>();
+			cache.Put(ObjectType(), pool);
+		}
+		return pool;
+	}
+
+private:
+	void WorkerLoop();
+
+	mutex lock;
+	std::condition_variable task_available;
+	std::deque<std::function<void()>> tasks;
+	vector<thread> threads;
+	idx_t idle_threads = 0;
+	bool shutdown = false;
+};
+
+} // namespace duckdb
@@ -18,6 +18,8 @@
 #include "column_reader.hpp"
 #include "parquet_file_metadata_cache.hpp"
 #include "parquet_rle_bp_decoder.hpp"
+#include "parquet_prefetch_pool.hpp"
+#include "parquet_scan_statistics.hpp"
 #include "parquet_types.h"
 #include "resizable_buffer.hpp"
 
@@ -35,6 +37,7 @@ class ClientContext;
 class ChunkCollection;
 class BaseStatistics;
 class TableFilterSet;
+class TableFilter;
 
 struct ParquetReaderPrefetchConfig {
 	// Percentage of data in a row group span that should be scanned for enabling whole group prefetch
@@ -98,6 +101,10 @@ public:
 	vector<string> names;
 	shared_ptr<ParquetFileMetadataCache> metadata;
 	ParquetOptions parquet_options;
+	//! The row group counters of the database (if the reader was created for a client)
+	shared_ptr<ParquetScanStatistics> scan_statistics;
+	//! The threads that issue the concurrent reads of remote files (if the reader was created for a client)
+	shared_ptr<ParquetPrefetchPool> prefetch_pool;
 
 public:
 	void InitializeScan(ParquetReaderScanState &state, vector<column_t> column_ids, vector<idx_t> groups_to_read,
@@ -128,6 +135,9 @@ private:
 	// Group span is the distance between the min page offset and the max page offset plus the max page compressed size
 	uint64_t GetGroupSpan(ParquetReaderScanState &state);
 	void PrepareRowGroupBuffer(ParquetReaderScanState &state, idx_t out_col_idx);
+	//! Whether the bloom filter of the column chunk (if any) shows that the table filter can never be satisfied
+	bool BloomFilterExcludes(ParquetReaderScanState &state, ColumnReader &column_reader,
+	                         const duckdb_parquet::format::RowGroup &group, TableFilter &filter);
 	LogicalType DeriveLogicalType(const SchemaElement &s_ele);
 
 	template <typename... Args>
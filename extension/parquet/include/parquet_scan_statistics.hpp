@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// parquet_scan_statistics.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "duckdb.hpp"
+#ifndef DUCKDB_AMALGAMATION
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#endif
+
+namespace duckdb {
+
+//! ParquetScanStatistics counts the row groups that the Parquet scans of a database read or skip. It is kept in the
+//! object cache of the database, and can be queried with parquet_scan_statistics()
+class ParquetScanStatistics : public ObjectCacheEntry {
+public:
+	ParquetScanStatistics()
+	    : row_groups_read(0), row_groups_pruned_by_statistics(0), row_groups_pruned_by_bloom_filter(0) {
+	}
+	~ParquetScanStatistics() override = default;
+
+	//! The row groups that were read
+	atomic<idx_t> row_groups_read;
+	//! The row groups that were skipped because their min/max statistics rule out the filters
+	atomic<idx_t> row_groups_pruned_by_statistics;
+	//! The row groups that were skipped because a bloom filter rules out the filters
+	atomic<idx_t> row_groups_pruned_by_bloom_filter;
+
+public:
+	static string ObjectType() {
+		return "parquet_scan_statistics";
+	}
+
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+	//! Returns the statistics of the database, creating them if they do not exist yet
+	static shared_ptr<ParquetScanStatistics> Get(ClientContext &context) {
+		static mutex create_lock;
+		lock_guard<mutex> guard(create_lock);
+		auto &cache = ObjectCache::GetObjectCache(context);
+		auto statistics = cache.Get<ParquetScanStatistics>(ObjectType());
+		if (!statistics) {
+			statistics = make_shared<ParquetScanStatistics>();
+			cache.Put(ObjectType(), statistics);
+		}
+		return statistics;
+	}
+};
+
+} // namespace duckdb
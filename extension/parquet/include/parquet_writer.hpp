@@ -25,6 +25,10 @@ namespace duckdb {
 class FileSystem;
 class FileOpener;
 
+//! The version of the format the writer targets. V2 enables the encodings introduced by version 2 of the format
+//! (DELTA_BINARY_PACKED, DELTA_LENGTH_BYTE_ARRAY and BYTE_STREAM_SPLIT), which older readers might not support.
+enum class ParquetVersion : uint8_t { V1 = 1, V2 = 2 };
+
 class ParquetWriter {
 	friend class ColumnWriter;
 	friend class ListColumnWriter;
@@ -32,7 +36,8 @@ class ParquetWriter {
 
 public:
 	ParquetWriter(FileSystem &fs, string file_name, FileOpener *file_opener, vector<LogicalType> types,
-	              vector<string> names, duckdb_parquet::format::CompressionCodec::type codec);
+	              vector<string> names, duckdb_parquet::format::CompressionCodec::type codec,
+	              bool write_bloom_filter, double bloom_filter_false_positive_ratio, ParquetVersion parquet_version);
 
 public:
 	void Flush(ChunkCollection &buffer);
@@ -41,11 +46,21 @@ public:
 	static duckdb_parquet::format::Type::type DuckDBTypeToParquetType(const LogicalType &duckdb_type);
 	static void SetSchemaProperties(const LogicalType &duckdb_type, duckdb_parquet::format::SchemaElement &schema_ele);
 
+	ParquetVersion GetParquetVersion() const {
+		return parquet_version;
+	}
+
 private:
 	string file_name;
 	vector<LogicalType> sql_types;
 	vector<string> column_names;
 	duckdb_parquet::format::CompressionCodec::type codec;
+	//! Whether or not to write a bloom filter for every (eligible) column chunk
+	bool write_bloom_filter;
+	//! The false positive ratio the bloom filters are sized for
+	double bloom_filter_false_positive_ratio;
+	//! The version of the format to write
+	ParquetVersion parquet_version;
 
 	unique_ptr<BufferedFileWriter> writer;
 	shared_ptr<duckdb_apache::thrift::protocol::TProtocol> protocol;
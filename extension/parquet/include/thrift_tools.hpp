@@ -7,7 +7,13 @@
 #ifndef DUCKDB_AMALGAMATION
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/allocator.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/file_opener.hpp"
 #endif
+#include "parquet_prefetch_pool.hpp"
+#include <condition_variable>
+#include <exception>
 
 namespace duckdb {
 
@@ -51,8 +57,12 @@ struct ReadHeadComparator {
 // 1: register all ranges that will be read, merging ranges that are consecutive
 // 2: prefetch all registered ranges
 struct ReadAheadBuffer {
-	ReadAheadBuffer(Allocator &allocator, FileHandle &handle, FileOpener &opener)
-	    : allocator(allocator), handle(handle), file_opener(opener) {
+	// Remote files are prefetched with multiple concurrent reads, each of at least this size
+	static constexpr idx_t MIN_CONCURRENT_READ_SIZE = 1 << 20; // 1 MiB
+	static constexpr idx_t DEFAULT_MAX_CONCURRENT_READS = 8;
+
+	ReadAheadBuffer(Allocator &allocator, FileHandle &handle, FileOpener &opener, ParquetPrefetchPool *prefetch_pool)
+	    : allocator(allocator), handle(handle), file_opener(opener), prefetch_pool(prefetch_pool) {
 	}
 
 	// The list of read heads
@@ -63,6 +73,8 @@ struct ReadAheadBuffer {
 	Allocator &allocator;
 	FileHandle &handle;
 	FileOpener &file_opener;
+	// The pool that issues the concurrent reads of remote files, reads are not concurrent without a pool
+	ParquetPrefetchPool *prefetch_pool;
 
 	idx_t total_size = 0;
 
@@ -105,16 +117,119 @@ struct ReadAheadBuffer {
 		return nullptr;
 	}
 
+	// The maximum number of reads that are in flight at the same time when prefetching a remote file
+	idx_t MaxConcurrentReads() {
+		if (handle.OnDiskFile() || !prefetch_pool) {
+			return 1;
+		}
+		Value result;
+		if (file_opener.TryGetCurrentSetting("parquet_max_concurrent_reads", result)) {
+			return MaxValue<idx_t>(result.GetValue<uint64_t>(), 1);
+		}
+		return DEFAULT_MAX_CONCURRENT_READS;
+	}
+
+	// A part of a read head that is read on its own when prefetching a remote file
+	struct PrefetchRead {
+		data_ptr_t buffer;
+		idx_t location;
+		idx_t size;
+	};
+
+	// The reads of a prefetch that are shared between the prefetching thread and the pool threads. Pool threads may
+	// only pick up their task once the prefetch is done, the state is shared so that they then find no reads left.
+	struct ConcurrentPrefetch {
+		ConcurrentPrefetch(FileHandle &handle, vector<PrefetchRead> reads_p)
+		    : handle(handle), reads(move(reads_p)), next_read(0) {
+		}
+
+		FileHandle &handle;
+		vector<PrefetchRead> reads;
+		atomic<idx_t> next_read;
+
+		mutex lock;
+		std::condition_variable reads_finished;
+		idx_t finished_reads = 0;
+		std::exception_ptr error;
+
+		// Takes the next read until all reads are taken, reads are skipped once one of them failed
+		void Run() {
+			for (idx_t read_idx = next_read++; read_idx < reads.size(); read_idx = next_read++) {
+				std::exception_ptr read_error;
+				if (!HasError()) {
+					auto &read = reads[read_idx];
+					try {
+						handle.Read(read.buffer, read.size, read.location);
+					} catch (...) {
+						read_error = std::current_exception();
+					}
+				}
+				lock_guard<mutex> guard(lock);
+				if (read_error && !error) {
+					error = read_error;
+				}
+				if (++finished_reads == reads.size()) {
+					reads_finished.notify_all();
+				}
+			}
+		}
+
+		bool HasError() {
+			lock_guard<mutex> guard(lock);
+			return error != nullptr;
+		}
+
+		// Waits until every read is finished and rethrows the first error
+		void Wait() {
+			std::unique_lock<mutex> guard(lock);
+			reads_finished.wait(guard, [&]() { return finished_reads == reads.size(); });
+			if (error) {
+				std::rethrow_exception(error);
+			}
+		}
+	};
+
 	// Prefetch all read heads
 	void Prefetch() {
+		// A prefetch of a remote file is bound by the latency of the requests rather than by the bandwidth: the read
+		// heads are split into parts that are read concurrently
+		auto max_concurrent_reads = MaxConcurrentReads();
+		idx_t prefetch_size = 0;
+		for (auto &read_head : read_heads) {
+			prefetch_size += read_head.size;
+		}
+		idx_t min_read_size = MIN_CONCURRENT_READ_SIZE;
+		auto read_size = MaxValue<idx_t>(min_read_size, prefetch_size / max_concurrent_reads + 1);
+
+		vector<PrefetchRead> reads;
 		for (auto &read_head : read_heads) {
 			read_head.Allocate(allocator);
 
 			if (read_head.GetEnd() > handle.GetFileSize()) {
 				throw std::runtime_error("Prefetch registered requested for bytes outside file");
 			}
+			for (idx_t offset = 0; offset < read_head.size; offset += read_size) {
+				auto size = MinValue<idx_t>(read_size, read_head.size - offset);
+				reads.push_back(PrefetchRead {read_head.data->get() + offset, read_head.location + offset, size});
+			}
+		}
 
-			handle.Read(read_head.data->get(), read_head.size, read_head.location);
+		if (max_concurrent_reads <= 1 || reads.size() <= 1) {
+			for (auto &read : reads) {
+				handle.Read(read.buffer, read.size, read.location);
+			}
+		} else {
+			// the pool threads and the current thread take the reads until all of them are done
+			auto helper_count = MinValue<idx_t>(max_concurrent_reads, reads.size()) - 1;
+			auto prefetch = make_shared<ConcurrentPrefetch>(handle, move(reads));
+			for (idx_t helper_idx = 0; helper_idx < helper_count; helper_idx++) {
+				prefetch_pool->Schedule([prefetch]() { prefetch->Run(); }, max_concurrent_reads - 1);
+			}
+			prefetch->Run();
+			prefetch->Wait();
+		}
+
+		for (auto &read_head : read_heads) {
 			read_head.data_isset = true;
 		}
 	}
@@ -124,9 +239,10 @@ class ThriftFileTransport : public duckdb_apache::thrift::transport::TVirtualTra
 public:
 	static constexpr uint64_t PREFETCH_FALLBACK_BUFFERSIZE = 1000000;
 
-	ThriftFileTransport(Allocator &allocator, FileHandle &handle_p, FileOpener &opener, bool prefetch_mode_p)
-	    : handle(handle_p), location(0), allocator(allocator), ra_buffer(ReadAheadBuffer(allocator, handle_p, opener)),
-	      prefetch_mode(prefetch_mode_p) {
+	ThriftFileTransport(Allocator &allocator, FileHandle &handle_p, FileOpener &opener, bool prefetch_mode_p,
+	                    ParquetPrefetchPool *prefetch_pool)
+	    : handle(handle_p), location(0), allocator(allocator),
+	      ra_buffer(ReadAheadBuffer(allocator, handle_p, opener, prefetch_pool)), prefetch_mode(prefetch_mode_p) {
 	}
 
 	uint32_t read(uint8_t *buf, uint32_t len) {
@@ -8,6 +8,7 @@
 #include "parquet-extension.hpp"
 #include "parquet_reader.hpp"
 #include "parquet_writer.hpp"
+#include "parquet_bloom_filter.hpp"
 #include "parquet_metadata.hpp"
 #include "zstd_file_system.hpp"
 
@@ -360,6 +361,9 @@ struct ParquetWriteBindData : public TableFunctionData {
 	vector<string> column_names;
 	duckdb_parquet::format::CompressionCodec::type codec = duckdb_parquet::format::CompressionCodec::SNAPPY;
 	idx_t row_group_size = 100000;
+	bool write_bloom_filter = false;
+	double bloom_filter_false_positive_ratio = ParquetBloomFilter::DEFAULT_FALSE_POSITIVE_RATIO;
+	ParquetVersion parquet_version = ParquetVersion::V1;
 };
 
 struct ParquetWriteGlobalState : public GlobalFunctionData {
@@ -399,6 +403,30 @@ unique_ptr<FunctionData> ParquetWriteBind(ClientContext &context, CopyInfo &info
 				}
 			}
 			throw ParserException("Expected %s argument to be either [uncompressed, snappy, gzip or zstd]", loption);
+		} else if (loption == "bloom_filter") {
+			bind_data->write_bloom_filter =
+			    option.second.empty() || BooleanValue::Get(option.second[0].CastAs(LogicalType::BOOLEAN));
+		} else if (loption == "bloom_filter_false_positive_ratio") {
+			if (option.second.empty()) {
+				throw ParserException("Expected %s argument to be a number between 0 and 1", loption);
+			}
+			auto ratio = option.second[0].GetValue<double>();
+			if (!(ratio > 0 && ratio < 1)) {
+				throw ParserException("Expected %s argument to be a number between 0 and 1", loption);
+			}
+			bind_data->bloom_filter_false_positive_ratio = ratio;
+		} else if (loption == "parquet_version") {
+			if (!option.second.empty()) {
+				auto roption = StringUtil::Lower(option.second[0].ToString());
+				if (roption == "v1") {
+					bind_data->parquet_version = ParquetVersion::V1;
+					continue;
+				} else if (roption == "v2") {
+					bind_data->parquet_version = ParquetVersion::V2;
+					continue;
+				}
+			}
+			throw ParserException("Expected %s argument to be either [v1 or v2]", loption);
 		} else {
 			throw NotImplementedException("Unrecognized option for PARQUET: %s", option.first.c_str());
 		}
@@ -417,7 +445,8 @@ unique_ptr<GlobalFunctionData> ParquetWriteInitializeGlobal(ClientContext &conte
 	auto &fs = FileSystem::GetFileSystem(context);
 	global_state->writer =
 	    make_unique<ParquetWriter>(fs, file_path, FileSystem::GetFileOpener(context), parquet_bind.sql_types,
-	                               parquet_bind.column_names, parquet_bind.codec);
+	                               parquet_bind.column_names, parquet_bind.codec, parquet_bind.write_bloom_filter,
+	                               parquet_bind.bloom_filter_false_positive_ratio, parquet_bind.parquet_version);
 	return move(global_state);
 }
 
@@ -483,6 +512,9 @@ void ParquetExtension::Load(DuckDB &db) {
 	ParquetSchemaFunction schema_fun;
 	CreateTableFunctionInfo schema_cinfo(schema_fun);
 
+	ParquetScanStatisticsFunction scan_statistics_fun;
+	CreateTableFunctionInfo scan_statistics_cinfo(scan_statistics_fun);
+
 	CopyFunction function("parquet");
 	function.copy_to_bind = ParquetWriteBind;
 	function.copy_to_initialize_global = ParquetWriteInitializeGlobal;
@@ -505,12 +537,17 @@ void ParquetExtension::Load(DuckDB &db) {
 	catalog.CreateTableFunction(context, &pq_scan);
 	catalog.CreateTableFunction(context, &meta_cinfo);
 	catalog.CreateTableFunction(context, &schema_cinfo);
+	catalog.CreateTableFunction(context, &scan_statistics_cinfo);
 	con.Commit();
 
 	auto &config = DBConfig::GetConfig(*db.instance);
 	config.replacement_scans.emplace_back(ParquetScanReplacement);
 	config.AddExtensionOption("binary_as_string", "In Parquet files, interpret binary data as a string.",
 	                          LogicalType::BOOLEAN);
+	config.AddExtensionOption("parquet_max_concurrent_reads",
+	                          "Maximum number of concurrent range requests when prefetching remote Parquet files, the "
+	                          "threads that issue them are shared by all scans of the database (default 8)",
+	                          LogicalType::UBIGINT);
 }
 
 std::string ParquetExtension::Name() {
@@ -0,0 +1,254 @@
+#include "parquet_bloom_filter.hpp"
+
+#include "zstd/common/xxhash.h"
+
+#include <cmath>
+
+namespace duckdb {
+
+using duckdb_apache::thrift::protocol::TProtocol;
+using duckdb_apache::thrift::protocol::TType;
+using duckdb_parquet::format::ConvertedType;
+using duckdb_parquet::format::Type;
+
+static constexpr const uint32_t PARQUET_BLOOM_SALT[ParquetBloomFilter::WORDS_PER_BLOCK] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+ParquetBloomFilter::ParquetBloomFilter(idx_t num_bytes_p) : num_bytes(num_bytes_p) {
+	D_ASSERT(num_bytes >= MINIMUM_BYTES && num_bytes % BYTES_PER_BLOCK == 0);
+	num_blocks = num_bytes / BYTES_PER_BLOCK;
+	blocks = unique_ptr<uint32_t[]>(new uint32_t[num_blocks * WORDS_PER_BLOCK]);
+	memset(blocks.get(), 0, num_bytes);
+}
+
+idx_t ParquetBloomFilter::OptimalNumBytes(idx_t distinct_count, double false_positive_ratio) {
+	D_ASSERT(false_positive_ratio > 0 && false_positive_ratio < 1);
+	// the number of bits required for the requested false positive ratio of a split block bloom filter
+	double num_bits = -8.0 * double(distinct_count) / std::log(1 - std::pow(false_positive_ratio, 1.0 / 8));
+	idx_t required_bytes = idx_t(num_bits / 8);
+	// round up to the next power of two within [MINIMUM_BYTES, MAXIMUM_BYTES]
+	idx_t result = MINIMUM_BYTES;
+	while (result < required_bytes && result < MAXIMUM_BYTES) {
+		result *= 2;
+	}
+	return result;
+}
+
+uint64_t ParquetBloomFilter::Hash(const_data_ptr_t data, idx_t size) {
+	return duckdb_zstd::XXH64(data, size, 0);
+}
+
+template <class SRC, class TGT>
+static uint64_t HashPlainValue(const Value &constant) {
+	TGT plain_value = TGT(constant.GetValueUnsafe<SRC>());
+	return ParquetBloomFilter::Hash((const_data_ptr_t)&plain_value, sizeof(TGT));
+}
+
+bool ParquetBloomFilter::HashConstant(const LogicalType &type, const duckdb_parquet::format::SchemaElement &schema,
+                                      const Value &constant, uint64_t &result) {
+	if (constant.IsNull() || constant.type() != type) {
+		return false;
+	}
+	switch (schema.type) {
+	case Type::INT32:
+		switch (type.id()) {
+		case LogicalTypeId::TINYINT:
+			result = HashPlainValue<int8_t, int32_t>(constant);
+			return true;
+		case LogicalTypeId::SMALLINT:
+			result = HashPlainValue<int16_t, int32_t>(constant);
+			return true;
+		case LogicalTypeId::INTEGER:
+			result = HashPlainValue<int32_t, int32_t>(constant);
+			return true;
+		case LogicalTypeId::UTINYINT:
+			result = HashPlainValue<uint8_t, int32_t>(constant);
+			return true;
+		case LogicalTypeId::USMALLINT:
+			result = HashPlainValue<uint16_t, int32_t>(constant);
+			return true;
+		case LogicalTypeId::UINTEGER:
+			result = HashPlainValue<uint32_t, int32_t>(constant);
+			return true;
+		case LogicalTypeId::DATE:
+			result = HashPlainValue<int32_t, int32_t>(constant);
+			return true;
+		default:
+			return false;
+		}
+	case Type::INT64:
+		switch (type.id()) {
+		case LogicalTypeId::BIGINT:
+			result = HashPlainValue<int64_t, int64_t>(constant);
+			return true;
+		case LogicalTypeId::UBIGINT:
+			result = HashPlainValue<uint64_t, int64_t>(constant);
+			return true;
+		case LogicalTypeId::TIMESTAMP:
+		case LogicalTypeId::TIMESTAMP_TZ:
+			// only timestamps that are stored in microseconds have the same representation as ours
+			if (!schema.__isset.converted_type || schema.converted_type != ConvertedType::TIMESTAMP_MICROS) {
+				return false;
+			}
+			result = HashPlainValue<int64_t, int64_t>(constant);
+			return true;
+		default:
+			return false;
+		}
+	case Type::FLOAT:
+	case Type::DOUBLE: {
+		if (type.id() != LogicalTypeId::FLOAT && type.id() != LogicalTypeId::DOUBLE) {
+			return false;
+		}
+		auto value = constant.GetValue<double>();
+		if (value == 0 || std::isnan(value)) {
+			// -0.0 and 0.0 (and all NaNs) compare equal but are hashed differently: we cannot use the filter here
+			return false;
+		}
+		if (schema.type == Type::FLOAT) {
+			if (type.id() != LogicalTypeId::FLOAT) {
+				return false;
+			}
+			result = HashPlainValue<float, float>(constant);
+		} else {
+			if (type.id() != LogicalTypeId::DOUBLE) {
+				return false;
+			}
+			result = HashPlainValue<double, double>(constant);
+		}
+		return true;
+	}
+	case Type::BYTE_ARRAY: {
+		if (type.id() != LogicalTypeId::VARCHAR && type.id() != LogicalTypeId::BLOB) {
+			return false;
+		}
+		auto &str = StringValue::Get(constant);
+		result = Hash((const_data_ptr_t)str.c_str(), str.size());
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+void ParquetBloomFilter::Insert(uint64_t hash) {
+	auto block_idx = ((hash >> 32) * num_blocks) >> 32;
+	auto key = uint32_t(hash);
+	auto block = blocks.get() + block_idx * WORDS_PER_BLOCK;
+	for (idx_t i = 0; i < WORDS_PER_BLOCK; i++) {
+		block[i] |= uint32_t(1) << ((key * PARQUET_BLOOM_SALT[i]) >> 27);
+	}
+}
+
+bool ParquetBloomFilter::FindHash(uint64_t hash) const {
+	auto block_idx = ((hash >> 32) * num_blocks) >> 32;
+	auto key = uint32_t(hash);
+	auto block = blocks.get() + block_idx * WORDS_PER_BLOCK;
+	for (idx_t i = 0; i < WORDS_PER_BLOCK; i++) {
+		if (!(block[i] & (uint32_t(1) << ((key * PARQUET_BLOOM_SALT[i]) >> 27)))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//===--------------------------------------------------------------------===//
+// BloomFilterHeader (de)serialization
+//===--------------------------------------------------------------------===//
+// The header is a thrift struct of the form
+// struct BloomFilterHeader {
+//   1: required i32 numBytes;
+//   2: required BloomFilterAlgorithm algorithm;     (union, 1: SplitBlockAlgorithm BLOCK)
+//   3: required BloomFilterHash hash;               (union, 1: XxHash XXHASH)
+//   4: required BloomFilterCompression compression; (union, 1: Uncompressed UNCOMPRESSED)
+// }
+// the generated thrift code we ship predates bloom filters, so we (de)serialize it by hand here
+static void WriteEmptyUnion(TProtocol &oprot, const char *union_name, const char *field_name, int16_t field_id) {
+	oprot.writeFieldBegin(union_name, duckdb_apache::thrift::protocol::T_STRUCT, field_id);
+	oprot.writeStructBegin(union_name);
+	oprot.writeFieldBegin(field_name, duckdb_apache::thrift::protocol::T_STRUCT, 1);
+	oprot.writeStructBegin(field_name);
+	oprot.writeFieldStop();
+	oprot.writeStructEnd();
+	oprot.writeFieldEnd();
+	oprot.writeFieldStop();
+	oprot.writeStructEnd();
+	oprot.writeFieldEnd();
+}
+
+void ParquetBloomFilter::Write(TProtocol &oprot) const {
+	oprot.writeStructBegin("BloomFilterHeader");
+	oprot.writeFieldBegin("numBytes", duckdb_apache::thrift::protocol::T_I32, 1);
+	oprot.writeI32(int32_t(num_bytes));
+	oprot.writeFieldEnd();
+	WriteEmptyUnion(oprot, "algorithm", "BLOCK", 2);
+	WriteEmptyUnion(oprot, "hash", "XXHASH", 3);
+	WriteEmptyUnion(oprot, "compression", "UNCOMPRESSED", 4);
+	oprot.writeFieldStop();
+	oprot.writeStructEnd();
+
+	// the bitset directly follows the header
+	oprot.getTransport()->write(Data(), num_bytes);
+}
+
+//! Reads a union and returns the id of the field that is set
+static int16_t ReadUnion(TProtocol &iprot) {
+	string name;
+	TType ftype;
+	int16_t fid;
+	int16_t result = -1;
+	iprot.readStructBegin(name);
+	while (true) {
+		iprot.readFieldBegin(name, ftype, fid);
+		if (ftype == duckdb_apache::thrift::protocol::T_STOP) {
+			break;
+		}
+		result = fid;
+		iprot.skip(ftype);
+		iprot.readFieldEnd();
+	}
+	iprot.readStructEnd();
+	return result;
+}
+
+unique_ptr<ParquetBloomFilter> ParquetBloomFilter::Read(TProtocol &iprot) {
+	string name;
+	TType ftype;
+	int16_t fid;
+	int32_t header_num_bytes = -1;
+	int16_t algorithm = -1, hash = -1, compression = -1;
+	iprot.readStructBegin(name);
+	while (true) {
+		iprot.readFieldBegin(name, ftype, fid);
+		if (ftype == duckdb_apache::thrift::protocol::T_STOP) {
+			break;
+		}
+		if (fid == 1 && ftype == duckdb_apache::thrift::protocol::T_I32) {
+			iprot.readI32(header_num_bytes);
+		} else if (fid == 2 && ftype == duckdb_apache::thrift::protocol::T_STRUCT) {
+			algorithm = ReadUnion(iprot);
+		} else if (fid == 3 && ftype == duckdb_apache::thrift::protocol::T_STRUCT) {
+			hash = ReadUnion(iprot);
+		} else if (fid == 4 && ftype == duckdb_apache::thrift::protocol::T_STRUCT) {
+			compression = ReadUnion(iprot);
+		} else {
+			iprot.skip(ftype);
+		}
+		iprot.readFieldEnd();
+	}
+	iprot.readStructEnd();
+
+	if (algorithm != 1 || hash != 1 || compression != 1) {
+		// not a split block bloom filter using xxhash without compression: we cannot use it
+		return nullptr;
+	}
+	if (header_num_bytes < int32_t(MINIMUM_BYTES) || header_num_bytes > int32_t(MAXIMUM_BYTES) ||
+	    header_num_bytes % BYTES_PER_BLOCK != 0) {
+		return nullptr;
+	}
+	auto result = make_unique<ParquetBloomFilter>(header_num_bytes);
+	iprot.getTransport()->readAll((uint8_t *)result->blocks.get(), header_num_bytes);
+	return result;
+}
+
+} // namespace duckdb
@@ -115,6 +115,9 @@ void ParquetMetaDataOperatorData::BindMetaData(vector<LogicalType> &return_types
 
 	names.emplace_back("total_uncompressed_size");
 	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("bloom_filter_offset");
+	return_types.emplace_back(LogicalType::BIGINT);
 }
 
 Value ConvertParquetStats(const LogicalType &type, const duckdb_parquet::format::SchemaElement &schema_ele,
@@ -238,6 +241,11 @@ void ParquetMetaDataOperatorData::LoadFileMetaData(ClientContext &context, const
 			// total_uncompressed_size, LogicalType::BIGINT
 			current_chunk.SetValue(22, count, Value::BIGINT(col_meta.total_uncompressed_size));
 
+			// bloom_filter_offset, LogicalType::BIGINT
+			current_chunk.SetValue(23, count,
+			                       col_meta.__isset.bloom_filter_offset ? Value::BIGINT(col_meta.bloom_filter_offset)
+			                                                            : Value(LogicalType::BIGINT));
+
 			count++;
 			if (count >= STANDARD_VECTOR_SIZE) {
 				current_chunk.SetCardinality(count);
@@ -467,4 +475,49 @@ ParquetSchemaFunction::ParquetSchemaFunction()
                     ParquetMetaDataBind<true>, ParquetMetaDataInit<true>) {
 }
 
+//===--------------------------------------------------------------------===//
+// Scan Statistics
+//===--------------------------------------------------------------------===//
+struct ParquetScanStatisticsData : public GlobalTableFunctionState {
+	ParquetScanStatisticsData() : finished(false) {
+	}
+
+	bool finished;
+};
+
+static unique_ptr<FunctionData> ParquetScanStatisticsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                          vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("row_groups_read");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("row_groups_pruned_by_statistics");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("row_groups_pruned_by_bloom_filter");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	return nullptr;
+}
+
+static unique_ptr<GlobalTableFunctionState> ParquetScanStatisticsInit(ClientContext &context,
+                                                                      TableFunctionInitInput &input) {
+	return make_unique<ParquetScanStatisticsData>();
+}
+
+static void ParquetScanStatisticsImplementation(ClientContext &context, TableFunctionInput &data_p,
+                                                DataChunk &output) {
+	auto &data = (ParquetScanStatisticsData &)*data_p.global_state;
+	if (data.finished) {
+		return;
+	}
+	auto statistics = ParquetScanStatistics::Get(context);
+	output.SetCardinality(1);
+	output.SetValue(0, 0, Value::UBIGINT(statistics->row_groups_read));
+	output.SetValue(1, 0, Value::UBIGINT(statistics->row_groups_pruned_by_statistics));
+	output.SetValue(2, 0, Value::UBIGINT(statistics->row_groups_pruned_by_bloom_filter));
+	data.finished = true;
+}
+
+ParquetScanStatisticsFunction::ParquetScanStatisticsFunction()
+    : TableFunction("parquet_scan_statistics", {}, ParquetScanStatisticsImplementation, ParquetScanStatisticsBind,
+                    ParquetScanStatisticsInit) {
+}
+
 } // namespace duckdb
@@ -0,0 +1,44 @@
+#include "parquet_prefetch_pool.hpp"
+
+namespace duckdb {
+
+ParquetPrefetchPool::~ParquetPrefetchPool() {
+	{
+		lock_guard<mutex> guard(lock);
+		shutdown = true;
+	}
+	task_available.notify_all();
+	for (auto &worker : threads) {
+		worker.join();
+	}
+}
+
+void ParquetPrefetchPool::Schedule(std::function<void()> task, idx_t max_threads) {
+	{
+		lock_guard<mutex> guard(lock);
+		tasks.push_back(move(task));
+		if (idle_threads < tasks.size() && threads.size() < max_threads) {
+			threads.emplace_back([this]() { WorkerLoop(); });
+		}
+	}
+	task_available.notify_one();
+}
+
+void ParquetPrefetchPool::WorkerLoop() {
+	std::unique_lock<mutex> guard(lock);
+	while (true) {
+		idle_threads++;
+		task_available.wait(guard, [&]() { return shutdown || !tasks.empty(); });
+		idle_threads--;
+		if (shutdown) {
+			return;
+		}
+		auto task = move(tasks.front());
+		tasks.pop_front();
+		guard.unlock();
+		task();
+		guard.lock();
+	}
+}
+
+} // namespace duckdb
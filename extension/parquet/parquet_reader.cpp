@@ -1,4 +1,5 @@
 #include "parquet_reader.hpp"
+#include "parquet_bloom_filter.hpp"
 #include "parquet_timestamp.hpp"
 #include "parquet_statistics.hpp"
 #include "column_reader.hpp"
@@ -47,8 +48,9 @@ using duckdb_parquet::format::Statistics;
 using duckdb_parquet::format::Type;
 
 static unique_ptr<duckdb_apache::thrift::protocol::TProtocol>
-CreateThriftProtocol(Allocator &allocator, FileHandle &file_handle, FileOpener &opener, bool prefetch_mode) {
-	auto transport = make_shared<ThriftFileTransport>(allocator, file_handle, opener, prefetch_mode);
+CreateThriftProtocol(Allocator &allocator, FileHandle &file_handle, FileOpener &opener, bool prefetch_mode,
+                     ParquetPrefetchPool *prefetch_pool) {
+	auto transport = make_shared<ThriftFileTransport>(allocator, file_handle, opener, prefetch_mode, prefetch_pool);
 	return make_unique<duckdb_apache::thrift::protocol::TCompactProtocolT<ThriftFileTransport>>(move(transport));
 }
 
@@ -56,7 +58,7 @@ static shared_ptr<ParquetFileMetadataCache> LoadMetadata(Allocator &allocator, F
                                                          FileOpener &opener) {
 	auto current_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 
-	auto proto = CreateThriftProtocol(allocator, file_handle, opener, false);
+	auto proto = CreateThriftProtocol(allocator, file_handle, opener, false, nullptr);
 	auto &transport = ((ThriftFileTransport &)*proto->getTransport());
 	auto file_size = transport.GetSize();
 	if (file_size < 12) {
@@ -452,7 +454,8 @@ ParquetReader::ParquetReader(ClientContext &context_p, string file_name_p, const
                              const vector<LogicalType> &expected_types_p, const vector<column_t> &column_ids,
                              ParquetOptions parquet_options_p, const string &initial_filename_p)
     : allocator(Allocator::Get(context_p)), file_opener(FileSystem::GetFileOpener(context_p)),
-      parquet_options(parquet_options_p) {
+      parquet_options(parquet_options_p), scan_statistics(ParquetScanStatistics::Get(context_p)),
+      prefetch_pool(ParquetPrefetchPool::Get(context_p)) {
 	auto &fs = FileSystem::GetFileSystem(context_p);
 	file_name = move(file_name_p);
 	file_handle = fs.OpenFile(file_name, FileFlags::FILE_FLAGS_READ, FileSystem::DEFAULT_LOCK,
@@ -577,22 +580,114 @@ idx_t ParquetReader::GetGroupOffset(ParquetReaderScanState &state) {
 	return min_offset;
 }
 
+static bool HasEqualityFilter(TableFilter &filter) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON:
+		return ((ConstantFilter &)filter).comparison_type == ExpressionType::COMPARE_EQUAL;
+	case TableFilterType::CONJUNCTION_AND:
+	case TableFilterType::CONJUNCTION_OR: {
+		auto &conjunction = (ConjunctionFilter &)filter;
+		for (auto &child_filter : conjunction.child_filters) {
+			if (HasEqualityFilter(*child_filter)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	default:
+		return false;
+	}
+}
+
+static bool FilterExcludedByBloomFilter(const ParquetBloomFilter &bloom_filter, ColumnReader &column_reader,
+                                        TableFilter &filter) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON: {
+		auto &constant_filter = (ConstantFilter &)filter;
+		if (constant_filter.comparison_type != ExpressionType::COMPARE_EQUAL) {
+			return false;
+		}
+		uint64_t hash;
+		if (!ParquetBloomFilter::HashConstant(column_reader.Type(), column_reader.Schema(), constant_filter.constant,
+		                                      hash)) {
+			return false;
+		}
+		return !bloom_filter.FindHash(hash);
+	}
+	case TableFilterType::CONJUNCTION_AND: {
+		// excluded if any of the children is excluded
+		auto &conjunction = (ConjunctionAndFilter &)filter;
+		for (auto &child_filter : conjunction.child_filters) {
+			if (FilterExcludedByBloomFilter(bloom_filter, column_reader, *child_filter)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	case TableFilterType::CONJUNCTION_OR: {
+		// excluded only if all of the children are excluded
+		auto &conjunction = (ConjunctionOrFilter &)filter;
+		for (auto &child_filter : conjunction.child_filters) {
+			if (!FilterExcludedByBloomFilter(bloom_filter, column_reader, *child_filter)) {
+				return false;
+			}
+		}
+		return !conjunction.child_filters.empty();
+	}
+	default:
+		return false;
+	}
+}
+
+bool ParquetReader::BloomFilterExcludes(ParquetReaderScanState &state, ColumnReader &column_reader,
+                                        const ParquetRowGroup &group, TableFilter &filter) {
+	auto &type = column_reader.Type();
+	if (type.id() == LogicalTypeId::LIST || type.id() == LogicalTypeId::STRUCT || type.id() == LogicalTypeId::MAP) {
+		return false;
+	}
+	D_ASSERT(column_reader.FileIdx() < group.columns.size());
+	auto &column_chunk = group.columns[column_reader.FileIdx()];
+	if (!column_chunk.meta_data.__isset.bloom_filter_offset || !HasEqualityFilter(filter)) {
+		return false;
+	}
+	auto &transport = (ThriftFileTransport &)*state.thrift_file_proto->getTransport();
+	transport.SetLocation(column_chunk.meta_data.bloom_filter_offset);
+	auto bloom_filter = ParquetBloomFilter::Read(*state.thrift_file_proto);
+	if (!bloom_filter) {
+		return false;
+	}
+	return FilterExcludedByBloomFilter(*bloom_filter, column_reader, filter);
+}
+
 void ParquetReader::PrepareRowGroupBuffer(ParquetReaderScanState &state, idx_t out_col_idx) {
 	auto &group = GetGroup(state);
 
 	auto column_reader = ((StructColumnReader *)state.root_reader.get())->GetChildReader(state.column_ids[out_col_idx]);
 
 	// TODO move this to columnreader too
-	if (state.filters) {
+	// the filters of another column may already have ruled out this row group
+	if (state.filters && state.group_offset < (idx_t)group.num_rows) {
 		auto stats = column_reader->Stats(group.columns);
 		// filters contain output chunk index, not file col idx!
 		auto filter_entry = state.filters->filters.find(out_col_idx);
-		if (stats && filter_entry != state.filters->filters.end()) {
+		if (filter_entry != state.filters->filters.end()) {
 			bool skip_chunk = false;
 			auto &filter = *filter_entry->second;
-			auto prune_result = filter.CheckStatistics(*stats);
-			if (prune_result == FilterPropagateResult::FILTER_ALWAYS_FALSE) {
+			if (stats) {
+				auto prune_result = filter.CheckStatistics(*stats);
+				if (prune_result == FilterPropagateResult::FILTER_ALWAYS_FALSE) {
+					skip_chunk = true;
+					if (scan_statistics) {
+						scan_statistics->row_groups_pruned_by_statistics++;
+					}
+				}
+			}
+			if (!skip_chunk && BloomFilterExcludes(state, *column_reader, group, filter)) {
+				// min/max could not rule out this chunk, but the bloom filter can
 				skip_chunk = true;
+				if (scan_statistics) {
+					scan_statistics->row_groups_pruned_by_bloom_filter++;
+				}
 			}
 			if (skip_chunk) {
 				// this effectively will skip this chunk
@@ -637,7 +732,8 @@ void ParquetReader::InitializeScan(ParquetReaderScanState &state, vector<column_
 		                                                      FileSystem::DEFAULT_COMPRESSION, file_opener);
 	}
 
-	state.thrift_file_proto = CreateThriftProtocol(allocator, *state.file_handle, *file_opener, state.prefetch_mode);
+	state.thrift_file_proto = CreateThriftProtocol(allocator, *state.file_handle, *file_opener, state.prefetch_mode,
+	                                               prefetch_pool.get());
 	state.root_reader = CreateReader(GetFileMetadata());
 
 	state.define_buf.resize(allocator, STANDARD_VECTOR_SIZE);
@@ -838,6 +934,9 @@ bool ParquetReader::ScanInternal(ParquetReaderScanState &state, DataChunk &resul
 		}
 
 		auto &group = GetGroup(state);
+		if (scan_statistics && state.group_offset != (idx_t)group.num_rows) {
+			scan_statistics->row_groups_read++;
+		}
 		if (state.prefetch_mode && state.group_offset != (idx_t)group.num_rows) {
 
 			uint64_t total_row_group_span = GetGroupSpan(state);
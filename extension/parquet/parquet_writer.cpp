@@ -213,8 +213,11 @@ void ParquetWriter::SetSchemaProperties(const LogicalType &duckdb_type,
 }
 
 ParquetWriter::ParquetWriter(FileSystem &fs, string file_name_p, FileOpener *file_opener_p, vector<LogicalType> types_p,
-                             vector<string> names_p, CompressionCodec::type codec)
-    : file_name(move(file_name_p)), sql_types(move(types_p)), column_names(move(names_p)), codec(codec) {
+                             vector<string> names_p, CompressionCodec::type codec, bool write_bloom_filter,
+                             double bloom_filter_false_positive_ratio, ParquetVersion parquet_version)
+    : file_name(move(file_name_p)), sql_types(move(types_p)), column_names(move(names_p)), codec(codec),
+      write_bloom_filter(write_bloom_filter), bloom_filter_false_positive_ratio(bloom_filter_false_positive_ratio),
+      parquet_version(parquet_version) {
 	// initialize the file writer
 	writer = make_unique<BufferedFileWriter>(
 	    fs, file_name.c_str(), FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW, file_opener_p);
@@ -3,6 +3,7 @@
 #include "duckdb/common/assert.hpp"
 #include "duckdb/common/exception.hpp"
 
+#include "duckdb/main/arrow_query_result.hpp"
 #include "duckdb/main/stream_query_result.hpp"
 
 #include "duckdb/common/result_arrow_wrapper.hpp"
@@ -123,6 +124,17 @@ int ResultArrowArrayStreamWrapper::MyStreamGetNext(struct ArrowArrayStream *stre
 		my_stream->column_types = result.types;
 		my_stream->column_names = result.names;
 	}
+	if (result.type == QueryResultType::ARROW_RESULT) {
+		// the record batches were already built while the query was executed: hand them out as they are
+		auto array = ((ArrowQueryResult &)result).FetchArray();
+		if (!array) {
+			out->release = nullptr;
+			return 0;
+		}
+		*out = array->arrow_array;
+		array->arrow_array.release = nullptr;
+		return 0;
+	}
 	unique_ptr<DataChunk> chunk_result = result.Fetch();
 	if (!chunk_result) {
 		// Nothing to output
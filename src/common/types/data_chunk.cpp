@@ -155,10 +155,15 @@ void DataChunk::Append(const DataChunk &other, bool resize, SelectionVector *sel
 	}
 	if (new_size > capacity) {
 		if (resize) {
+			// grow the capacity geometrically: Vector::Resize copies all rows, so growing to exactly new_size makes
+			// accumulating a large chunk (e.g. an Arrow record batch of a million rows) quadratic in its size
+			// this can over-allocate up to twice the rows, which is fine for the callers that resize: they all build
+			// a chunk of a known target size that is consumed right away
+			auto new_capacity = NextPowerOfTwo(new_size);
 			for (idx_t i = 0; i < ColumnCount(); i++) {
-				data[i].Resize(size(), new_size);
+				data[i].Resize(size(), new_capacity);
 			}
-			capacity = new_size;
+			capacity = new_capacity;
 		} else {
 			throw InternalException("Can't append chunk to other chunk without resizing");
 		}
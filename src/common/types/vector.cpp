@@ -635,6 +635,17 @@ void Vector::Normalify(idx_t count) {
 			// constant NULL, set nullmask
 			validity.EnsureWritable();
 			validity.SetAllInvalid(count);
+			if (GetType().InternalType() == PhysicalType::STRUCT) {
+				// the children of a NULL struct are flattened as well, so the struct can be sliced afterwards
+				auto normalified_buffer = make_unique<VectorStructBuffer>();
+				auto &new_children = normalified_buffer->GetChildren();
+				for (auto &child : StructVector::GetEntries(*this)) {
+					auto vector = make_unique<Vector>(*child);
+					vector->Normalify(count);
+					new_children.push_back(move(vector));
+				}
+				auxiliary = move(normalified_buffer);
+			}
 			return;
 		}
 		// non-null constant: have to repeat the constant
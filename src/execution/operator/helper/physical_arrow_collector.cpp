@@ -0,0 +1,274 @@
+#include "duckdb/execution/operator/helper/physical_arrow_collector.hpp"
+#include "duckdb/common/arrow_wrapper.hpp"
+#include "duckdb/main/arrow_query_result.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/prepared_statement_data.hpp"
+#include "duckdb/parallel/event.hpp"
+#include "duckdb/parallel/pipeline.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+PhysicalArrowCollector::PhysicalArrowCollector(PreparedStatementData &data, idx_t batch_size, bool parallel,
+                                               bool order_by_batch)
+    : PhysicalResultCollector(data), batch_size(batch_size), parallel(parallel), order_by_batch(order_by_batch) {
+}
+
+unique_ptr<PhysicalResultCollector> PhysicalArrowCollector::Create(ClientContext &context, PreparedStatementData &data,
+                                                                   idx_t batch_size) {
+	auto &config = DBConfig::GetConfig(context);
+	if (!config.preserve_insertion_order) {
+		// we don't care about the order: every thread builds its own record batches
+		return make_unique_base<PhysicalResultCollector, PhysicalArrowCollector>(data, batch_size, true, false);
+	}
+	if (data.plan->AllSourcesSupportBatchIndex()) {
+		// the record batches are built in parallel, and put in order by the batch indexes of their rows
+		return make_unique_base<PhysicalResultCollector, PhysicalArrowCollector>(data, batch_size, true, true);
+	}
+	// collect the result with a single thread to preserve its order
+	return make_unique_base<PhysicalResultCollector, PhysicalArrowCollector>(data, batch_size, false, false);
+}
+
+unique_ptr<QueryResult> PhysicalArrowCollector::ExecuteArrow(ClientContext &context, idx_t batch_size,
+                                                             const std::function<unique_ptr<QueryResult>()> &execute) {
+	auto &config = ClientConfig::GetConfig(context);
+	auto previous_collector = config.result_collector;
+	config.result_collector = [batch_size](ClientContext &context, PreparedStatementData &data) {
+		return PhysicalArrowCollector::Create(context, data, batch_size);
+	};
+	unique_ptr<QueryResult> result;
+	try {
+		result = execute();
+	} catch (...) { // LCOV_EXCL_START
+		config.result_collector = previous_collector;
+		throw;
+	} // LCOV_EXCL_STOP
+	config.result_collector = previous_collector;
+	return result;
+}
+
+//===--------------------------------------------------------------------===//
+// Sink
+//===--------------------------------------------------------------------===//
+//! A part of the result: either a full record batch, or the rows at the end of a batch (or of a thread) that did not
+//! fill a record batch, together with the batch index of the rows
+struct ArrowCollectorPiece {
+	ArrowCollectorPiece(idx_t batch_index, unique_ptr<ArrowArrayWrapper> array)
+	    : batch_index(batch_index), array(move(array)) {
+	}
+	ArrowCollectorPiece(idx_t batch_index, unique_ptr<DataChunk> chunk) : batch_index(batch_index), chunk(move(chunk)) {
+	}
+
+	idx_t batch_index;
+	unique_ptr<ArrowArrayWrapper> array;
+	unique_ptr<DataChunk> chunk;
+};
+
+//! Consecutive small pieces of the result that are combined into a single record batch
+struct ArrowCollectorGroup {
+	//! The index of the record batch in the result
+	idx_t array_index;
+	vector<unique_ptr<DataChunk>> chunks;
+};
+
+class ArrowCollectorGlobalState : public GlobalSinkState {
+public:
+	mutex glock;
+	vector<ArrowCollectorPiece> pieces;
+	//! The groups of small pieces that are converted into record batches in the ArrowCollectorEvent
+	vector<ArrowCollectorGroup> groups;
+	//! The index of the next group that is converted
+	atomic<idx_t> next_group;
+	unique_ptr<ArrowQueryResult> result;
+};
+
+class ArrowCollectorLocalState : public LocalSinkState {
+public:
+	//! The rows that are collected for the next record batch
+	unique_ptr<DataChunk> chunk;
+	//! The batch index of the rows in the chunk
+	idx_t chunk_batch_index = DConstants::INVALID_INDEX;
+	//! The pieces of the result built by this thread
+	vector<ArrowCollectorPiece> pieces;
+
+public:
+	void FlushChunk(idx_t batch_size) {
+		if (!chunk) {
+			return;
+		}
+		if (chunk->size() == 0) {
+			chunk.reset();
+			return;
+		}
+		if (chunk->size() < batch_size) {
+			// too small for a record batch of its own: this is combined with its neighbours in Finalize
+			pieces.emplace_back(chunk_batch_index, move(chunk));
+			return;
+		}
+		// the arrow array shares the fixed-size data and the validity masks of the chunk: the chunk cannot be reused
+		auto array = make_unique<ArrowArrayWrapper>();
+		chunk->ToArrowArray(&array->arrow_array);
+		pieces.emplace_back(chunk_batch_index, move(array));
+		chunk.reset();
+	}
+};
+
+SinkResultType PhysicalArrowCollector::Sink(ExecutionContext &context, GlobalSinkState &gstate,
+                                            LocalSinkState &lstate_p, DataChunk &input) const {
+	auto &state = (ArrowCollectorLocalState &)lstate_p;
+	if (state.chunk && state.chunk_batch_index != state.batch_index) {
+		// a piece only holds rows of a single batch, so that the pieces can be ordered
+		state.FlushChunk(batch_size);
+	}
+	if (!state.chunk) {
+		state.chunk = make_unique<DataChunk>();
+		state.chunk->Initialize(types);
+		state.chunk_batch_index = state.batch_index;
+	}
+	state.chunk->Append(input, true);
+	if (state.chunk->size() >= batch_size) {
+		state.FlushChunk(batch_size);
+	}
+	return SinkResultType::NEED_MORE_INPUT;
+}
+
+void PhysicalArrowCollector::Combine(ExecutionContext &context, GlobalSinkState &gstate_p,
+                                     LocalSinkState &lstate_p) const {
+	auto &gstate = (ArrowCollectorGlobalState &)gstate_p;
+	auto &state = (ArrowCollectorLocalState &)lstate_p;
+	state.FlushChunk(batch_size);
+
+	lock_guard<mutex> lock(gstate.glock);
+	for (auto &piece : state.pieces) {
+		gstate.pieces.push_back(move(piece));
+	}
+}
+
+class ArrowCollectorTask : public ExecutorTask {
+public:
+	ArrowCollectorTask(shared_ptr<Event> event_p, ClientContext &context, ArrowCollectorGlobalState &state,
+	                   const vector<LogicalType> &types)
+	    : ExecutorTask(context), event(move(event_p)), state(state), types(types) {
+	}
+
+	TaskExecutionResult ExecuteTask(TaskExecutionMode mode) override {
+		while (true) {
+			idx_t group_idx = state.next_group++;
+			if (group_idx >= state.groups.size()) {
+				break;
+			}
+			auto &group = state.groups[group_idx];
+			unique_ptr<DataChunk> chunk;
+			if (group.chunks.size() == 1) {
+				chunk = move(group.chunks[0]);
+			} else {
+				chunk = make_unique<DataChunk>();
+				chunk->Initialize(types);
+				for (auto &group_chunk : group.chunks) {
+					chunk->Append(*group_chunk, true);
+					group_chunk.reset();
+				}
+			}
+			auto array = make_unique<ArrowArrayWrapper>();
+			chunk->ToArrowArray(&array->arrow_array);
+			state.result->arrays[group.array_index] = move(array);
+		}
+		event->FinishTask();
+		return TaskExecutionResult::TASK_FINISHED;
+	}
+
+private:
+	shared_ptr<Event> event;
+	ArrowCollectorGlobalState &state;
+	const vector<LogicalType> &types;
+};
+
+class ArrowCollectorEvent : public Event {
+public:
+	ArrowCollectorEvent(ArrowCollectorGlobalState &gstate_p, Pipeline &pipeline_p, const vector<LogicalType> &types)
+	    : Event(pipeline_p.executor), gstate(gstate_p), pipeline(pipeline_p), types(types) {
+	}
+
+	ArrowCollectorGlobalState &gstate;
+	Pipeline &pipeline;
+	const vector<LogicalType> &types;
+
+public:
+	void Schedule() override {
+		auto &context = pipeline.GetClientContext();
+
+		// every task converts groups until all of them are converted
+		auto &ts = TaskScheduler::GetScheduler(context);
+		idx_t num_tasks = MinValue<idx_t>(ts.NumberOfThreads(), gstate.groups.size());
+
+		vector<unique_ptr<Task>> tasks;
+		for (idx_t tnum = 0; tnum < num_tasks; tnum++) {
+			tasks.push_back(make_unique<ArrowCollectorTask>(shared_from_this(), context, gstate, types));
+		}
+		SetTasks(move(tasks));
+	}
+
+	void FinishEvent() override {
+		gstate.groups.clear();
+	}
+};
+
+SinkFinalizeType PhysicalArrowCollector::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+                                                  GlobalSinkState &gstate_p) const {
+	auto &gstate = (ArrowCollectorGlobalState &)gstate_p;
+	if (order_by_batch) {
+		// the pieces of a single batch are all built by the same thread, in order
+		std::stable_sort(
+		    gstate.pieces.begin(), gstate.pieces.end(),
+		    [](const ArrowCollectorPiece &a, const ArrowCollectorPiece &b) { return a.batch_index < b.batch_index; });
+	}
+	auto result =
+	    make_unique<ArrowQueryResult>(statement_type, properties, types, names, context.shared_from_this());
+	// consecutive small pieces are combined into record batches of at most batch_size rows, so that the size of the
+	// record batches does not depend on the size of the batches of the sources
+	idx_t group_count = 0;
+	for (auto &piece : gstate.pieces) {
+		if (piece.array) {
+			result->arrays.push_back(move(piece.array));
+			group_count = 0;
+			continue;
+		}
+		if (group_count == 0 || group_count + piece.chunk->size() > batch_size) {
+			ArrowCollectorGroup group;
+			group.array_index = result->arrays.size();
+			gstate.groups.push_back(move(group));
+			result->arrays.push_back(nullptr);
+			group_count = 0;
+		}
+		group_count += piece.chunk->size();
+		gstate.groups.back().chunks.push_back(move(piece.chunk));
+	}
+	gstate.pieces.clear();
+	gstate.result = move(result);
+	if (!gstate.groups.empty()) {
+		// convert the groups into record batches in parallel
+		gstate.next_group = 0;
+		auto new_event = make_shared<ArrowCollectorEvent>(gstate, pipeline, types);
+		event.InsertEvent(move(new_event));
+	}
+	return SinkFinalizeType::READY;
+}
+
+unique_ptr<LocalSinkState> PhysicalArrowCollector::GetLocalSinkState(ExecutionContext &context) const {
+	return make_unique<ArrowCollectorLocalState>();
+}
+
+unique_ptr<GlobalSinkState> PhysicalArrowCollector::GetGlobalSinkState(ClientContext &context) const {
+	return make_unique<ArrowCollectorGlobalState>();
+}
+
+unique_ptr<QueryResult> PhysicalArrowCollector::GetResult(GlobalSinkState &state) {
+	auto &gstate = (ArrowCollectorGlobalState &)state;
+	D_ASSERT(gstate.result);
+	return move(gstate.result);
+}
+
+} // namespace duckdb
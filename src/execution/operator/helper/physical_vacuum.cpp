@@ -1,10 +1,34 @@
 #include "duckdb/execution/operator/helper/physical_vacuum.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/transaction/transaction_manager.hpp"
 
 namespace duckdb {
 
 void PhysicalVacuum::GetData(ExecutionContext &context, DataChunk &chunk, GlobalSourceState &gstate,
                              LocalSourceState &lstate) const {
-	// NOP
+	if (!info->vacuum) {
+		// ANALYZE: statistics are maintained while appending, there is nothing to do
+		return;
+	}
+	auto &client = context.client;
+	auto &catalog = Catalog::GetCatalog(client);
+	vector<DataTable *> tables;
+	if (!info->table.empty()) {
+		auto table = catalog.GetEntry<TableCatalogEntry>(client, info->schema, info->table);
+		tables.push_back(table->storage.get());
+	} else {
+		catalog.ScanSchemas(client, [&](CatalogEntry *schema) {
+			((SchemaCatalogEntry *)schema)->Scan(CatalogType::TABLE_ENTRY, [&](CatalogEntry *entry) {
+				if (entry->type == CatalogType::TABLE_ENTRY) {
+					tables.push_back(((TableCatalogEntry *)entry)->storage.get());
+				}
+			});
+		});
+	}
+	// the rows of the tables are compacted and written to the database file by a checkpoint
+	TransactionManager::Get(client).Vacuum(client, tables);
 }
 
 } // namespace duckdb
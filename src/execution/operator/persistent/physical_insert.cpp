@@ -1,52 +1,82 @@
 #include "duckdb/execution/operator/persistent/physical_insert.hpp"
 #include "duckdb/parallel/thread_context.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/set.hpp"
 #include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/storage/data_table.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/storage/table/append_state.hpp"
+#include "duckdb/storage/table/row_group.hpp"
+#include "duckdb/transaction/local_storage.hpp"
+#include "duckdb/transaction/transaction.hpp"
 
 namespace duckdb {
 
 //===--------------------------------------------------------------------===//
 // Sink
 //===--------------------------------------------------------------------===//
+//! A range of rows of a chunk collection that is appended to the table. The collection can be shared between the
+//! appends of several threads, each of which only reads its own rows.
+struct InsertSegment {
+	InsertSegment(shared_ptr<ChunkCollection> collection_p, idx_t offset, idx_t count)
+	    : collection(move(collection_p)), offset(offset), count(count) {
+	}
+
+	shared_ptr<ChunkCollection> collection;
+	idx_t offset;
+	idx_t count;
+};
+
 class InsertGlobalState : public GlobalSinkState {
 public:
-	InsertGlobalState() : insert_count(0), returned_chunk_count(0) {
+	InsertGlobalState() : insert_count(0), returned_chunk_count(0), direct_append(false), pending_count(0) {
 	}
 
 	mutex lock;
 	idx_t insert_count;
 	ChunkCollection return_chunk_collection;
 	idx_t returned_chunk_count;
+	//! Whether or not the threads append complete row groups to the table themselves, bypassing the
+	//! transaction-local storage
+	bool direct_append;
+	//! The completed batches of an insert that preserves the insertion order, that cannot be appended yet
+	map<idx_t, unique_ptr<ChunkCollection>> batches;
+	//! The batch indexes the threads are currently sinking, only batches preceding all of them are complete
+	multiset<idx_t> active_batches;
+	//! The rows of completed batches that can be appended in order, but do not fill a row group yet
+	vector<InsertSegment> pending;
+	idx_t pending_count;
 };
 
 class InsertLocalState : public LocalSinkState {
 public:
 	InsertLocalState(const vector<LogicalType> &types, const vector<unique_ptr<Expression>> &bound_defaults)
-	    : default_executor(bound_defaults) {
+	    : default_executor(bound_defaults), current_batch(0), batch_collection(make_unique<ChunkCollection>()) {
 		insert_chunk.Initialize(types);
 	}
 
 	DataChunk insert_chunk;
 	ExpressionExecutor default_executor;
+	//! The thread-local data of a parallel insert that has not been appended to the table yet
+	ChunkCollection local_collection;
+	//! The batch index this thread is sinking when the insertion order is preserved, and the data of that batch
+	idx_t current_batch;
+	unique_ptr<ChunkCollection> batch_collection;
 };
 
 PhysicalInsert::PhysicalInsert(vector<LogicalType> types, TableCatalogEntry *table, vector<idx_t> column_index_map,
                                vector<unique_ptr<Expression>> bound_defaults, idx_t estimated_cardinality,
-                               bool return_chunk)
+                               bool return_chunk, bool parallel, bool preserve_order)
     : PhysicalOperator(PhysicalOperatorType::INSERT, move(types), estimated_cardinality),
       column_index_map(std::move(column_index_map)), table(table), bound_defaults(move(bound_defaults)),
-      return_chunk(return_chunk) {
+      return_chunk(return_chunk), parallel(parallel), preserve_order(preserve_order) {
+	D_ASSERT(!preserve_order || parallel);
 }
 
-SinkResultType PhysicalInsert::Sink(ExecutionContext &context, GlobalSinkState &state, LocalSinkState &lstate,
-                                    DataChunk &chunk) const {
-	auto &gstate = (InsertGlobalState &)state;
-	auto &istate = (InsertLocalState &)lstate;
-
+void PhysicalInsert::ResolveDefaults(InsertLocalState &istate, DataChunk &chunk) const {
 	chunk.Normalify();
 	istate.default_executor.SetChunk(chunk);
 
@@ -78,6 +108,205 @@ SinkResultType PhysicalInsert::Sink(ExecutionContext &context, GlobalSinkState &
 			istate.insert_chunk.data[i].Reference(chunk.data[i]);
 		}
 	}
+}
+
+//! Appends the collection to the transaction-local storage, the global lock must be held
+static void AppendToLocalStorage(TableCatalogEntry &table, ClientContext &context, InsertGlobalState &gstate,
+                                 ChunkCollection &collection, idx_t offset = 0) {
+	idx_t chunk_start = 0;
+	for (auto &chunk : collection.Chunks()) {
+		auto chunk_end = chunk_start + chunk->size();
+		if (offset >= chunk_end) {
+			chunk_start = chunk_end;
+			continue;
+		}
+		if (offset > chunk_start) {
+			// only the end of the chunk has not been appended yet
+			DataChunk remainder;
+			remainder.Initialize(chunk->GetTypes());
+			chunk->Copy(remainder, offset - chunk_start);
+			table.storage->Append(table, context, remainder);
+		} else {
+			table.storage->Append(table, context, *chunk);
+		}
+		chunk_start = chunk_end;
+	}
+	gstate.insert_count += collection.Count() - offset;
+}
+
+//! Takes the first append_count rows of the segments and reserves row groups for them at the end of the table, the
+//! global lock must be held. The rows are appended to the reserved row groups with AppendSegments, after releasing
+//! the lock.
+static vector<InsertSegment> ReserveSegments(TableCatalogEntry &table, ClientContext &context,
+                                             InsertGlobalState &gstate, vector<InsertSegment> &segments,
+                                             idx_t append_count, TableAppendState &append_state) {
+	D_ASSERT(append_count > 0 && append_count % RowGroup::ROW_GROUP_SIZE == 0);
+	auto &transaction = Transaction::GetTransaction(context);
+	table.storage->InitializeOptimisticAppend(transaction, append_state, append_count);
+	// the reserved rows are reverted on rollback even if appending them fails halfway
+	transaction.PushAppend(table.storage.get(), append_state.row_start, append_count);
+	gstate.insert_count += append_count;
+
+	vector<InsertSegment> result;
+	idx_t segment_idx = 0;
+	for (; append_count > 0; segment_idx++) {
+		auto &segment = segments[segment_idx];
+		auto count = MinValue<idx_t>(segment.count, append_count);
+		result.emplace_back(segment.collection, segment.offset, count);
+		append_count -= count;
+		if (count < segment.count) {
+			// the rest of the segment is appended later on
+			segment.offset += count;
+			segment.count -= count;
+			break;
+		}
+	}
+	segments.erase(segments.begin(), segments.begin() + segment_idx);
+	return result;
+}
+
+//! Appends the segments to the row groups reserved for them. The rows bypass DataTable::Append, which verifies the
+//! constraints of the rows that go through the transaction-local storage: the constraints are verified here.
+static void AppendSegments(TableCatalogEntry &table, ClientContext &context, vector<InsertSegment> &segments,
+                           TableAppendState &append_state) {
+	auto &transaction = Transaction::GetTransaction(context);
+	DataChunk part;
+	for (auto &segment : segments) {
+		idx_t chunk_start = 0;
+		auto segment_end = segment.offset + segment.count;
+		for (auto &chunk : segment.collection->Chunks()) {
+			auto chunk_end = chunk_start + chunk->size();
+			if (chunk_end <= segment.offset || chunk_start >= segment_end) {
+				chunk_start = chunk_end;
+				continue;
+			}
+			if (chunk_start >= segment.offset && chunk_end <= segment_end) {
+				table.storage->VerifyAppendConstraints(table, context, *chunk);
+				table.storage->Append(transaction, *chunk, append_state);
+			} else {
+				// the chunk is shared with another segment: copy the rows of this segment
+				auto start = MaxValue<idx_t>(chunk_start, segment.offset) - chunk_start;
+				auto end = MinValue<idx_t>(chunk_end, segment_end) - chunk_start;
+				part.Destroy();
+				part.Initialize(chunk->GetTypes());
+				chunk->Copy(part, start);
+				part.SetCardinality(end - start);
+				table.storage->VerifyAppendConstraints(table, context, part);
+				table.storage->Append(transaction, part, append_state);
+			}
+			chunk_start = chunk_end;
+		}
+	}
+}
+
+//! Appends the complete row groups of the thread-local collection to the table, the rest stays in the collection
+void PhysicalInsert::AppendRowGroups(ClientContext &context, InsertGlobalState &gstate,
+                                     InsertLocalState &istate) const {
+	auto collection = make_shared<ChunkCollection>();
+	collection->Merge(istate.local_collection);
+	istate.local_collection.Reset();
+	auto total_count = collection->Count();
+	auto append_count = total_count / RowGroup::ROW_GROUP_SIZE * RowGroup::ROW_GROUP_SIZE;
+
+	vector<InsertSegment> segments;
+	segments.emplace_back(collection, 0, total_count);
+	TableAppendState append_state;
+	vector<InsertSegment> reserved;
+	{
+		lock_guard<mutex> glock(gstate.lock);
+		reserved = ReserveSegments(*table, context, gstate, segments, append_count, append_state);
+	}
+	AppendSegments(*table, context, reserved, append_state);
+	// keep the remaining rows
+	for (auto &segment : segments) {
+		DataChunk remainder;
+		remainder.Initialize(table->GetTypes());
+		idx_t chunk_start = 0;
+		for (auto &chunk : collection->Chunks()) {
+			auto chunk_end = chunk_start + chunk->size();
+			if (chunk_end > segment.offset) {
+				remainder.Reset();
+				chunk->Copy(remainder, MaxValue<idx_t>(chunk_start, segment.offset) - chunk_start);
+				istate.local_collection.Append(remainder);
+			}
+			chunk_start = chunk_end;
+		}
+	}
+}
+
+//! Hands in the batch the thread finished when the insertion order is preserved, and appends the batches that
+//! precede the batches all threads are still working on
+void PhysicalInsert::FinishBatch(ClientContext &context, InsertGlobalState &gstate, InsertLocalState &istate,
+                                 idx_t next_batch) const {
+	TableAppendState append_state;
+	vector<InsertSegment> reserved;
+	{
+		lock_guard<mutex> glock(gstate.lock);
+		if (istate.batch_collection->Count() > 0) {
+			gstate.batches[istate.current_batch] = move(istate.batch_collection);
+		}
+		gstate.active_batches.erase(gstate.active_batches.find(istate.current_batch));
+		if (next_batch != DConstants::INVALID_INDEX) {
+			gstate.active_batches.insert(next_batch);
+		}
+		// a batch index is only handed out after all lower batch indexes: batches that precede all active batches
+		// are complete
+		auto min_batch = gstate.active_batches.empty() ? DConstants::INVALID_INDEX : *gstate.active_batches.begin();
+		while (!gstate.batches.empty() && gstate.batches.begin()->first < min_batch) {
+			shared_ptr<ChunkCollection> batch = move(gstate.batches.begin()->second);
+			gstate.batches.erase(gstate.batches.begin());
+			auto count = batch->Count();
+			gstate.pending.emplace_back(move(batch), 0, count);
+			gstate.pending_count += count;
+		}
+		if (!gstate.direct_append) {
+			// the rows go through the transaction-local storage, which can only be appended to by one thread
+			for (auto &segment : gstate.pending) {
+				AppendToLocalStorage(*table, context, gstate, *segment.collection, segment.offset);
+			}
+			gstate.pending.clear();
+			gstate.pending_count = 0;
+		} else if (gstate.pending_count >= RowGroup::ROW_GROUP_SIZE) {
+			// the complete row groups are reserved in order, and appended by this thread after releasing the lock
+			auto append_count = gstate.pending_count / RowGroup::ROW_GROUP_SIZE * RowGroup::ROW_GROUP_SIZE;
+			reserved = ReserveSegments(*table, context, gstate, gstate.pending, append_count, append_state);
+			gstate.pending_count -= append_count;
+		}
+	}
+	istate.current_batch = next_batch;
+	istate.batch_collection = make_unique<ChunkCollection>();
+	AppendSegments(*table, context, reserved, append_state);
+}
+
+SinkResultType PhysicalInsert::Sink(ExecutionContext &context, GlobalSinkState &state, LocalSinkState &lstate,
+                                    DataChunk &chunk) const {
+	auto &gstate = (InsertGlobalState &)state;
+	auto &istate = (InsertLocalState &)lstate;
+
+	ResolveDefaults(istate, chunk);
+
+	if (preserve_order) {
+		if (istate.batch_index != istate.current_batch) {
+			// the previous batch of this thread is complete
+			FinishBatch(context.client, gstate, istate, istate.batch_index);
+		}
+		istate.batch_collection->Append(istate.insert_chunk);
+		return SinkResultType::NEED_MORE_INPUT;
+	}
+	if (parallel) {
+		// collect the data locally, and append it to the table once a row group worth of data is collected
+		istate.local_collection.Append(istate.insert_chunk);
+		if (istate.local_collection.Count() >= RowGroup::ROW_GROUP_SIZE) {
+			if (gstate.direct_append) {
+				AppendRowGroups(context.client, gstate, istate);
+			} else {
+				lock_guard<mutex> glock(gstate.lock);
+				AppendToLocalStorage(*table, context.client, gstate, istate.local_collection);
+				istate.local_collection.Reset();
+			}
+		}
+		return SinkResultType::NEED_MORE_INPUT;
+	}
 
 	lock_guard<mutex> glock(gstate.lock);
 	table->storage->Append(*table, context.client, istate.insert_chunk);
@@ -91,18 +320,62 @@ SinkResultType PhysicalInsert::Sink(ExecutionContext &context, GlobalSinkState &
 }
 
 unique_ptr<GlobalSinkState> PhysicalInsert::GetGlobalSinkState(ClientContext &context) const {
-	return make_unique<InsertGlobalState>();
+	auto state = make_unique<InsertGlobalState>();
+	if (parallel) {
+		// complete row groups can be appended by the threads themselves if the rows do not have to be checked against
+		// the indexes, which are only maintained by the transaction-local storage. The appended rows must come after
+		// all rows of the transaction in the table, i.e. the transaction-local storage has to be empty
+		bool has_foreign_keys = false;
+		for (auto &constraint : table->constraints) {
+			if (constraint->type == ConstraintType::FOREIGN_KEY) {
+				has_foreign_keys = true;
+			}
+		}
+		auto &transaction = Transaction::GetTransaction(context);
+		state->direct_append = !has_foreign_keys && table->storage->info->indexes.Empty() &&
+		                       !transaction.storage.Find(table->storage.get());
+	}
+	return move(state);
 }
 
 unique_ptr<LocalSinkState> PhysicalInsert::GetLocalSinkState(ExecutionContext &context) const {
-	return make_unique<InsertLocalState>(table->GetTypes(), bound_defaults);
+	auto state = make_unique<InsertLocalState>(table->GetTypes(), bound_defaults);
+	if (preserve_order) {
+		// the thread has not started on a batch yet: no batch can be complete until it did
+		auto &gstate = (InsertGlobalState &)*sink_state;
+		lock_guard<mutex> glock(gstate.lock);
+		gstate.active_batches.insert(state->current_batch);
+	}
+	return move(state);
 }
 
-void PhysicalInsert::Combine(ExecutionContext &context, GlobalSinkState &gstate, LocalSinkState &lstate) const {
+void PhysicalInsert::Combine(ExecutionContext &context, GlobalSinkState &gstate_p, LocalSinkState &lstate) const {
+	auto &gstate = (InsertGlobalState &)gstate_p;
 	auto &state = (InsertLocalState &)lstate;
 	auto &client_profiler = QueryProfiler::Get(context.client);
 	context.thread.profiler.Flush(this, &state.default_executor, "default_executor", 1);
 	client_profiler.Flush(context.thread.profiler);
+
+	if (preserve_order) {
+		FinishBatch(context.client, gstate, state, DConstants::INVALID_INDEX);
+	} else if (parallel) {
+		lock_guard<mutex> glock(gstate.lock);
+		AppendToLocalStorage(*table, context.client, gstate, state.local_collection);
+		state.local_collection.Reset();
+	}
+}
+
+SinkFinalizeType PhysicalInsert::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+                                          GlobalSinkState &gstate_p) const {
+	auto &gstate = (InsertGlobalState &)gstate_p;
+	// all batches are complete: the rows that do not fill a row group go through the transaction-local storage
+	D_ASSERT(gstate.batches.empty() && gstate.active_batches.empty());
+	for (auto &segment : gstate.pending) {
+		AppendToLocalStorage(*table, context, gstate, *segment.collection, segment.offset);
+	}
+	gstate.pending.clear();
+	gstate.pending_count = 0;
+	return SinkFinalizeType::READY;
 }
 
 //===--------------------------------------------------------------------===//
@@ -38,6 +38,10 @@ public:
 	idx_t MaxThreads() override {
 		return max_threads;
 	}
+
+	bool IsPointLookup() override {
+		return global_state && global_state->IsPointLookup();
+	}
 };
 
 class TableScanLocalSourceState : public LocalSourceState {
@@ -1,20 +1,54 @@
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/execution/operator/persistent/physical_insert.hpp"
 #include "duckdb/execution/physical_plan_generator.hpp"
+#include "duckdb/function/table/table_scan.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
 #include "duckdb/planner/operator/logical_insert.hpp"
 
 namespace duckdb {
 
+static bool ScansTable(LogicalOperator &op, TableCatalogEntry *table) {
+	if (op.type == LogicalOperatorType::LOGICAL_GET) {
+		auto &get = (LogicalGet &)op;
+		auto bind_data = dynamic_cast<TableScanBindData *>(get.bind_data.get());
+		if (bind_data && bind_data->table == table) {
+			return true;
+		}
+	}
+	for (auto &child : op.children) {
+		if (ScansTable(*child, table)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalInsert &op) {
 	unique_ptr<PhysicalOperator> plan;
+	bool parallel = false;
 	if (!op.children.empty()) {
 		D_ASSERT(op.children.size() == 1);
+		// the data can be collected in parallel, unless it is returned or read from the table we are inserting into
+		parallel = !op.return_chunk && !ScansTable(*op.children[0], op.table);
+		for (auto &default_expr : op.bound_defaults) {
+			if (default_expr->HasSideEffects()) {
+				// e.g. nextval: the values have to be generated in the order of the rows, by a single thread
+				parallel = false;
+			}
+		}
 		plan = CreatePlan(*op.children[0]);
 	}
+	bool preserve_order = false;
+	if (parallel && DBConfig::GetConfig(context).preserve_insertion_order) {
+		// maintaining the insertion order in parallel requires batch indexes
+		parallel = plan->AllSourcesSupportBatchIndex();
+		preserve_order = parallel;
+	}
 
 	dependencies.insert(op.table);
 	auto insert = make_unique<PhysicalInsert>(op.types, op.table, op.column_index_map, move(op.bound_defaults),
-	                                          op.estimated_cardinality, op.return_chunk);
+	                                          op.estimated_cardinality, op.return_chunk, parallel, preserve_order);
 	if (plan) {
 		insert->children.push_back(move(plan));
 	}
@@ -36,6 +36,10 @@ bool FunctionData::Equals(const FunctionData *left, const FunctionData *right) {
 	return left->Equals(*right);
 }
 
+bool FunctionData::SupportsPlanCache() const {
+	return true;
+}
+
 TableFunctionData::~TableFunctionData() {
 }
 
@@ -22,6 +22,10 @@ struct CurrentBindData : public FunctionData {
 	bool Equals(const FunctionData &other_p) const override {
 		return true;
 	}
+
+	bool SupportsPlanCache() const override {
+		return false;
+	}
 };
 
 static timestamp_t GetTransactionTimestamp(ExpressionState &state) {
@@ -18,6 +18,11 @@ public:
 		auto &other = (const StatsBindData &)other_p;
 		return stats == other.stats;
 	}
+
+	bool SupportsPlanCache() const override {
+		// the statistics are only filled in while the plan is optimized
+		return false;
+	}
 };
 
 static void StatsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
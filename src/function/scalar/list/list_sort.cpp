@@ -30,6 +30,9 @@ struct ListSortBindData : public FunctionData {
 public:
 	bool Equals(const FunctionData &other_p) const override;
 	unique_ptr<FunctionData> Copy() const override;
+	bool SupportsPlanCache() const override {
+		return false;
+	}
 };
 
 ListSortBindData::ListSortBindData(OrderType order_type_p, OrderByNullType null_order_p,
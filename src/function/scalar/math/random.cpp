@@ -22,6 +22,10 @@ struct RandomBindData : public FunctionData {
 	bool Equals(const FunctionData &other_p) const override {
 		return true;
 	}
+
+	bool SupportsPlanCache() const override {
+		return false;
+	}
 };
 
 struct RandomLocalState : public FunctionLocalState {
@@ -23,6 +23,10 @@ struct SetseedBindData : public FunctionData {
 	bool Equals(const FunctionData &other_p) const override {
 		return true;
 	}
+
+	bool SupportsPlanCache() const override {
+		return false;
+	}
 };
 
 static void SetSeedFunction(DataChunk &args, ExpressionState &state, Vector &result) {
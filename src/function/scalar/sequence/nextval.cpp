@@ -30,6 +30,10 @@ struct NextvalBindData : public FunctionData {
 		auto &other = (NextvalBindData &)other_p;
 		return sequence == other.sequence;
 	}
+
+	bool SupportsPlanCache() const override {
+		return false;
+	}
 };
 
 struct CurrentSequenceValueOperator {
@@ -22,6 +22,9 @@ struct SystemBindData : public FunctionData {
 	bool Equals(const FunctionData &other_p) const override {
 		return true;
 	}
+	bool SupportsPlanCache() const override {
+		return false;
+	}
 
 	static SystemBindData &GetFrom(ExpressionState &state) {
 		auto &func_expr = (BoundFunctionExpression &)state.expr;
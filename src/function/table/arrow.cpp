@@ -261,6 +261,8 @@ bool ArrowScanParallelStateNext(ClientContext &context, const FunctionData *bind
 		current_chunk = parallel_state.stream->GetNextChunk();
 	}
 	state.chunk = move(current_chunk);
+	//! every record batch comes with its own dictionaries
+	state.arrow_dictionary_vectors.clear();
 	//! have we run out of chunks? we are done
 	if (!state.chunk->arrow_array.release) {
 		return false;
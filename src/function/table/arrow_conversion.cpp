@@ -765,11 +765,15 @@ void ColumnArrowToDuckDBDictionary(Vector &vector, ArrowArray &array, ArrowScanL
                                    std::unordered_map<idx_t, unique_ptr<ArrowConvertData>> &arrow_convert_data,
                                    idx_t col_idx, std::pair<idx_t, idx_t> &arrow_convert_idx) {
 	SelectionVector sel;
+	//! The null count can be unknown (-1) as well
+	bool has_nulls = array.null_count != 0 && array.buffers[0];
 	auto &dict_vectors = scan_state.arrow_dictionary_vectors;
 	if (dict_vectors.find(col_idx) == dict_vectors.end()) {
-		//! We need to set the dictionary data for this column
+		//! We need to set the dictionary data for this column, once for every record batch
 		auto base_vector = make_unique<Vector>(vector.GetType(), array.dictionary->length);
-		SetValidityMask(*base_vector, *array.dictionary, scan_state, array.dictionary->length, 0, array.null_count > 0);
+		//! The dictionary vector can point into the record batch: it keeps the batch alive for as long as it is used
+		base_vector->GetBuffer()->SetAuxiliaryData(make_unique<ArrowAuxiliaryData>(scan_state.chunk));
+		SetValidityMask(*base_vector, *array.dictionary, scan_state, array.dictionary->length, 0, has_nulls);
 		ColumnArrowToDuckDB(*base_vector, *array.dictionary, scan_state, array.dictionary->length, arrow_convert_data,
 		                    col_idx, arrow_convert_idx);
 		dict_vectors[col_idx] = move(base_vector);
@@ -778,10 +782,14 @@ void ColumnArrowToDuckDBDictionary(Vector &vector, ArrowArray &array, ArrowScanL
 	//! Get Pointer to Indices of Dictionary
 	auto indices = (data_ptr_t)array.buffers[1] +
 	               GetTypeIdSize(dictionary_type.InternalType()) * (scan_state.chunk_offset + array.offset);
-	if (array.null_count > 0) {
+	if (has_nulls) {
 		ValidityMask indices_validity;
 		GetValidityMask(indices_validity, array, scan_state, size);
 		SetSelectionVector(sel, indices, dictionary_type, size, &indices_validity, array.dictionary->length);
+	} else if (dictionary_type.InternalType() == PhysicalType::INT32 ||
+	           dictionary_type.InternalType() == PhysicalType::UINT32) {
+		//! 32-bit indices have the layout of a selection vector: use them without copying
+		sel.Initialize((sel_t *)indices);
 	} else {
 		SetSelectionVector(sel, indices, dictionary_type, size);
 	}
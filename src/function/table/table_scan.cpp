@@ -8,6 +8,7 @@
 #include "duckdb/optimizer/matcher/expression_matcher.hpp"
 
 #include "duckdb/planner/expression/bound_between_expression.hpp"
+#include "duckdb/planner/expression/bound_parameter_expression.hpp"
 #include "duckdb/planner/expression_iterator.hpp"
 #include "duckdb/planner/operator/logical_get.hpp"
 
@@ -25,6 +26,8 @@ struct TableScanLocalState : public LocalTableFunctionState {
 	//! The current position in the scan
 	TableScanState scan_state;
 	vector<column_t> column_ids;
+	//! The first row of the part of the row group that is being scanned, used as batch index
+	idx_t row_group_batch_index = 0;
 };
 
 static storage_t GetStorageIndex(TableCatalogEntry &table, column_t column_id) {
@@ -107,8 +110,15 @@ bool TableScanParallelStateNext(ClientContext &context, const FunctionData *bind
 	auto &state = (TableScanLocalState &)*local_state;
 
 	lock_guard<mutex> parallel_lock(parallel_state.lock);
-	return bind_data.table->storage->NextParallelScan(context, parallel_state.state, state.scan_state,
-	                                                  state.column_ids);
+	auto result =
+	    bind_data.table->storage->NextParallelScan(context, parallel_state.state, state.scan_state, state.column_ids);
+	auto &row_group_state = state.scan_state.row_group_scan_state;
+	if (result && row_group_state.row_group) {
+		// a row group can be split over several threads, so the batch index includes the starting vector
+		state.row_group_batch_index =
+		    row_group_state.row_group->start + row_group_state.vector_index * STANDARD_VECTOR_SIZE;
+	}
+	return result;
 }
 
 double TableScanProgress(ClientContext &context, const FunctionData *bind_data_p,
@@ -133,7 +143,7 @@ idx_t TableScanGetBatchIndex(ClientContext &context, const FunctionData *bind_da
 	auto &bind_data = (const TableScanBindData &)*bind_data_p;
 	auto &state = (TableScanLocalState &)*local_state;
 	if (state.scan_state.row_group_scan_state.row_group) {
-		return state.scan_state.row_group_scan_state.row_group->start;
+		return state.row_group_batch_index;
 	}
 	if (state.scan_state.local_state.max_index > 0) {
 		return bind_data.table->storage->GetTotalRows() + state.scan_state.local_state.chunk_index;
@@ -158,24 +168,38 @@ unique_ptr<NodeStatistics> TableScanCardinality(ClientContext &context, const Fu
 // Index Scan
 //===--------------------------------------------------------------------===//
 struct IndexScanGlobalState : public GlobalTableFunctionState {
-	explicit IndexScanGlobalState(data_ptr_t row_id_data) : row_ids(LogicalType::ROW_TYPE, row_id_data) {
+	explicit IndexScanGlobalState(vector<row_t> result_ids_p)
+	    : result_ids(move(result_ids_p)),
+	      row_ids(LogicalType::ROW_TYPE, result_ids.empty() ? nullptr : (data_ptr_t)&result_ids[0]) {
 	}
 
+	//! The row ids to fetch
+	vector<row_t> result_ids;
 	Vector row_ids;
 	ColumnFetchState fetch_state;
 	LocalScanState local_storage_state;
 	vector<column_t> column_ids;
 	bool finished;
+
+	bool IsPointLookup() const override {
+		return true;
+	}
 };
 
 static unique_ptr<GlobalTableFunctionState> IndexScanInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
 	auto &bind_data = (const TableScanBindData &)*input.bind_data;
-	data_ptr_t row_id_data = nullptr;
-	if (!bind_data.result_ids.empty()) {
-		row_id_data = (data_ptr_t)&bind_data.result_ids[0];
-	}
-	auto result = make_unique<IndexScanGlobalState>(row_id_data);
 	auto &transaction = Transaction::GetTransaction(context);
+	auto result_ids = bind_data.result_ids;
+	if (bind_data.lookup_index && !bind_data.lookup_value->IsNull()) {
+		// the key is a prepared statement parameter: look it up now that its value is known
+		auto &index = *bind_data.lookup_index;
+		auto index_state =
+		    index.InitializeScanSinglePredicate(transaction, *bind_data.lookup_value, ExpressionType::COMPARE_EQUAL);
+		if (!index.Scan(transaction, *bind_data.table->storage, *index_state, STANDARD_VECTOR_SIZE, result_ids)) {
+			throw InternalException("Lookup in a unique index returned more than %llu rows", STANDARD_VECTOR_SIZE);
+		}
+	}
+	auto result = make_unique<IndexScanGlobalState>(move(result_ids));
 	result->column_ids = input.column_ids;
 	transaction.storage.InitializeScan(bind_data.table->storage.get(), result->local_storage_state, input.filters);
 
@@ -188,8 +212,8 @@ static void IndexScanFunction(ClientContext &context, TableFunctionInput &data_p
 	auto &state = (IndexScanGlobalState &)*data_p.global_state;
 	auto &transaction = Transaction::GetTransaction(context);
 	if (!state.finished) {
-		bind_data.table->storage->Fetch(transaction, output, state.column_ids, state.row_ids,
-		                                bind_data.result_ids.size(), state.fetch_state);
+		bind_data.table->storage->Fetch(transaction, output, state.column_ids, state.row_ids, state.result_ids.size(),
+		                                state.fetch_state);
 		state.finished = true;
 	}
 	if (output.size() == 0) {
@@ -217,6 +241,34 @@ static void RewriteIndexExpression(Index &index, LogicalGet &get, Expression &ex
 	    expr, [&](Expression &child) { RewriteIndexExpression(index, get, child, rewrite_possible); });
 }
 
+static void SetIndexScan(LogicalGet &get, TableScanBindData &bind_data) {
+	bind_data.is_index_scan = true;
+	get.function.init_local = nullptr;
+	get.function.init_global = IndexScanInitGlobal;
+	get.function.function = IndexScanFunction;
+	get.function.table_scan_progress = nullptr;
+	get.function.get_batch_index = nullptr;
+	get.function.filter_pushdown = false;
+}
+
+static BoundParameterExpression *MatchParameterLookup(Expression &index_expression,
+                                                      vector<unique_ptr<Expression>> &filters) {
+	// match on an equality comparison of the indexed expression with a parameter
+	ComparisonExpressionMatcher matcher;
+	matcher.expr_type = make_unique<SpecificExpressionTypeMatcher>(ExpressionType::COMPARE_EQUAL);
+	matcher.matchers.push_back(make_unique<ExpressionEqualityMatcher>(&index_expression));
+	matcher.matchers.push_back(make_unique<ExpressionMatcher>(ExpressionClass::BOUND_PARAMETER));
+	matcher.policy = SetMatcher::Policy::UNORDERED;
+
+	for (auto &filter : filters) {
+		vector<Expression *> bindings;
+		if (matcher.Match(filter.get(), bindings)) {
+			return (BoundParameterExpression *)bindings[2];
+		}
+	}
+	return nullptr;
+}
+
 void TableScanPushdownComplexFilter(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
                                     vector<unique_ptr<Expression>> &filters) {
 	auto &bind_data = (TableScanBindData &)*bind_data_p;
@@ -334,18 +386,23 @@ void TableScanPushdownComplexFilter(ClientContext &context, LogicalGet &get, Fun
 			}
 			if (index.Scan(transaction, storage, *index_state, STANDARD_VECTOR_SIZE, bind_data.result_ids)) {
 				// use an index scan!
-				bind_data.is_index_scan = true;
-				get.function.init_local = nullptr;
-				get.function.init_global = IndexScanInitGlobal;
-				get.function.function = IndexScanFunction;
-				get.function.table_scan_progress = nullptr;
-				get.function.get_batch_index = nullptr;
-				get.function.filter_pushdown = false;
+				SetIndexScan(get, bind_data);
 			} else {
 				bind_data.result_ids.clear();
 			}
 			return true;
 		}
+		if (index.IsUnique()) {
+			// an equality comparison with a prepared statement parameter matches at most one row of a unique index:
+			// the index is probed once the value of the parameter is known
+			auto parameter = MatchParameterLookup(*index_expression, filters);
+			if (parameter && parameter->value) {
+				bind_data.lookup_index = &index;
+				bind_data.lookup_value = parameter->value;
+				SetIndexScan(get, bind_data);
+				return true;
+			}
+		}
 		return false;
 	});
 }
@@ -48,6 +48,7 @@ enum class WALType : uint8_t {
 	INSERT_TUPLE = 26,
 	DELETE_TUPLE = 27,
 	UPDATE_TUPLE = 28,
+	ROW_GROUP_DATA = 29,
 	// -----------------------------
 	// Flush
 	// -----------------------------
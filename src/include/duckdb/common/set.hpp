@@ -11,5 +11,6 @@
 #include <set>
 
 namespace duckdb {
+using std::multiset;
 using std::set;
 }
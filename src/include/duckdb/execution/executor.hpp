@@ -105,6 +105,12 @@ private:
 	void ExtractPipelines(shared_ptr<Pipeline> &pipeline, vector<shared_ptr<Pipeline>> &result);
 	bool NextExecutor();
 
+	//! Whether or not the pipelines of the query only process the rows of index lookups, in which case they are run
+	//! directly on the calling thread instead of being scheduled
+	bool CanExecuteInline();
+	//! Runs the pipelines of the query one after the other on the calling thread
+	void ExecuteInline();
+
 	void AddChildPipeline(Pipeline *current);
 
 	void VerifyPipeline(Pipeline &pipeline);
@@ -153,5 +159,7 @@ private:
 	PendingExecutionResult execution_result;
 	//! The current task in process (if any)
 	unique_ptr<Task> task;
+	//! The pipelines of the query in the order in which they are run, if the query is executed inline
+	vector<Pipeline *> inline_pipelines;
 };
 } // namespace duckdb
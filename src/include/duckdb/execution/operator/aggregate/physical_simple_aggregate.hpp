@@ -49,6 +49,10 @@ public:
 	bool ParallelSink() const override {
 		return true;
 	}
+
+	bool FinalizeSchedulesEvents() const override {
+		return false;
+	}
 };
 
 } // namespace duckdb
@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/execution/operator/helper/physical_arrow_collector.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/execution/operator/helper/physical_result_collector.hpp"
+
+namespace duckdb {
+
+//! PhysicalArrowCollector converts the result of a query into Arrow record batches on the threads that execute the
+//! query, and produces an ArrowQueryResult. Every record batch holds (approximately) batch_size rows, except for the
+//! record batches that end at the boundary of a source batch or of a thread, which can be smaller: the consecutive
+//! rows at these boundaries are combined into record batches of at most batch_size rows
+class PhysicalArrowCollector : public PhysicalResultCollector {
+public:
+	PhysicalArrowCollector(PreparedStatementData &data, idx_t batch_size, bool parallel, bool order_by_batch);
+
+	//! The (approximate) number of rows in a record batch
+	idx_t batch_size;
+	//! Whether or not the result is collected by multiple threads
+	bool parallel;
+	//! Whether or not the insertion order is restored through the batch indexes of the sources
+	bool order_by_batch;
+
+public:
+	//! Creates an arrow collector for the plan, which collects the result in parallel if the insertion order can be
+	//! preserved - or does not have to be preserved
+	static unique_ptr<PhysicalResultCollector> Create(ClientContext &context, PreparedStatementData &data,
+	                                                  idx_t batch_size);
+	//! Runs execute with an arrow collector as the result collector of the client, and restores the previous result
+	//! collector afterwards
+	static unique_ptr<QueryResult> ExecuteArrow(ClientContext &context, idx_t batch_size,
+	                                            const std::function<unique_ptr<QueryResult>()> &execute);
+
+	unique_ptr<QueryResult> GetResult(GlobalSinkState &state) override;
+
+public:
+	// Sink interface
+	SinkResultType Sink(ExecutionContext &context, GlobalSinkState &state, LocalSinkState &lstate,
+	                    DataChunk &input) const override;
+	void Combine(ExecutionContext &context, GlobalSinkState &state, LocalSinkState &lstate) const override;
+	SinkFinalizeType Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+	                          GlobalSinkState &gstate) const override;
+
+	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) const override;
+	unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext &context) const override;
+
+	bool RequiresBatchIndex() const override {
+		return order_by_batch;
+	}
+
+	bool ParallelSink() const override {
+		return parallel;
+	}
+
+	//! Finalize converts the collected chunks into record batches in an ArrowCollectorEvent
+	bool FinalizeSchedulesEvents() const override {
+		return true;
+	}
+};
+
+} // namespace duckdb
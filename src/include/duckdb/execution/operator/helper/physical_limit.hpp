@@ -55,6 +55,10 @@ public:
 		return true;
 	}
 
+	bool FinalizeSchedulesEvents() const override {
+		return false;
+	}
+
 public:
 	static bool ComputeOffset(DataChunk &input, idx_t &limit, idx_t &offset, idx_t current_offset, idx_t &max_element,
 	                          Expression *limit_expression, Expression *offset_expression);
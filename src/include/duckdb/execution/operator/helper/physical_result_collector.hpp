@@ -35,6 +35,10 @@ public:
 		return true;
 	}
 
+	bool FinalizeSchedulesEvents() const override {
+		return false;
+	}
+
 public:
 	vector<PhysicalOperator *> GetChildren() const override;
 
@@ -46,6 +46,9 @@ public:
 	bool ParallelSink() const override {
 		return true;
 	}
+	bool FinalizeSchedulesEvents() const override {
+		return false;
+	}
 };
 
 } // namespace duckdb
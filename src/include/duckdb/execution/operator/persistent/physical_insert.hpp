@@ -12,12 +12,15 @@
 #include "duckdb/planner/expression.hpp"
 
 namespace duckdb {
+class InsertGlobalState;
+class InsertLocalState;
 
 //! Physically insert a set of data into a table
 class PhysicalInsert : public PhysicalOperator {
 public:
 	PhysicalInsert(vector<LogicalType> types, TableCatalogEntry *table, vector<idx_t> column_index_map,
-	               vector<unique_ptr<Expression>> bound_defaults, idx_t estimated_cardinality, bool return_chunk);
+	               vector<unique_ptr<Expression>> bound_defaults, idx_t estimated_cardinality, bool return_chunk,
+	               bool parallel, bool preserve_order);
 
 	//! The map from insert column index to table column index
 	vector<idx_t> column_index_map;
@@ -27,6 +30,10 @@ public:
 	vector<unique_ptr<Expression>> bound_defaults;
 	//! If the returning statement is present, return the whole chunk
 	bool return_chunk;
+	//! Whether or not the data is collected by multiple threads
+	bool parallel;
+	//! Whether or not the insertion order is preserved in a parallel insert, using the batch indexes of the source
+	bool preserve_order;
 
 public:
 	// Source interface
@@ -38,6 +45,8 @@ public:
 	// Sink interface
 	unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext &context) const override;
 	void Combine(ExecutionContext &context, GlobalSinkState &gstate, LocalSinkState &lstate) const override;
+	SinkFinalizeType Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+	                          GlobalSinkState &gstate) const override;
 	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) const override;
 	SinkResultType Sink(ExecutionContext &context, GlobalSinkState &state, LocalSinkState &lstate,
 	                    DataChunk &input) const override;
@@ -47,8 +56,25 @@ public:
 	}
 
 	bool ParallelSink() const override {
+		return parallel;
+	}
+
+	bool RequiresBatchIndex() const override {
+		return preserve_order;
+	}
+
+	bool FinalizeSchedulesEvents() const override {
 		return false;
 	}
+
+private:
+	//! Fill the insert chunk of the local state with the input chunk and the default values
+	void ResolveDefaults(InsertLocalState &istate, DataChunk &chunk) const;
+	//! Append the complete row groups collected by the thread to the table, bypassing the transaction-local storage
+	void AppendRowGroups(ClientContext &context, InsertGlobalState &gstate, InsertLocalState &istate) const;
+	//! Hand in the batch the thread finished and move on to the next batch (if any), when preserving the order
+	void FinishBatch(ClientContext &context, InsertGlobalState &gstate, InsertLocalState &istate,
+	                 idx_t next_batch) const;
 };
 
 } // namespace duckdb
@@ -54,6 +54,9 @@ public:
 	bool ParallelSink() const override {
 		return true;
 	}
+	bool FinalizeSchedulesEvents() const override {
+		return false;
+	}
 };
 
 } // namespace duckdb
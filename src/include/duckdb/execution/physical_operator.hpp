@@ -69,6 +69,11 @@ public:
 	virtual idx_t MaxThreads() {
 		return 1;
 	}
+	//! Whether or not the source only emits the few rows found by an index lookup, in which case the pipeline is
+	//! cheaper to run directly than to schedule
+	virtual bool IsPointLookup() {
+		return false;
+	}
 };
 
 class LocalSourceState {
@@ -200,6 +205,12 @@ public:
 		return false;
 	}
 
+	//! Whether or not Finalize can schedule additional events. The pipelines of sinks that do not can be finalized
+	//! inline, without running the event that is passed to Finalize.
+	virtual bool FinalizeSchedulesEvents() const {
+		return true;
+	}
+
 public:
 	// Pipeline construction
 	virtual vector<const PhysicalOperator *> GetSources() const;
@@ -12,6 +12,7 @@
 #include "duckdb/function/function.hpp"
 #include "duckdb/common/enums/compression_type.hpp"
 #include "duckdb/common/map.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/storage/storage_info.hpp"
 
 namespace duckdb {
@@ -167,6 +168,7 @@ public:
 
 //! The set of compression functions
 struct CompressionFunctionSet {
+	mutex lock;
 	map<CompressionType, map<PhysicalType, CompressionFunction>> functions;
 };
 
@@ -38,6 +38,9 @@ struct FunctionData {
 	DUCKDB_API virtual unique_ptr<FunctionData> Copy() const = 0;
 	DUCKDB_API virtual bool Equals(const FunctionData &other) const = 0;
 	DUCKDB_API static bool Equals(const FunctionData *left, const FunctionData *right);
+	//! Whether or not a plan that holds the bind data can be reused by other queries, which is not the case if it
+	//! refers to the client context that the function was bound in, or to state derived from the current data
+	DUCKDB_API virtual bool SupportsPlanCache() const;
 };
 
 struct TableFunctionData : public FunctionData {
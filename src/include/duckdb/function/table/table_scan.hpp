@@ -12,10 +12,12 @@
 #include "duckdb/common/atomic.hpp"
 
 namespace duckdb {
+class Index;
 class TableCatalogEntry;
 
 struct TableScanBindData : public TableFunctionData {
-	explicit TableScanBindData(TableCatalogEntry *table) : table(table), is_index_scan(false), chunk_count(0) {
+	explicit TableScanBindData(TableCatalogEntry *table)
+	    : table(table), is_index_scan(false), lookup_index(nullptr), lookup_value(nullptr), chunk_count(0) {
 	}
 
 	//! The table to scan
@@ -25,6 +27,11 @@ struct TableScanBindData : public TableFunctionData {
 	bool is_index_scan;
 	//! The row ids to fetch (in case of an index scan)
 	vector<row_t> result_ids;
+	//! The unique index that is probed when the scan starts (in case of an index scan on a prepared statement
+	//! parameter, whose value is only known when the statement is executed)
+	Index *lookup_index;
+	//! The value of the prepared statement parameter that is looked up in the index
+	Value *lookup_value;
 
 	//! How many chunks we already scanned
 	atomic<idx_t> chunk_count;
@@ -32,7 +39,8 @@ struct TableScanBindData : public TableFunctionData {
 public:
 	bool Equals(const FunctionData &other_p) const override {
 		auto &other = (const TableScanBindData &)other_p;
-		return other.table == table && result_ids == other.result_ids;
+		return other.table == table && result_ids == other.result_ids && lookup_index == other.lookup_index &&
+		       lookup_value == other.lookup_value;
 	}
 };
 
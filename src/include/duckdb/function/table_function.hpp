@@ -35,6 +35,10 @@ public:
 	DUCKDB_API virtual idx_t MaxThreads() const {
 		return 1;
 	}
+	//! Whether or not the scan only fetches the few rows found by an index lookup
+	DUCKDB_API virtual bool IsPointLookup() const {
+		return false;
+	}
 };
 
 struct LocalTableFunctionState {
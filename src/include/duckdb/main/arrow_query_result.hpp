@@ -0,0 +1,50 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/main/arrow_query_result.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/arrow_wrapper.hpp"
+#include "duckdb/common/winapi.hpp"
+#include "duckdb/main/query_result.hpp"
+
+namespace duckdb {
+
+class ClientContext;
+
+//! The ArrowQueryResult holds the entire result of a query as Arrow record batches, which are built by the threads
+//! that execute the query (see PhysicalArrowCollector). The result can only be consumed as record batches.
+class ArrowQueryResult : public QueryResult {
+public:
+	//! Creates a successful query result with the specified names and types
+	DUCKDB_API ArrowQueryResult(StatementType statement_type, StatementProperties properties, vector<LogicalType> types,
+	                            vector<string> names, const shared_ptr<ClientContext> &context);
+	//! Creates an unsuccessful query result with error condition
+	DUCKDB_API explicit ArrowQueryResult(string error);
+
+	//! The record batches of the result, in order
+	vector<unique_ptr<ArrowArrayWrapper>> arrays;
+	//! The client context this ArrowQueryResult belongs to
+	std::weak_ptr<ClientContext> context;
+
+public:
+	//! Arrow results cannot be fetched as DataChunks: this throws an exception
+	DUCKDB_API unique_ptr<DataChunk> FetchRaw() override;
+	//! Converts the QueryResult to a string
+	DUCKDB_API string ToString() override;
+
+	//! Takes the next record batch out of the result, or returns nullptr if all of them have been consumed
+	DUCKDB_API unique_ptr<ArrowArrayWrapper> FetchArray();
+	//! The total number of rows in the record batches that have not been consumed yet
+	DUCKDB_API idx_t RowCount() const;
+
+private:
+	//! The index of the next record batch that is handed out by FetchArray
+	idx_t array_index = 0;
+};
+
+} // namespace duckdb
@@ -34,7 +34,8 @@ struct PreparedStatementWrapper {
 };
 
 struct ArrowResultWrapper {
-	unique_ptr<MaterializedQueryResult> result;
+	//! Either an ArrowQueryResult, or a MaterializedQueryResult for statements that do not return a query result
+	unique_ptr<QueryResult> result;
 	unique_ptr<DataChunk> current_chunk;
 	string timezone_config;
 };
@@ -236,6 +236,10 @@ private:
 	                                                            shared_ptr<PreparedStatementData> &prepared,
 	                                                            PendingQueryParameters parameters);
 
+	//! Takes a plan for the single-statement query out of the plan cache of the database, or returns nullptr if there
+	//! is none. Caller must hold the context_lock.
+	shared_ptr<PreparedStatementData> GetCachedPlan(ClientContextLock &lock, const string &query);
+
 private:
 	//! Lock on using the ClientContext in parallel
 	mutex context_lock;
@@ -79,6 +79,22 @@ public:
 	Allocator allocator;
 	// Checkpoint when WAL reaches this size (default: 16MB)
 	idx_t checkpoint_wal_size = 1 << 24;
+	//! Whether or not automatic checkpoints are run by a background thread of the task scheduler. The committing
+	//! connection does not wait for the checkpoint, but other queries still wait while the checkpoint runs
+	bool background_checkpoint = false;
+	//! Time in microseconds a commit waits for concurrent commits to share a single WAL sync with (default: 0,
+	//! every commit syncs the WAL itself while holding the transaction lock)
+	idx_t wal_group_commit_window = 0;
+	//! Whether or not the complete row groups appended by a commit are written directly to the database file instead
+	//! of to the WAL, if no other transactions are active (default: false)
+	bool direct_row_group_writes = false;
+	//! The committed updates of a column are merged into its in-memory data once at least this fraction of its rows is
+	//! updated and no transaction is running (default: 0.1)
+	double update_merge_threshold = 0.1;
+	//! A checkpoint compacts the row groups in which at least this fraction of the rows is deleted (default: 0.5)
+	double vacuum_threshold = 0.5;
+	//! The number of SELECT plans that are kept to be reused by later queries with the same text (0: no plan cache)
+	idx_t plan_cache_size = 0;
 	//! Whether or not to use Direct IO, bypassing operating system buffers
 	bool use_direct_io = false;
 	//! Whether extensions should be loaded on start-up
@@ -0,0 +1,88 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/main/plan_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+
+namespace duckdb {
+class ClientContext;
+class LogicalOperator;
+class PreparedStatementData;
+
+//! The PlanCache holds the prepared plans of SELECT statements, so that a query that is issued again - by any
+//! connection - does not have to be parsed, bound, optimized and planned again. A plan is only used by one query at a
+//! time: it is taken out of the cache while it is in use, and put back once the last reference to it is released.
+//! Plans are keyed on the whitespace-normalized query text and on the settings of the connection, and are dropped as
+//! soon as the catalog changes.
+class PlanCache : public std::enable_shared_from_this<PlanCache> {
+public:
+	explicit PlanCache(idx_t capacity);
+
+	static PlanCache &Get(ClientContext &context);
+	//! Whether or not the plans of queries issued by the context can be cached, or taken from the cache
+	static bool PlanCacheEnabled(ClientContext &context);
+	//! Whether or not the (unoptimized) plan can be reused by other queries: it has to scan nothing but tables, and
+	//! its functions have to support the plan cache
+	static bool CanCachePlan(LogicalOperator &op);
+	//! Whether or not the optimized plan holds the result of an index lookup, which is only valid for the current data.
+	//! Can only be called on plans that passed CanCachePlan.
+	static bool HasIndexScan(LogicalOperator &op);
+
+	//! Takes a plan for the single-statement query [query] out of the cache, or returns nullptr if there is none
+	shared_ptr<PreparedStatementData> GetPlan(ClientContext &context, const string &query);
+	//! Hands a plan that was just created for [query] to the cache: once the returned pointer is released, the plan
+	//! is kept in the cache for the next query with the same text
+	shared_ptr<PreparedStatementData> AddPlan(ClientContext &context, const string &query,
+	                                          unique_ptr<PreparedStatementData> plan);
+
+	//! Changes the maximum number of plans kept in the cache, evicting plans if required
+	void SetCapacity(idx_t new_capacity);
+	//! The number of plans that are currently kept in the cache
+	idx_t PlanCount();
+
+private:
+	struct CachedPlans {
+		//! The unused plans of the query
+		vector<unique_ptr<PreparedStatementData>> plans;
+		//! The access counter of the cache when this query last used a plan
+		idx_t last_used = 0;
+	};
+
+	//! Hands out a plan, which is put back into the cache once it is no longer used
+	shared_ptr<PreparedStatementData> CheckOutPlan(const string &query_key, const string &settings_key,
+	                                               unique_ptr<PreparedStatementData> plan);
+	//! Puts a plan that is no longer used back into the cache
+	void ReturnPlan(const string &query_key, const string &settings_key, unique_ptr<PreparedStatementData> plan);
+	//! Drops all plans if the catalog changed since they were created
+	void Refresh(ClientContext &context);
+	//! Evicts the plans of the least recently used queries until the cache fits in its size
+	void EvictPlans();
+
+	//! The whitespace-normalized text of the query, or its trimmed text if the query cannot be normalized safely
+	static string GetQueryKey(const string &query);
+	//! The settings of the connection, which influence how a query is bound and planned
+	static string GetSettingsKey(ClientContext &context);
+
+private:
+	mutex cache_lock;
+	//! The catalog version that the cached plans were created with
+	idx_t catalog_version;
+	//! The maximum number of plans kept in the cache
+	idx_t capacity;
+	//! The cached plans, keyed on the normalized query text and then on the settings of the connection
+	unordered_map<string, unordered_map<string, CachedPlans>> cache;
+	//! The number of plans in the cache
+	idx_t plan_count;
+	//! Incremented on every access of the cache, used to find the least recently used plans
+	idx_t access_counter;
+};
+
+} // namespace duckdb
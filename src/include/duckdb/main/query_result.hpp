@@ -16,7 +16,7 @@ struct ArrowSchema;
 
 namespace duckdb {
 
-enum class QueryResultType : uint8_t { MATERIALIZED_RESULT, STREAM_RESULT, PENDING_RESULT };
+enum class QueryResultType : uint8_t { MATERIALIZED_RESULT, STREAM_RESULT, PENDING_RESULT, ARROW_RESULT };
 
 class BaseQueryResult {
 public:
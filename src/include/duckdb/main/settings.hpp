@@ -24,6 +24,15 @@ struct AccessModeSetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct BackgroundCheckpointSetting {
+	static constexpr const char *Name = "background_checkpoint";
+	static constexpr const char *Description =
+	    "Whether or not automatic checkpoints run on a background thread instead of in the committing connection";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
 struct CheckpointThresholdSetting {
 	static constexpr const char *Name = "checkpoint_threshold";
 	static constexpr const char *Description =
@@ -101,6 +110,16 @@ struct DefaultNullOrderSetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct DirectRowGroupWritesSetting {
+	static constexpr const char *Name = "direct_row_group_writes";
+	static constexpr const char *Description =
+	    "Whether or not complete row groups of large commits are written directly to the database file, logging only "
+	    "their metadata to the WAL";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
 struct DisabledOptimizersSetting {
 	static constexpr const char *Name = "disabled_optimizers";
 	static constexpr const char *Description = "DEBUG SETTING: disable a specific set of optimizers (comma separated)";
@@ -204,6 +223,15 @@ struct PerfectHashThresholdSetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct PlanCacheSizeSetting {
+	static constexpr const char *Name = "plan_cache_size";
+	static constexpr const char *Description =
+	    "The number of SELECT plans that are kept to be reused by queries with the same text (0 to disable)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BIGINT;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
 struct PreserveIdentifierCase {
 	static constexpr const char *Name = "preserve_identifier_case";
 	static constexpr const char *Description =
@@ -291,4 +319,33 @@ struct ThreadsSetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct UpdateMergeThresholdSetting {
+	static constexpr const char *Name = "update_merge_threshold";
+	static constexpr const char *Description =
+	    "The fraction of updated rows at which the committed updates of a column are merged into its in-memory data "
+	    "once no transaction is running (0 to merge every update)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::DOUBLE;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct VacuumThresholdSetting {
+	static constexpr const char *Name = "vacuum_threshold";
+	static constexpr const char *Description =
+	    "The fraction of deleted rows at which a checkpoint compacts a row group (1 to only remove row groups in which "
+	    "every row is deleted)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::DOUBLE;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct WALGroupCommitWindowSetting {
+	static constexpr const char *Name = "wal_group_commit_window";
+	static constexpr const char *Description =
+	    "Time in microseconds that a commit waits for concurrent commits to share a WAL sync with (0 to disable)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BIGINT;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
 } // namespace duckdb
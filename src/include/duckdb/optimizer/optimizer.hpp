@@ -12,6 +12,7 @@
 #include "duckdb/planner/logical_operator.hpp"
 #include "duckdb/planner/logical_operator_visitor.hpp"
 #include "duckdb/common/enums/optimizer_type.hpp"
+#include "duckdb/common/set.hpp"
 
 #include <functional>
 
@@ -27,6 +28,8 @@ public:
 	ClientContext &context;
 	Binder &binder;
 	ExpressionRewriter rewriter;
+	//! Optimizers that are skipped in addition to the ones disabled in the configuration
+	set<OptimizerType> disabled_optimizers;
 
 private:
 	void RunOptimizer(OptimizerType type, const std::function<void()> &callback);
@@ -13,7 +13,21 @@
 namespace duckdb {
 
 struct VacuumInfo : public ParseInfo {
-	// nothing for now
+	//! Whether or not the storage of the tables is compacted (VACUUM), ANALYZE does nothing for now
+	bool vacuum = true;
+	//! The schema of the table to vacuum
+	string schema;
+	//! The table to vacuum, if empty every table is vacuumed
+	string table;
+
+public:
+	unique_ptr<VacuumInfo> Copy() const {
+		auto result = make_unique<VacuumInfo>();
+		result->vacuum = vacuum;
+		result->schema = schema;
+		result->table = table;
+		return result;
+	}
 };
 
 } // namespace duckdb
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/common/common.hpp"
+#include "duckdb/common/pair.hpp"
 #include "duckdb/storage/block.hpp"
 #include "duckdb/storage/storage_info.hpp"
 
@@ -22,7 +23,11 @@ class BlockManager {
 public:
 	virtual ~BlockManager() = default;
 
-	virtual void StartCheckpoint() = 0;
+	//! Start a checkpoint. If compact_file is set, the checkpoint moves the contents of the blocks near the end of the
+	//! file into free blocks nearer to its start, so the file can be truncated when the old blocks are freed.
+	virtual void StartCheckpoint(bool compact_file) = 0;
+	//! Whether or not the checkpoint should rewrite the given block to move its contents toward the start of the file
+	virtual bool ShouldRelocateBlock(block_id_t block_id) = 0;
 	//! Creates a new block inside the block manager
 	virtual unique_ptr<Block> CreateBlock(block_id_t block_id) = 0;
 	//! Return the next free block id
@@ -35,6 +40,13 @@ public:
 	//! Increase the reference count of a block. The block should hold at least one reference before this method is
 	//! called.
 	virtual void IncreaseBlockReferenceCount(block_id_t block_id) = 0;
+	//! Marks a block that was written outside of a checkpoint as used, with the given reference count. Blocks past the
+	//! end of the file are added to it, the blocks that are skipped over are free.
+	virtual void MarkBlockAsUsed(block_id_t block_id, uint32_t reference_count) = 0;
+	//! Start recording the ids of the blocks that are handed out by GetFreeBlockId
+	virtual void StartRecordingAllocations() = 0;
+	//! Stop recording allocations, returns the recorded blocks together with their current reference count
+	virtual vector<pair<block_id_t, uint32_t>> StopRecordingAllocations() = 0;
 	//! Get the first meta block id
 	virtual block_id_t GetMetaBlock() = 0;
 	//! Read the content of the block from disk
@@ -47,6 +59,8 @@ public:
 	}
 	//! Write the header; should be the final step of a checkpoint
 	virtual void WriteHeader(DatabaseHeader header) = 0;
+	//! Sync the blocks that have been written to disk
+	virtual void Sync() = 0;
 
 	//! Returns the number of total blocks
 	virtual idx_t TotalBlocks() = 0;
@@ -13,6 +13,7 @@
 namespace duckdb {
 class CheckpointManager;
 class ColumnData;
+class DataTable;
 class ColumnSegment;
 class RowGroup;
 class BaseStatistics;
@@ -25,12 +26,15 @@ class TableDataWriter {
 public:
 	TableDataWriter(DatabaseInstance &db, CheckpointManager &checkpoint_manager, TableCatalogEntry &table,
 	                MetaBlockWriter &meta_writer);
+	//! Creates a writer that only writes the column data of row groups of the table, without any metadata
+	TableDataWriter(DatabaseInstance &db, CheckpointManager &checkpoint_manager, DataTable &table);
 	~TableDataWriter();
 
 	BlockPointer WriteTableData();
 
 	MetaBlockWriter &GetMetaWriter() {
-		return meta_writer;
+		D_ASSERT(meta_writer);
+		return *meta_writer;
 	}
 
 	CheckpointManager &GetCheckpointManager() {
@@ -41,8 +45,8 @@ public:
 
 private:
 	CheckpointManager &checkpoint_manager;
-	TableCatalogEntry &table;
-	MetaBlockWriter &meta_writer;
+	DataTable &table;
+	MetaBlockWriter *meta_writer;
 };
 
 } // namespace duckdb
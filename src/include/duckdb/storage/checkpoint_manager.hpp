@@ -10,6 +10,7 @@
 
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/map.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/storage/meta_block_writer.hpp"
@@ -55,11 +56,14 @@ public:
 	unique_ptr<MetaBlockWriter> metadata_writer;
 	//! The table data writer is responsible for writing the DataPointers used by the table chunks
 	unique_ptr<MetaBlockWriter> tabledata_writer;
+	//! Lock for the partially filled blocks, which are shared by the columns that are checkpointed in parallel
+	mutex partial_block_lock;
 
 public:
 	//! Checkpoint the current state of the WAL and flush it to the main storage. This should be called BEFORE any
 	//! connction is available because right now the checkpointing cannot be done online. (TODO)
-	void CreateCheckpoint();
+	//! If compact_file is set, the blocks near the end of the database file are rewritten so the file can shrink.
+	void CreateCheckpoint(bool compact_file = false);
 	//! Load from a stored checkpoint
 	void LoadFromStorage();
 
@@ -19,6 +19,7 @@
 #include "duckdb/storage/table/row_group.hpp"
 #include "duckdb/common/enums/scan_options.hpp"
 #include "duckdb/storage/statistics/column_statistics.hpp"
+#include "duckdb/storage/storage_lock.hpp"
 
 #include "duckdb/common/atomic.hpp"
 #include "duckdb/common/mutex.hpp"
@@ -185,12 +186,19 @@ public:
 
 	//! Begin appending structs to this table, obtaining necessary locks, etc
 	void InitializeAppend(Transaction &transaction, TableAppendState &state, idx_t append_count);
+	//! Reserve new row groups at the end of the table for [append_count] rows, which must be a multiple of the row
+	//! group size. Only the reservation holds the append lock: the rows are appended concurrently with the appends of
+	//! other transactions.
+	void InitializeOptimisticAppend(Transaction &transaction, TableAppendState &state, idx_t append_count);
 	//! Append a chunk to the table using the AppendState obtained from BeginAppend
 	void Append(Transaction &transaction, DataChunk &chunk, TableAppendState &state);
 	//! Commit the append
 	void CommitAppend(transaction_t commit_id, idx_t row_start, idx_t count);
-	//! Write a segment of the table to the WAL
+	//! Write a segment of the table to the WAL. If the WAL allows it, complete row groups are written to the database
+	//! file directly and only their metadata is written to the WAL.
 	void WriteToLog(WriteAheadLog &log, idx_t row_start, idx_t count);
+	//! Append the row groups that were written to the database file by WriteToLog, used to replay the WAL
+	void AppendRowGroupData(Transaction &transaction, Deserializer &source);
 	//! Revert a set of appends made by the given AppendState, used to revert appends in the event of an error during
 	//! commit (e.g. because of an I/O exception)
 	void RevertAppend(idx_t start_row, idx_t count);
@@ -216,8 +224,15 @@ public:
 
 	//! Checkpoint the table to the specified table data writer
 	BlockPointer Checkpoint(TableDataWriter &writer);
+	//! Compact the row groups in which at least the given fraction of the rows is deleted, and (if merge_small is set)
+	//! merge adjacent row groups that are not full. The rows keep their position within the table, but not their
+	//! row ids: this must only be called when no other transaction can observe the table (i.e. when checkpointing)
+	void Vacuum(double threshold, bool merge_small);
 	void CommitDropTable();
 	void CommitDropColumn(idx_t index);
+	//! Merge the committed updates of the columns in [merge_columns] into their base data. This must only be called
+	//! when no other transaction can observe the table.
+	void MergeUpdates(const unordered_set<ColumnData *> &merge_columns, double threshold);
 
 	idx_t GetTotalRows();
 
@@ -226,9 +241,10 @@ public:
 
 	vector<vector<Value>> GetStorageInfo();
 
-private:
 	//! Verify constraints with a chunk from the Append containing all columns of the table
 	void VerifyAppendConstraints(TableCatalogEntry &table, ClientContext &context, DataChunk &chunk);
+
+private:
 	//! Verify constraints with a chunk from the Update containing only the specified column_ids
 	void VerifyUpdateConstraints(TableCatalogEntry &table, DataChunk &chunk, const vector<column_t> &column_ids);
 	//! Verify constraints with a chunk from the Delete containing all columns of the table
@@ -241,6 +257,11 @@ private:
 	                              idx_t max_row);
 	bool ScanBaseTable(Transaction &transaction, DataChunk &result, TableScanState &state);
 
+	//! Returns the run of complete row groups without updates within [row_start, row_start + count)
+	vector<RowGroup *> GetCompleteRowGroups(idx_t row_start, idx_t count);
+	//! Write the data of the row groups to the database file, and their metadata to the WAL
+	void WriteRowGroupData(WriteAheadLog &log, const vector<RowGroup *> &write_row_groups);
+
 	//! The CreateIndexScan is a special scan that is used to create an index on the table, it keeps locks on the table
 	void InitializeCreateIndexScan(CreateIndexScanState &state, const vector<column_t> &column_ids);
 	bool ScanCreateIndex(CreateIndexScanState &state, DataChunk &result, TableScanType type);
@@ -248,6 +269,9 @@ private:
 private:
 	//! Lock for appending entries to the table
 	mutex append_lock;
+	//! Optimistic appends hold this lock shared while they write to their reserved row groups, altering the table
+	//! obtains it exclusively to wait for them
+	StorageLock optimistic_append_lock;
 	//! The number of rows in the table
 	atomic<idx_t> total_rows;
 	//! The segment trees holding the various row_groups of the table
@@ -18,7 +18,10 @@ namespace duckdb {
 class InMemoryBlockManager : public BlockManager {
 public:
 	// LCOV_EXCL_START
-	void StartCheckpoint() override {
+	void StartCheckpoint(bool compact_file) override {
+		throw InternalException("Cannot perform IO in in-memory database!");
+	}
+	bool ShouldRelocateBlock(block_id_t block_id) override {
 		throw InternalException("Cannot perform IO in in-memory database!");
 	}
 	unique_ptr<Block> CreateBlock(block_id_t block_id) override {
@@ -36,6 +39,15 @@ public:
 	void IncreaseBlockReferenceCount(block_id_t block_id) override {
 		throw InternalException("Cannot perform IO in in-memory database!");
 	}
+	void MarkBlockAsUsed(block_id_t block_id, uint32_t reference_count) override {
+		throw InternalException("Cannot perform IO in in-memory database!");
+	}
+	void StartRecordingAllocations() override {
+		throw InternalException("Cannot perform IO in in-memory database!");
+	}
+	vector<pair<block_id_t, uint32_t>> StopRecordingAllocations() override {
+		throw InternalException("Cannot perform IO in in-memory database!");
+	}
 	block_id_t GetMetaBlock() override {
 		throw InternalException("Cannot perform IO in in-memory database!");
 	}
@@ -48,6 +60,9 @@ public:
 	void WriteHeader(DatabaseHeader header) override {
 		throw InternalException("Cannot perform IO in in-memory database!");
 	}
+	void Sync() override {
+		throw InternalException("Cannot perform IO in in-memory database!");
+	}
 	idx_t TotalBlocks() override {
 		throw InternalException("Cannot perform IO in in-memory database!");
 	}
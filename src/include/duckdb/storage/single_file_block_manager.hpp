@@ -15,6 +15,7 @@
 #include "duckdb/common/unordered_set.hpp"
 #include "duckdb/common/set.hpp"
 #include "duckdb/common/vector.hpp"
+#include "duckdb/common/mutex.hpp"
 
 namespace duckdb {
 class DatabaseInstance;
@@ -27,7 +28,9 @@ class SingleFileBlockManager : public BlockManager {
 public:
 	SingleFileBlockManager(DatabaseInstance &db, string path, bool read_only, bool create_new, bool use_direct_io);
 
-	void StartCheckpoint() override;
+	void StartCheckpoint(bool compact_file) override;
+	//! Returns whether or not the block is past the amount of blocks in use, when compacting the file
+	bool ShouldRelocateBlock(block_id_t block_id) override;
 	//! Creates a new Block using the specified block_id and returns a pointer
 	unique_ptr<Block> CreateBlock(block_id_t block_id) override;
 	//! Return the next free block id
@@ -38,6 +41,12 @@ public:
 	void MarkBlockAsModified(block_id_t block_id) override;
 	//! Increase the reference count of a block. The block should hold at least one reference
 	void IncreaseBlockReferenceCount(block_id_t block_id) override;
+	//! Mark a block that was written outside of a checkpoint as used
+	void MarkBlockAsUsed(block_id_t block_id, uint32_t reference_count) override;
+	//! Start recording the blocks that are allocated
+	void StartRecordingAllocations() override;
+	//! Stop recording the blocks that are allocated, returns the recorded blocks and their reference counts
+	vector<pair<block_id_t, uint32_t>> StopRecordingAllocations() override;
 	//! Return the meta block id
 	block_id_t GetMetaBlock() override;
 	//! Read the content of the block from disk
@@ -46,6 +55,8 @@ public:
 	void Write(FileBuffer &block, block_id_t block_id) override;
 	//! Write the header to disk, this is the final step of the checkpointing process
 	void WriteHeader(DatabaseHeader header) override;
+	//! Sync the database file to disk
+	void Sync() override;
 
 	//! Returns the number of total blocks
 	idx_t TotalBlocks() override {
@@ -88,11 +99,19 @@ private:
 	block_id_t max_block;
 	//! The block id where the free list can be found
 	block_id_t free_list_id;
+	//! The blocks starting from this id are relocated by the current checkpoint
+	block_id_t relocate_from;
 	//! The current header iteration count
 	uint64_t iteration_count;
 	//! Whether or not the db is opened in read-only mode
 	bool read_only;
 	//! Whether or not to use Direct IO to read the blocks
 	bool use_direct_io;
+	//! Lock for the free list and the block reference counts, blocks are allocated by parallel checkpoint tasks
+	mutex block_lock;
+	//! Whether or not the allocated blocks are recorded
+	bool recording_allocations;
+	//! The blocks that were allocated since StartRecordingAllocations was called
+	vector<block_id_t> recorded_allocations;
 };
 } // namespace duckdb
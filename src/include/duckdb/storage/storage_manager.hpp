@@ -49,7 +49,7 @@ public:
 		return db;
 	}
 
-	void CreateCheckpoint(bool delete_wal = false, bool force_checkpoint = false);
+	void CreateCheckpoint(bool delete_wal = false, bool force_checkpoint = false, bool compact_file = false);
 
 	string GetDBPath() {
 		return path;
@@ -55,6 +55,8 @@ struct TableAppendState {
 
 	RowGroupAppendState row_group_append_state;
 	unique_lock<mutex> append_lock;
+	//! The lock held by an optimistic append, which appends to the row groups reserved by InitializeOptimisticAppend
+	unique_ptr<StorageLockKey> optimistic_append_lock;
 	row_t row_start;
 	row_t current_row;
 	idx_t remaining_append_count;
@@ -37,7 +37,8 @@ public:
 	}
 
 	virtual void FlushSegment(unique_ptr<ColumnSegment> segment, idx_t segment_size);
-	virtual void FlushToDisk();
+	//! Write the data pointers of the column (and its child columns) to the serializer
+	virtual void WriteDataPointers(Serializer &serializer);
 };
 
 } // namespace duckdb
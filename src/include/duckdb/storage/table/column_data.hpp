@@ -17,6 +17,7 @@
 #include "duckdb/storage/statistics/segment_statistics.hpp"
 #include "duckdb/storage/table/column_checkpoint_state.hpp"
 #include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_set.hpp"
 
 namespace duckdb {
 class ColumnData;
@@ -100,6 +101,14 @@ public:
 	virtual void UpdateColumn(Transaction &transaction, const vector<column_t> &column_path, Vector &update_vector,
 	                          row_t *row_ids, idx_t update_count, idx_t depth);
 	virtual unique_ptr<BaseStatistics> GetUpdateStatistics();
+	//! Whether or not the column or any of its child columns holds updates
+	virtual bool HasUpdates();
+	//! Merges the updates of this column and of its child columns that are in [merge_columns] into their transient
+	//! segments, see MergeColumnUpdates. Only safe if no transaction can scan the column.
+	virtual void MergeUpdates(const unordered_set<ColumnData *> &merge_columns, double threshold);
+	//! Whether or not the updates of this column (but not of its child columns) can be merged into its segments: every
+	//! update is committed, all of its segments are transient and at least [threshold] of the rows are updated
+	bool CanMergeUpdates(double threshold);
 
 	virtual void CommitDropColumn();
 
@@ -125,6 +134,11 @@ public:
 protected:
 	//! Append a transient segment
 	void AppendTransientSegment(idx_t start_row);
+	//! Merges the updates of this column (but not of its child columns) into its transient segments, if every update
+	//! is committed and at least [threshold] of the rows are updated
+	void MergeColumnUpdates(double threshold);
+	//! See CanMergeUpdates, the update lock must be held
+	bool CanMergeUpdatesInternal(double threshold);
 
 	//! Scans a base vector from the column
 	idx_t ScanVector(ColumnScanState &state, Vector &result, idx_t remaining);
@@ -16,8 +16,10 @@
 #include "duckdb/storage/statistics/segment_statistics.hpp"
 #include "duckdb/common/enums/scan_options.hpp"
 #include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_set.hpp"
 
 namespace duckdb {
+class ColumnCheckpointState;
 class ColumnData;
 class DatabaseInstance;
 class DataTable;
@@ -98,6 +100,11 @@ public:
 	idx_t GetSelVector(Transaction &transaction, idx_t vector_idx, SelectionVector &sel_vector, idx_t max_count);
 	idx_t GetCommittedSelVector(transaction_t start_time, transaction_t transaction_id, idx_t vector_idx,
 	                            SelectionVector &sel_vector, idx_t max_count);
+	//! Gets the rows of the vector that are written by a checkpoint (i.e. that are not deleted by a committed
+	//! transaction)
+	idx_t GetCheckpointSelVector(idx_t vector_idx, SelectionVector &sel_vector, idx_t max_count);
+	//! Returns the amount of rows of the row group that are written by a checkpoint
+	idx_t GetCheckpointRowCount();
 
 	//! For a specific row, returns true if it should be used for the transaction and false otherwise.
 	bool Fetch(Transaction &transaction, idx_t row);
@@ -115,11 +122,28 @@ public:
 	//! Delete the given set of rows in the version manager
 	idx_t Delete(Transaction &transaction, DataTable *table, row_t *row_ids, idx_t count);
 
-	RowGroupPointer Checkpoint(TableDataWriter &writer, vector<unique_ptr<BaseStatistics>> &global_stats);
+	//! Write the data of a single column to disk. The columns can be written in parallel, this does not write any
+	//! metadata to the writer.
+	unique_ptr<ColumnCheckpointState> CheckpointColumn(TableDataWriter &writer, idx_t column_idx);
+	//! Write the metadata of the row group, given the checkpoint states of all of its columns
+	RowGroupPointer Checkpoint(TableDataWriter &writer, vector<unique_ptr<BaseStatistics>> &global_stats,
+	                           vector<unique_ptr<ColumnCheckpointState>> states);
 	static void Serialize(RowGroupPointer &pointer, Serializer &serializer);
 	static RowGroupPointer Deserialize(Deserializer &source, const vector<ColumnDefinition> &columns);
+	//! Write the statistics and the data pointers of the columns of the row group, given the checkpoint states of all
+	//! of its columns
+	void SerializeColumnData(vector<unique_ptr<ColumnCheckpointState>> &states, Serializer &serializer);
+	//! Read a row group written by SerializeColumnData, the rows of the row group are appended by the transaction
+	static unique_ptr<RowGroup> DeserializeColumnData(Transaction &transaction, DataTableInfo &table_info,
+	                                                  const vector<LogicalType> &types, Deserializer &source);
+	//! Whether or not any of the columns of the row group holds updates
+	bool HasUpdates();
+	//! Merge the updates of the columns in [merge_columns] into their base data, see ColumnData::MergeUpdates
+	void MergeUpdates(const unordered_set<ColumnData *> &merge_columns, double threshold);
 
 	void InitializeAppend(Transaction &transaction, RowGroupAppendState &append_state, idx_t remaining_append_count);
+	//! Initialize an append of rows that are visible to all transactions, no version info is added for the rows
+	void InitializeAppend(RowGroupAppendState &append_state);
 	void Append(RowGroupAppendState &append_state, DataChunk &chunk, idx_t append_count);
 
 	void Update(Transaction &transaction, DataChunk &updates, row_t *ids, idx_t offset, idx_t count,
@@ -46,6 +46,8 @@ public:
 	void UpdateColumn(Transaction &transaction, const vector<column_t> &column_path, Vector &update_vector,
 	                  row_t *row_ids, idx_t update_count, idx_t depth) override;
 	unique_ptr<BaseStatistics> GetUpdateStatistics() override;
+	bool HasUpdates() override;
+	void MergeUpdates(const unordered_set<ColumnData *> &merge_columns, double threshold) override;
 
 	void CommitDropColumn() override;
 
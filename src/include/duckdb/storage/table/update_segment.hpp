@@ -33,6 +33,9 @@ public:
 	bool HasUpdates(idx_t vector_index) const;
 	bool HasUpdates(idx_t start_row_idx, idx_t end_row_idx);
 	void ClearUpdates();
+	//! Returns the amount of updated rows if all updates are committed and no transaction can observe the values they
+	//! replaced anymore (i.e. the updates can be merged into the base data), or 0 otherwise
+	idx_t GetMergeableUpdateCount();
 
 	void FetchUpdates(Transaction &transaction, idx_t vector_index, Vector &result);
 	void FetchCommitted(idx_t vector_index, Vector &result);
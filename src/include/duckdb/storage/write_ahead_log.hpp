@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/helper.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/common/enums/wal_type.hpp"
 #include "duckdb/common/serializer/buffered_file_writer.hpp"
@@ -18,6 +20,8 @@
 #include "duckdb/catalog/catalog_entry/scalar_macro_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/table_macro_catalog_entry.hpp"
 
+#include <condition_variable>
+
 namespace duckdb {
 
 struct AlterInfo;
@@ -46,6 +50,8 @@ public:
 	bool initialized;
 	//! Skip writing to the WAL
 	bool skip_writing;
+	//! Whether or not complete row groups can be written to the database file instead of to the WAL
+	bool write_row_groups;
 
 public:
 	//! Replay the WAL
@@ -95,12 +101,21 @@ public:
 	//! -> 1 (second subcolumn of struct)
 	//! -> 0 (first subcolumn of INT)
 	void WriteUpdate(DataChunk &chunk, const vector<column_t> &column_path);
+	//! Write the metadata of row groups that have been written to the database file directly
+	void WriteRowGroupData(BufferedSerializer &row_group_data);
 
 	//! Truncate the WAL to a previous size, and clear anything currently set in the writer
 	void Truncate(int64_t size);
 	//! Delete the WAL file on disk. The WAL should not be used after this point.
 	void Delete();
+	//! Write a flush marker and sync all changes made to the WAL to disk
 	void Flush();
+	//! Write a flush marker and write all changes made to the WAL to the file, without syncing the file to disk.
+	//! Returns the position that has to be passed to GroupSync for the changes to become durable.
+	idx_t FlushWithoutSync();
+	//! Sync the WAL to disk up to at least the given position. Concurrent commits share a single sync: if no sync is
+	//! running, the caller waits for the window (in microseconds) so other commits can join, then syncs for all.
+	void GroupSync(idx_t position, idx_t window);
 
 	void WriteCheckpoint(block_id_t meta_block);
 
@@ -108,6 +123,17 @@ private:
 	DatabaseInstance &database;
 	unique_ptr<BufferedFileWriter> writer;
 	string wal_path;
+
+	//! Lock protecting the group commit state
+	mutex sync_lock;
+	//! Signalled whenever a group sync finishes
+	std::condition_variable sync_finished;
+	//! Whether or not a group sync is currently running
+	bool sync_running;
+	//! The position up to which the WAL is synced to disk
+	idx_t synced_position;
+	//! The position up to which the WAL has been written to the file
+	atomic<idx_t> flushed_position;
 };
 
 } // namespace duckdb
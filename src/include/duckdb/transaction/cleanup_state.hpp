@@ -10,8 +10,10 @@
 
 #include "duckdb/transaction/undo_buffer.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/common/unordered_set.hpp"
 
 namespace duckdb {
+class ColumnData;
 class DataTable;
 
 struct DeleteInfo;
@@ -19,13 +21,15 @@ struct UpdateInfo;
 
 class CleanupState {
 public:
-	CleanupState();
+	explicit CleanupState(unordered_set<ColumnData *> &merge_columns);
 	~CleanupState();
 
 public:
 	void CleanupEntry(UndoFlags type, data_ptr_t data);
 
 private:
+	//! The columns of which the committed updates can be merged into the base data
+	unordered_set<ColumnData *> &merge_columns;
 	// data for index cleanup
 	DataTable *current_table;
 	DataChunk chunk;
@@ -102,6 +102,8 @@ private:
 	unordered_map<DataTable *, shared_ptr<LocalTableStorage>> table_storage;
 
 	void Flush(DataTable &table, LocalTableStorage &storage);
+	//! Append the complete row groups in the local storage to the table, without holding the append lock of the table
+	void FlushRowGroups(DataTable &table, LocalTableStorage &storage);
 };
 
 } // namespace duckdb
@@ -39,7 +39,7 @@ public:
 	            timestamp_t start_timestamp, idx_t catalog_version)
 	    : context(move(context)), start_time(start_time), transaction_id(transaction_id), commit_id(0),
 	      highest_active_query(0), active_query(MAXIMUM_QUERY_ID), start_timestamp(start_timestamp),
-	      catalog_version(catalog_version), storage(*this), is_invalidated(false) {
+	      catalog_version(catalog_version), storage(*this), is_invalidated(false), wal_sync_position(0) {
 	}
 
 	weak_ptr<ClientContext> context;
@@ -64,6 +64,9 @@ public:
 	unordered_map<SequenceCatalogEntry *, SequenceValue> sequence_usage;
 	//! Whether or not the transaction has been invalidated
 	bool is_invalidated;
+	//! With group commit: the position up to which the WAL has to be synced for the commit to be durable (0 if the
+	//! commit does not need a sync)
+	idx_t wal_sync_position;
 
 public:
 	static Transaction &GetTransaction(ClientContext &context);
@@ -71,8 +74,9 @@ public:
 	void PushCatalogEntry(CatalogEntry *entry, data_ptr_t extra_data = nullptr, idx_t extra_data_size = 0);
 
 	//! Commit the current transaction with the given commit identifier. Returns an error message if the transaction
-	//! commit failed, or an empty string if the commit was sucessful
-	string Commit(DatabaseInstance &db, transaction_t commit_id, bool checkpoint) noexcept;
+	//! commit failed, or an empty string if the commit was sucessful. If write_row_groups is set, the complete row
+	//! groups appended by the transaction can be written to the database file directly instead of to the WAL.
+	string Commit(DatabaseInstance &db, transaction_t commit_id, bool checkpoint, bool write_row_groups) noexcept;
 	//! Returns whether or not a commit of this transaction should trigger an automatic checkpoint
 	bool AutomaticCheckpoint(DatabaseInstance &db);
 
@@ -80,9 +84,10 @@ public:
 	void Rollback() noexcept {
 		undo_buffer.Rollback();
 	}
-	//! Cleanup the undo buffer
-	void Cleanup() {
-		undo_buffer.Cleanup();
+	//! Cleanup the undo buffer. The columns with cleaned up updates that can be merged into the base data are added to
+	//! merge_columns: they are merged once no transaction is running.
+	void Cleanup(unordered_set<ColumnData *> &merge_columns) {
+		undo_buffer.Cleanup(merge_columns);
 	}
 
 	void Invalidate() {
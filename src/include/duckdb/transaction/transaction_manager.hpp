@@ -11,16 +11,22 @@
 #include "duckdb/catalog/catalog_set.hpp"
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/mutex.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/common/unordered_set.hpp"
 #include "duckdb/common/vector.hpp"
 
 #include "duckdb/common/atomic.hpp"
 
+#include <condition_variable>
+
 namespace duckdb {
 
 class ClientContext;
 class Catalog;
 struct ClientLockWrapper;
+class ColumnData;
 class DatabaseInstance;
+class DataTable;
 class Transaction;
 
 struct StoredCatalogSet {
@@ -57,15 +63,45 @@ public:
 	}
 
 	void Checkpoint(ClientContext &context, bool force = false);
+	//! Vacuum the given tables, and checkpoint the database while compacting the database file
+	void Vacuum(ClientContext &context, const vector<DataTable *> &tables);
+	//! Finish a scheduled background checkpoint and stop the background thread. Must be called before the storage of
+	//! the database is destroyed.
+	void StopBackgroundCheckpoints();
 
 	static TransactionManager &Get(ClientContext &context);
 	static TransactionManager &Get(DatabaseInstance &db);
 
 private:
+	//! Checkpoint the database once no other transaction can observe it. If vacuum is set, the given tables are
+	//! vacuumed first and the checkpoint compacts the database file.
+	void CheckpointInternal(ClientContext &context, bool force, bool vacuum, const vector<DataTable *> &vacuum_tables);
 	bool CanCheckpoint(Transaction *current = nullptr);
 	//! Remove the given transaction from the list of active transactions
 	void RemoveTransaction(Transaction *transaction) noexcept;
-	void LockClients(vector<ClientLockWrapper> &client_locks, ClientContext &context);
+	//! Lock all clients except for the given one (if any)
+	void LockClients(vector<ClientLockWrapper> &client_locks, ClientContext *context);
+	//! Lock all clients if none of them is running a query, returns false if a client is busy
+	bool TryLockClients(vector<ClientLockWrapper> &client_locks);
+	//! Whether or not automatic checkpoints can be run by the background checkpoint thread
+	bool CanCheckpointInBackground();
+	//! Schedule an automatic checkpoint and/or merging the committed updates on the background thread, starting the
+	//! thread if needed
+	void ScheduleBackgroundTasks(bool checkpoint, bool merge_updates);
+	//! The loop of the background thread, which runs the scheduled checkpoints and merges until it is stopped
+	void BackgroundLoop();
+	//! Run an automatic checkpoint in the background, if the database can be checkpointed. Returns false if it has to
+	//! be retried later because other clients are running queries.
+	bool TryBackgroundCheckpoint();
+	//! Merge the committed updates in the background, if no transaction is running. Returns false if it has to be
+	//! retried later because other clients are running queries.
+	bool TryBackgroundMerge();
+	//! Merge the committed updates of the given columns into their base data. All clients other than the given one
+	//! must be locked in [client_locks], and the transaction lock must be held.
+	void MergeUpdates(const unordered_set<ColumnData *> &columns, vector<ClientLockWrapper> &client_locks,
+	                  ClientContext *context);
+	//! Merge the committed updates in the connection that runs a CHECKPOINT statement on an in-memory database
+	void MergeUpdates(ClientContext &context);
 
 	//! The database instance
 	DatabaseInstance &db;
@@ -87,10 +123,33 @@ private:
 	vector<unique_ptr<Transaction>> old_transactions;
 	//! Catalog sets
 	vector<StoredCatalogSet> old_catalog_sets;
+	//! The columns with cleaned up updates that can be merged, their committed updates are merged once no transaction
+	//! is running
+	unordered_set<ColumnData *> merge_columns;
 	//! The lock used for transaction operations
 	mutex transaction_lock;
 
 	bool thread_is_checkpointing;
+
+	//! Set when a background checkpoint failed: automatic checkpoints then run in the committing connection, which
+	//! reports their errors, until one of them succeeds. Protected by the transaction lock.
+	bool background_failed;
+	//! Set when merging the committed updates in the background failed: the updates are then only merged by a
+	//! CHECKPOINT statement, which reports the error, until one of them succeeds. Protected by the transaction lock.
+	bool merge_failed;
+
+	//! The lock protecting the background checkpoint state
+	mutex background_lock;
+	//! Signalled when a background checkpoint or merge is scheduled, or when the background thread is stopped
+	std::condition_variable background_signal;
+	//! The thread that runs the background checkpoints and merges, started by the first one
+	thread background_thread;
+	//! Whether or not a background checkpoint is scheduled
+	bool background_scheduled;
+	//! Whether or not merging the committed updates in the background is scheduled
+	bool background_merge_scheduled;
+	//! Set on shutdown, the background thread finishes the scheduled checkpoint and exits
+	bool background_stopped;
 };
 
 } // namespace duckdb
@@ -10,9 +10,11 @@
 
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/enums/undo_flags.hpp"
+#include "duckdb/common/unordered_set.hpp"
 
 namespace duckdb {
 
+class ColumnData;
 class WriteAheadLog;
 
 struct UndoChunk {
@@ -49,8 +51,8 @@ public:
 	bool ChangesMade();
 	idx_t EstimatedSize();
 
-	//! Cleanup the undo buffer
-	void Cleanup();
+	//! Cleanup the undo buffer, the columns with cleaned up updates that can be merged are added to merge_columns
+	void Cleanup(unordered_set<ColumnData *> &merge_columns);
 	//! Commit the changes made in the UndoBuffer: should be called on commit
 	void Commit(UndoBuffer::IteratorState &iterator_state, WriteAheadLog *log, transaction_t commit_id);
 	//! Revert committed changes made in the UndoBuffer up until the currently committed state
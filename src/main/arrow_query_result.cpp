@@ -0,0 +1,50 @@
+#include "duckdb/main/arrow_query_result.hpp"
+#include "duckdb/common/to_string.hpp"
+
+namespace duckdb {
+
+ArrowQueryResult::ArrowQueryResult(StatementType statement_type, StatementProperties properties,
+                                   vector<LogicalType> types, vector<string> names,
+                                   const shared_ptr<ClientContext> &context)
+    : QueryResult(QueryResultType::ARROW_RESULT, statement_type, properties, move(types), move(names)),
+      context(context) {
+}
+
+ArrowQueryResult::ArrowQueryResult(string error) : QueryResult(QueryResultType::ARROW_RESULT, move(error)) {
+}
+
+unique_ptr<DataChunk> ArrowQueryResult::FetchRaw() {
+	throw InvalidInputException("Arrow query results can only be consumed as Arrow record batches");
+}
+
+string ArrowQueryResult::ToString() {
+	string result;
+	if (success) {
+		result = HeaderToString();
+		result += "[ Rows: " + to_string(RowCount()) + "]\n";
+		result += "[ Record Batches: " + to_string(arrays.size() - array_index) + "]\n";
+	} else {
+		result = error + "\n";
+	}
+	return result;
+}
+
+unique_ptr<ArrowArrayWrapper> ArrowQueryResult::FetchArray() {
+	if (!success) {
+		throw InvalidInputException("Attempting to fetch from an unsuccessful query result\nError: %s", error);
+	}
+	if (array_index >= arrays.size()) {
+		return nullptr;
+	}
+	return move(arrays[array_index++]);
+}
+
+idx_t ArrowQueryResult::RowCount() const {
+	idx_t count = 0;
+	for (idx_t i = array_index; i < arrays.size(); i++) {
+		count += arrays[i]->arrow_array.length;
+	}
+	return count;
+}
+
+} // namespace duckdb
@@ -1,18 +1,27 @@
 #include "duckdb/main/capi_internal.hpp"
+#include "duckdb/execution/operator/helper/physical_arrow_collector.hpp"
+#include "duckdb/main/arrow_query_result.hpp"
 
+using duckdb::ArrowQueryResult;
 using duckdb::ArrowResultWrapper;
 using duckdb::Connection;
 using duckdb::DataChunk;
+using duckdb::idx_t;
 using duckdb::LogicalType;
 using duckdb::MaterializedQueryResult;
+using duckdb::PhysicalArrowCollector;
 using duckdb::PreparedStatementWrapper;
 using duckdb::QueryResult;
 using duckdb::QueryResultType;
 
+//! The approximate number of rows in the record batches of the results
+static constexpr idx_t ARROW_RESULT_BATCH_SIZE = 1000000;
+
 duckdb_state duckdb_query_arrow(duckdb_connection connection, const char *query, duckdb_arrow *out_result) {
 	Connection *conn = (Connection *)connection;
 	auto wrapper = new ArrowResultWrapper();
-	wrapper->result = conn->Query(query);
+	wrapper->result = PhysicalArrowCollector::ExecuteArrow(*conn->context, ARROW_RESULT_BATCH_SIZE,
+	                                                       [&]() { return conn->context->Query(query, false); });
 	*out_result = (duckdb_arrow)wrapper;
 	return wrapper->result->success ? DuckDBSuccess : DuckDBError;
 }
@@ -32,6 +41,16 @@ duckdb_state duckdb_query_arrow_array(duckdb_arrow result, duckdb_arrow_array *o
 		return DuckDBSuccess;
 	}
 	auto wrapper = (ArrowResultWrapper *)result;
+	if (wrapper->result->type == QueryResultType::ARROW_RESULT && wrapper->result->success) {
+		// the record batch was built while the query was executed: hand it over
+		auto array = ((ArrowQueryResult &)*wrapper->result).FetchArray();
+		if (!array) {
+			return DuckDBSuccess;
+		}
+		*((ArrowArray *)*out_array) = array->arrow_array;
+		array->arrow_array.release = nullptr;
+		return DuckDBSuccess;
+	}
 	auto success = wrapper->result->TryFetch(wrapper->current_chunk, wrapper->result->error);
 	if (!success) { // LCOV_EXCL_START
 		return DuckDBError;
@@ -45,7 +64,10 @@ duckdb_state duckdb_query_arrow_array(duckdb_arrow result, duckdb_arrow_array *o
 
 idx_t duckdb_arrow_row_count(duckdb_arrow result) {
 	auto wrapper = (ArrowResultWrapper *)result;
-	return wrapper->result->collection.Count();
+	if (wrapper->result->type == QueryResultType::ARROW_RESULT) {
+		return ((ArrowQueryResult &)*wrapper->result).RowCount();
+	}
+	return ((MaterializedQueryResult &)*wrapper->result).collection.Count();
 }
 
 idx_t duckdb_arrow_column_count(duckdb_arrow result) {
@@ -55,10 +77,15 @@ idx_t duckdb_arrow_column_count(duckdb_arrow result) {
 
 idx_t duckdb_arrow_rows_changed(duckdb_arrow result) {
 	auto wrapper = (ArrowResultWrapper *)result;
+	if (wrapper->result->type != QueryResultType::MATERIALIZED_RESULT) {
+		// only statements that return a query result are collected as arrow record batches
+		return 0;
+	}
+	auto &materialized = (MaterializedQueryResult &)*wrapper->result;
 	idx_t rows_changed = 0;
-	idx_t row_count = wrapper->result->collection.Count();
-	if (row_count > 0 && wrapper->result->properties.return_type == duckdb::StatementReturnType::CHANGED_ROWS) {
-		auto row_changes = wrapper->result->GetValue(0, 0);
+	idx_t row_count = materialized.collection.Count();
+	if (row_count > 0 && materialized.properties.return_type == duckdb::StatementReturnType::CHANGED_ROWS) {
+		auto row_changes = materialized.GetValue(0, 0);
 		if (!row_changes.IsNull() && row_changes.TryCastAs(LogicalType::BIGINT)) {
 			rows_changed = row_changes.GetValue<int64_t>();
 		}
@@ -93,9 +120,10 @@ duckdb_state duckdb_execute_prepared_arrow(duckdb_prepared_statement prepared_st
 		    wrapper->statement->context->config.set_variables["TimeZone"].GetValue<std::string>();
 	}
 
-	auto result = wrapper->statement->Execute(wrapper->values, false);
-	D_ASSERT(result->type == QueryResultType::MATERIALIZED_RESULT);
-	arrow_wrapper->result = duckdb::unique_ptr_cast<QueryResult, MaterializedQueryResult>(move(result));
+	arrow_wrapper->result =
+	    PhysicalArrowCollector::ExecuteArrow(*wrapper->statement->context, ARROW_RESULT_BATCH_SIZE,
+	                                         [&]() { return wrapper->statement->Execute(wrapper->values, false); });
+	D_ASSERT(arrow_wrapper->result->type != QueryResultType::STREAM_RESULT);
 	*out_result = (duckdb_arrow)arrow_wrapper;
 	return arrow_wrapper->result->success ? DuckDBSuccess : DuckDBError;
 }
@@ -10,6 +10,7 @@
 #include "duckdb/execution/physical_plan_generator.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/materialized_query_result.hpp"
+#include "duckdb/main/plan_cache.hpp"
 #include "duckdb/main/client_data.hpp"
 #include "duckdb/main/query_result.hpp"
 #include "duckdb/main/stream_query_result.hpp"
@@ -252,7 +253,15 @@ shared_ptr<PreparedStatementData> ClientContext::CreatePreparedStatement(ClientC
                                                                          unique_ptr<SQLStatement> statement,
                                                                          vector<Value> *values) {
 	StatementType statement_type = statement->type;
-	auto result = make_shared<PreparedStatementData>(statement_type);
+	auto result = make_unique<PreparedStatementData>(statement_type);
+	// a SELECT statement that makes up the complete query can be kept in the plan cache of the database
+	bool cache_plan = !values && statement_type == StatementType::SELECT_STATEMENT && !query.empty() &&
+	                  statement->stmt_location == 0 && statement->stmt_length == query.size() &&
+	                  PlanCache::PlanCacheEnabled(*this);
+	unique_ptr<SQLStatement> unbound_statement;
+	if (cache_plan) {
+		unbound_statement = statement->Copy();
+	}
 
 	auto &profiler = QueryProfiler::Get(*this);
 	profiler.StartPhase("planner");
@@ -276,10 +285,19 @@ shared_ptr<PreparedStatementData> ClientContext::CreatePreparedStatement(ClientC
 	result->types = planner.types;
 	result->value_map = move(planner.value_map);
 	result->catalog_version = Transaction::GetTransaction(*this).catalog_version;
+	if (cache_plan) {
+		cache_plan = result->properties.bound_all_parameters &&
+		             result->catalog_version == Catalog::GetCatalog(*this).GetCatalogVersion() &&
+		             PlanCache::CanCachePlan(*plan);
+	}
 
 	if (config.enable_optimizer) {
 		profiler.StartPhase("optimizer");
 		Optimizer optimizer(*planner.binder, *this);
+		if (cache_plan) {
+			// cached plans are used on data that changes: they cannot rely on the statistics of the current data
+			optimizer.disabled_optimizers.insert(OptimizerType::STATISTICS_PROPAGATION);
+		}
 		plan = optimizer.Optimize(move(plan));
 		D_ASSERT(plan);
 		profiler.EndPhase();
@@ -289,6 +307,11 @@ shared_ptr<PreparedStatementData> ClientContext::CreatePreparedStatement(ClientC
 #endif
 	}
 
+	if (cache_plan) {
+		// neither can they hold the row ids of an index lookup
+		cache_plan = !PlanCache::HasIndexScan(*plan);
+	}
+
 	profiler.StartPhase("physical_planner");
 	// now convert logical query plan into a physical query plan
 	PhysicalPlanGenerator physical_planner(*this);
@@ -299,7 +322,11 @@ shared_ptr<PreparedStatementData> ClientContext::CreatePreparedStatement(ClientC
 	D_ASSERT(!physical_plan->ToString().empty());
 #endif
 	result->plan = move(physical_plan);
-	return result;
+	if (cache_plan) {
+		result->unbound_statement = move(unbound_statement);
+		return PlanCache::Get(*this).AddPlan(*this, query, move(result));
+	}
+	return move(result);
 }
 
 double ClientContext::GetProgress() {
@@ -454,6 +481,11 @@ unique_ptr<PreparedStatement> ClientContext::Prepare(unique_ptr<SQLStatement> st
 
 unique_ptr<PreparedStatement> ClientContext::Prepare(const string &query) {
 	auto lock = LockContext();
+	auto cached_plan = GetCachedPlan(*lock, query);
+	if (cached_plan) {
+		auto n_param = cached_plan->unbound_statement->n_param;
+		return make_unique<PreparedStatement>(shared_from_this(), move(cached_plan), query, n_param);
+	}
 	// prepare the query
 	try {
 		InitialCleanup(*lock);
@@ -483,6 +515,20 @@ unique_ptr<PendingQueryResult> ClientContext::PendingQueryPreparedInternal(Clien
 	return PendingStatementOrPreparedStatementInternal(lock, query, nullptr, prepared, parameters);
 }
 
+shared_ptr<PreparedStatementData> ClientContext::GetCachedPlan(ClientContextLock &lock, const string &query) {
+	try {
+		// clean up the previous query first: its plan might be returned to the cache
+		InitialCleanup(lock);
+		if (!PlanCache::PlanCacheEnabled(*this)) {
+			return nullptr;
+		}
+		return PlanCache::Get(*this).GetPlan(*this, query);
+	} catch (std::exception &ex) {
+		// the query is planned as usual, which reports the error
+		return nullptr;
+	}
+}
+
 unique_ptr<PendingQueryResult> ClientContext::PendingQuery(const string &query,
                                                            shared_ptr<PreparedStatementData> &prepared,
                                                            PendingQueryParameters parameters) {
@@ -669,6 +715,17 @@ unique_ptr<QueryResult> ClientContext::Query(unique_ptr<SQLStatement> statement,
 unique_ptr<QueryResult> ClientContext::Query(const string &query, bool allow_stream_result) {
 	auto lock = LockContext();
 
+	auto cached_plan = GetCachedPlan(*lock, query);
+	if (cached_plan) {
+		PendingQueryParameters parameters;
+		parameters.allow_stream_result = allow_stream_result;
+		auto pending_query = PendingQueryPreparedInternal(*lock, query, cached_plan, parameters);
+		if (!pending_query->success) {
+			return make_unique<MaterializedQueryResult>(pending_query->error);
+		}
+		return ExecutePendingQueryInternal(*lock, *pending_query);
+	}
+
 	string error;
 	vector<unique_ptr<SQLStatement>> statements;
 	if (!ParseStatements(*lock, query, statements, error)) {
@@ -727,6 +784,13 @@ bool ClientContext::ParseStatements(ClientContextLock &lock, const string &query
 unique_ptr<PendingQueryResult> ClientContext::PendingQuery(const string &query, bool allow_stream_result) {
 	auto lock = LockContext();
 
+	auto cached_plan = GetCachedPlan(*lock, query);
+	if (cached_plan) {
+		PendingQueryParameters parameters;
+		parameters.allow_stream_result = allow_stream_result;
+		return PendingQueryPreparedInternal(*lock, query, cached_plan, parameters);
+	}
+
 	string error;
 	vector<unique_ptr<SQLStatement>> statements;
 	if (!ParseStatements(*lock, query, statements, error)) {
@@ -6,6 +6,7 @@
 #include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/storage/object_cache.hpp"
+#include "duckdb/main/plan_cache.hpp"
 #include "duckdb/transaction/transaction_manager.hpp"
 #include "duckdb/main/connection_manager.hpp"
 #include "duckdb/function/compression_function.hpp"
@@ -28,6 +29,10 @@ DatabaseInstance::DatabaseInstance() {
 }
 
 DatabaseInstance::~DatabaseInstance() {
+	if (transaction_manager) {
+		// background checkpoints cannot run concurrently with the shutdown
+		transaction_manager->StopBackgroundCheckpoints();
+	}
 	if (Exception::UncaughtException()) {
 		return;
 	}
@@ -129,12 +134,13 @@ void DatabaseInstance::Initialize(const char *path, DBConfig *new_config) {
 	scheduler = make_unique<TaskScheduler>(*this);
 	object_cache = make_unique<ObjectCache>();
 	connection_manager = make_unique<ConnectionManager>();
+	plan_cache = make_shared<PlanCache>(config.plan_cache_size);
+
+	// the WAL replay and the checkpoint of the storage initialization run their tasks on the scheduler threads
+	scheduler->SetThreads(config.maximum_threads);
 
 	// initialize the database
 	storage->Initialize();
-
-	// only increase thread count after storage init because we get races on catalog otherwise
-	scheduler->SetThreads(config.maximum_threads);
 }
 
 DuckDB::DuckDB(const char *path, DBConfig *new_config) : instance(make_shared<DatabaseInstance>()) {
@@ -173,6 +179,10 @@ ObjectCache &DatabaseInstance::GetObjectCache() {
 	return *object_cache;
 }
 
+PlanCache &DatabaseInstance::GetPlanCache() {
+	return *plan_cache;
+}
+
 FileSystem &DatabaseInstance::GetFileSystem() {
 	return *config.file_system;
 }
@@ -230,6 +240,7 @@ void DatabaseInstance::Configure(DBConfig &new_config) {
 	config.replacement_scans = move(new_config.replacement_scans);
 	config.initialize_default_database = new_config.initialize_default_database;
 	config.disabled_optimizers = move(new_config.disabled_optimizers);
+	config.plan_cache_size = new_config.plan_cache_size;
 }
 
 DBConfig &DBConfig::GetConfig(ClientContext &context) {
@@ -0,0 +1,290 @@
+#include "duckdb/main/plan_cache.hpp"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
+#include "duckdb/function/table/table_scan.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/client_data.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/prepared_statement_data.hpp"
+#include "duckdb/planner/expression/bound_aggregate_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
+#include "duckdb/planner/logical_operator_visitor.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/transaction/transaction.hpp"
+
+namespace duckdb {
+
+PlanCache::PlanCache(idx_t capacity) : catalog_version(0), capacity(capacity), plan_count(0), access_counter(0) {
+}
+
+PlanCache &PlanCache::Get(ClientContext &context) {
+	return context.db->GetPlanCache();
+}
+
+static bool HasTemporaryObjects(ClientContext &context) {
+	// temporary objects are only visible to the connection that created them, and can shadow the objects that a
+	// plan of another connection refers to
+	auto &temporary_objects = *ClientData::Get(context).temporary_objects;
+	bool found = false;
+	for (auto type : {CatalogType::TABLE_ENTRY, CatalogType::SEQUENCE_ENTRY, CatalogType::SCALAR_FUNCTION_ENTRY,
+	                  CatalogType::TABLE_FUNCTION_ENTRY, CatalogType::TYPE_ENTRY}) {
+		temporary_objects.Scan(type, [&](CatalogEntry *entry) { found = true; });
+		if (found) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool PlanCache::PlanCacheEnabled(ClientContext &context) {
+	if (DBConfig::GetConfig(context).plan_cache_size == 0) {
+		return false;
+	}
+	if (ClientConfig::GetConfig(context).query_verification_enabled) {
+		return false;
+	}
+	return !HasTemporaryObjects(context);
+}
+
+bool PlanCache::CanCachePlan(LogicalOperator &op) {
+	if (op.type == LogicalOperatorType::LOGICAL_GET) {
+		// table functions other than the table scan (e.g. file readers) capture external state when they are bound
+		auto &get = (LogicalGet &)op;
+		if (!TableScanFunction::GetTableEntry(get.function, get.bind_data.get())) {
+			return false;
+		}
+	}
+	bool can_cache = true;
+	LogicalOperatorVisitor::EnumerateExpressions(op, [&](unique_ptr<Expression> *child) {
+		ExpressionIterator::EnumerateExpression(*child, [&](Expression &expr) {
+			FunctionData *bind_info = nullptr;
+			if (expr.expression_class == ExpressionClass::BOUND_FUNCTION) {
+				bind_info = ((BoundFunctionExpression &)expr).bind_info.get();
+			} else if (expr.expression_class == ExpressionClass::BOUND_AGGREGATE) {
+				bind_info = ((BoundAggregateExpression &)expr).bind_info.get();
+			}
+			if (bind_info && !bind_info->SupportsPlanCache()) {
+				can_cache = false;
+			}
+		});
+	});
+	if (!can_cache) {
+		return false;
+	}
+	for (auto &child : op.children) {
+		if (!CanCachePlan(*child)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool PlanCache::HasIndexScan(LogicalOperator &op) {
+	if (op.type == LogicalOperatorType::LOGICAL_GET) {
+		// the plan was checked by CanCachePlan before it was optimized: it only holds table scans
+		// lookups of prepared statement parameters are only done when the plan is executed
+		auto &bind_data = (TableScanBindData &)*((LogicalGet &)op).bind_data;
+		if (bind_data.is_index_scan && !bind_data.lookup_index) {
+			return true;
+		}
+	}
+	for (auto &child : op.children) {
+		if (HasIndexScan(*child)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static string GetTrimmedQuery(const string &query) {
+	auto trimmed = query;
+	StringUtil::Trim(trimmed);
+	return trimmed;
+}
+
+string PlanCache::GetQueryKey(const string &query) {
+	if (query.find_first_of("$\\") != string::npos) {
+		// dollar-quoted strings and escaped quotes are not tracked below: do not normalize queries that can hold them
+		return GetTrimmedQuery(query);
+	}
+	string result;
+	result.reserve(query.size());
+	char quote = '\0';
+	bool pending_space = false;
+	for (idx_t i = 0; i < query.size(); i++) {
+		char c = query[i];
+		if (quote != '\0') {
+			// inside a string literal or a quoted identifier: keep the text as-is
+			result += c;
+			if (c == quote) {
+				quote = '\0';
+			}
+			continue;
+		}
+		if (StringUtil::CharacterIsSpace(c)) {
+			pending_space = !result.empty();
+			continue;
+		}
+		if (i + 1 < query.size() && ((c == '-' && query[i + 1] == '-') || (c == '/' && query[i + 1] == '*'))) {
+			// comments can swallow line breaks: do not normalize queries that contain them
+			return GetTrimmedQuery(query);
+		}
+		if (pending_space) {
+			result += ' ';
+			pending_space = false;
+		}
+		if (c == '\'' || c == '"') {
+			quote = c;
+		}
+		result += c;
+	}
+	while (!result.empty() && (result.back() == ';' || result.back() == ' ')) {
+		result.pop_back();
+	}
+	return result;
+}
+
+string PlanCache::GetSettingsKey(ClientContext &context) {
+	string key;
+	for (idx_t i = 0; i < DBConfig::GetOptionCount(); i++) {
+		auto option = DBConfig::GetOptionByIndex(i);
+		key += option->name;
+		key += '=';
+		key += option->get_setting(context).ToString();
+		key += '\0';
+	}
+	for (auto &entry : ClientConfig::GetConfig(context).set_variables) {
+		key += entry.first;
+		key += '=';
+		key += entry.second.ToString();
+		key += '\0';
+	}
+	return key;
+}
+
+void PlanCache::Refresh(ClientContext &context) {
+	auto current_version = Catalog::GetCatalog(context).GetCatalogVersion();
+	if (current_version != catalog_version) {
+		cache.clear();
+		plan_count = 0;
+		catalog_version = current_version;
+	}
+}
+
+void PlanCache::EvictPlans() {
+	while (plan_count > capacity) {
+		auto evict_query = cache.end();
+		unordered_map<string, CachedPlans>::iterator evict;
+		for (auto query_entry = cache.begin(); query_entry != cache.end(); query_entry++) {
+			for (auto entry = query_entry->second.begin(); entry != query_entry->second.end(); entry++) {
+				if (evict_query == cache.end() || entry->second.last_used < evict->second.last_used) {
+					evict_query = query_entry;
+					evict = entry;
+				}
+			}
+		}
+		D_ASSERT(evict_query != cache.end());
+		plan_count -= evict->second.plans.size();
+		evict_query->second.erase(evict);
+		if (evict_query->second.empty()) {
+			cache.erase(evict_query);
+		}
+	}
+}
+
+shared_ptr<PreparedStatementData> PlanCache::GetPlan(ClientContext &context, const string &query) {
+	auto query_key = GetQueryKey(query);
+	{
+		lock_guard<mutex> lock(cache_lock);
+		Refresh(context);
+		auto &transaction = context.transaction;
+		if (transaction.HasActiveTransaction() && transaction.ActiveTransaction().catalog_version != catalog_version) {
+			// the transaction sees an older version of the catalog than the one the cached plans were created with
+			return nullptr;
+		}
+		if (cache.find(query_key) == cache.end()) {
+			return nullptr;
+		}
+	}
+	// only look at the settings of the connection if there is a plan for the query at all
+	auto settings_key = GetSettingsKey(context);
+	unique_ptr<PreparedStatementData> plan;
+	{
+		lock_guard<mutex> lock(cache_lock);
+		auto query_entry = cache.find(query_key);
+		if (query_entry == cache.end()) {
+			return nullptr;
+		}
+		auto entry = query_entry->second.find(settings_key);
+		if (entry == query_entry->second.end()) {
+			return nullptr;
+		}
+		plan = move(entry->second.plans.back());
+		entry->second.plans.pop_back();
+		if (entry->second.plans.empty()) {
+			query_entry->second.erase(entry);
+			if (query_entry->second.empty()) {
+				cache.erase(query_entry);
+			}
+		} else {
+			entry->second.last_used = ++access_counter;
+		}
+		plan_count--;
+	}
+	return CheckOutPlan(query_key, settings_key, move(plan));
+}
+
+shared_ptr<PreparedStatementData> PlanCache::AddPlan(ClientContext &context, const string &query,
+                                                     unique_ptr<PreparedStatementData> plan) {
+	auto query_key = GetQueryKey(query);
+	auto settings_key = GetSettingsKey(context);
+	{
+		lock_guard<mutex> lock(cache_lock);
+		Refresh(context);
+	}
+	return CheckOutPlan(query_key, settings_key, move(plan));
+}
+
+shared_ptr<PreparedStatementData> PlanCache::CheckOutPlan(const string &query_key, const string &settings_key,
+                                                          unique_ptr<PreparedStatementData> plan) {
+	// the plan returns to the cache once the last reference to it is released - unless the cache is gone by then
+	weak_ptr<PlanCache> weak_cache = shared_from_this();
+	return shared_ptr<PreparedStatementData>(
+	    plan.release(), [weak_cache, query_key, settings_key](PreparedStatementData *data) {
+		    unique_ptr<PreparedStatementData> plan(data);
+		    auto cache = weak_cache.lock();
+		    if (cache) {
+			    cache->ReturnPlan(query_key, settings_key, move(plan));
+		    }
+	    });
+}
+
+void PlanCache::ReturnPlan(const string &query_key, const string &settings_key,
+                           unique_ptr<PreparedStatementData> plan) {
+	lock_guard<mutex> lock(cache_lock);
+	if (capacity == 0 || plan->catalog_version != catalog_version || !plan->unbound_statement) {
+		// the plan might refer to catalog entries that no longer exist
+		return;
+	}
+	auto &entry = cache[query_key][settings_key];
+	entry.plans.push_back(move(plan));
+	entry.last_used = ++access_counter;
+	plan_count++;
+	EvictPlans();
+}
+
+void PlanCache::SetCapacity(idx_t new_capacity) {
+	lock_guard<mutex> lock(cache_lock);
+	capacity = new_capacity;
+	EvictPlans();
+}
+
+idx_t PlanCache::PlanCount() {
+	lock_guard<mutex> lock(cache_lock);
+	return plan_count;
+}
+
+} // namespace duckdb
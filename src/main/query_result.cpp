@@ -4,6 +4,7 @@
 #include "duckdb/common/arrow.hpp"
 #include "duckdb/common/vector.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/arrow_query_result.hpp"
 
 namespace duckdb {
 
@@ -394,6 +395,13 @@ string QueryResult::GetConfigTimezone(QueryResult &query_result) {
 	case QueryResultType::STREAM_RESULT: {
 		return ClientConfig::ExtractTimezoneFromConfig(((StreamQueryResult &)query_result).context->config);
 	}
+	case QueryResultType::ARROW_RESULT: {
+		auto actual_context = ((ArrowQueryResult &)query_result).context.lock();
+		if (!actual_context) {
+			throw std::runtime_error("This connection is closed");
+		}
+		return ClientConfig::ExtractTimezoneFromConfig(actual_context->config);
+	}
 	default:
 		throw std::runtime_error("Can't extract timezone configuration from query type ");
 	}
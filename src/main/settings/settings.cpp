@@ -5,6 +5,8 @@
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/client_data.hpp"
 #include "duckdb/main/config.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/plan_cache.hpp"
 #include "duckdb/main/query_profiler.hpp"
 #include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/parser/parser.hpp"
@@ -45,6 +47,18 @@ Value AccessModeSetting::GetSetting(ClientContext &context) {
 	}
 }
 
+//===--------------------------------------------------------------------===//
+// Background Checkpoint
+//===--------------------------------------------------------------------===//
+void BackgroundCheckpointSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	config.background_checkpoint = input.GetValue<bool>();
+}
+
+Value BackgroundCheckpointSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BOOLEAN(config.background_checkpoint);
+}
+
 //===--------------------------------------------------------------------===//
 // Checkpoint Threshold
 //===--------------------------------------------------------------------===//
@@ -213,6 +227,18 @@ Value DefaultNullOrderSetting::GetSetting(ClientContext &context) {
 	}
 }
 
+//===--------------------------------------------------------------------===//
+// Direct Row Group Writes
+//===--------------------------------------------------------------------===//
+void DirectRowGroupWritesSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	config.direct_row_group_writes = input.GetValue<bool>();
+}
+
+Value DirectRowGroupWritesSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BOOLEAN(config.direct_row_group_writes);
+}
+
 //===--------------------------------------------------------------------===//
 // Disabled Optimizer
 //===--------------------------------------------------------------------===//
@@ -445,6 +471,25 @@ Value PerfectHashThresholdSetting::GetSetting(ClientContext &context) {
 	return Value::BIGINT(ClientConfig::GetConfig(context).perfect_ht_threshold);
 }
 
+//===--------------------------------------------------------------------===//
+// PlanCacheSize
+//===--------------------------------------------------------------------===//
+void PlanCacheSizeSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto new_size = input.GetValue<int64_t>();
+	if (new_size < 0) {
+		throw InvalidInputException("The plan cache size must be positive, or 0 to disable the plan cache");
+	}
+	config.plan_cache_size = new_size;
+	if (db) {
+		db->GetPlanCache().SetCapacity(config.plan_cache_size);
+	}
+}
+
+Value PlanCacheSizeSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BIGINT(config.plan_cache_size);
+}
+
 //===--------------------------------------------------------------------===//
 // PreserveIdentifierCase
 //===--------------------------------------------------------------------===//
@@ -594,4 +639,52 @@ Value ThreadsSetting::GetSetting(ClientContext &context) {
 	return Value::BIGINT(config.maximum_threads);
 }
 
+//===--------------------------------------------------------------------===//
+// Update Merge Threshold
+//===--------------------------------------------------------------------===//
+void UpdateMergeThresholdSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto new_threshold = input.GetValue<double>();
+	if (new_threshold < 0 || new_threshold > 1) {
+		throw InvalidInputException("The update merge threshold must be between 0 and 1");
+	}
+	config.update_merge_threshold = new_threshold;
+}
+
+Value UpdateMergeThresholdSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::DOUBLE(config.update_merge_threshold);
+}
+
+//===--------------------------------------------------------------------===//
+// Vacuum Threshold
+//===--------------------------------------------------------------------===//
+void VacuumThresholdSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto new_threshold = input.GetValue<double>();
+	if (new_threshold < 0 || new_threshold > 1) {
+		throw InvalidInputException("The vacuum threshold must be between 0 and 1");
+	}
+	config.vacuum_threshold = new_threshold;
+}
+
+Value VacuumThresholdSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::DOUBLE(config.vacuum_threshold);
+}
+
+//===--------------------------------------------------------------------===//
+// WAL Group Commit Window
+//===--------------------------------------------------------------------===//
+void WALGroupCommitWindowSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto new_window = input.GetValue<int64_t>();
+	if (new_window < 0) {
+		throw InvalidInputException("The WAL group commit window must be positive, or 0 to disable group commit");
+	}
+	config.wal_group_commit_window = new_window;
+}
+
+Value WALGroupCommitWindowSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BIGINT(config.wal_group_commit_window);
+}
+
 } // namespace duckdb
@@ -289,10 +289,66 @@ void Executor::InitializeInternal(PhysicalOperator *plan) {
 
 		VerifyPipelines();
 
-		ScheduleEvents();
+		if (!CanExecuteInline()) {
+			ScheduleEvents();
+		}
 	}
 }
 
+bool Executor::CanExecuteInline() {
+	D_ASSERT(inline_pipelines.empty());
+	if (pipelines.empty() || !union_pipelines.empty() || !child_pipelines.empty()) {
+		return false;
+	}
+	// pipelines are added before the pipelines they depend on: run them back to front
+	unordered_set<PhysicalOperator *> sinks;
+	vector<Pipeline *> order;
+	for (idx_t i = pipelines.size(); i > 0; i--) {
+		auto &pipeline = *pipelines[i - 1];
+		pipeline.Ready();
+		// the sink must be finalized outside of an event: it cannot schedule additional work
+		if (pipeline.sink->FinalizeSchedulesEvents()) {
+			return false;
+		}
+		for (auto &dependency : pipeline.dependencies) {
+			auto dep = dependency.lock();
+			if (!dep || sinks.find(dep->sink) == sinks.end()) {
+				return false;
+			}
+		}
+		// the pipeline either starts from an index lookup, or reads the result of a pipeline that ran before it
+		if (!pipeline.source_state->IsPointLookup() && sinks.find(pipeline.source) == sinks.end()) {
+			return false;
+		}
+		sinks.insert(pipeline.sink);
+		order.push_back(&pipeline);
+	}
+	inline_pipelines = move(order);
+	return true;
+}
+
+void Executor::ExecuteInline() {
+	try {
+		for (auto pipeline : inline_pipelines) {
+			PipelineExecutor pipeline_executor(context, *pipeline);
+			pipeline_executor.Execute();
+			// none of the sinks schedule additional work: the finish event only serves as the context of Finalize
+			auto finish_event = make_shared<PipelineFinishEvent>(pipeline->shared_from_this());
+			pipeline->Finalize(*finish_event);
+			CompletePipeline();
+			if (HasError()) {
+				return;
+			}
+		}
+	} catch (Exception &ex) {
+		PushError(ex.type, ex.what());
+	} catch (std::exception &ex) {
+		PushError(ExceptionType::UNKNOWN_TYPE, ex.what());
+	} catch (...) { // LCOV_EXCL_START
+		PushError(ExceptionType::UNKNOWN_TYPE, "Unknown exception in ExecuteInline!");
+	} // LCOV_EXCL_STOP
+}
+
 void Executor::CancelTasks() {
 	task.reset();
 	// we do this by creating weak pointers to all pipelines
@@ -345,6 +401,14 @@ PendingExecutionResult Executor::ExecuteTask() {
 	if (execution_result != PendingExecutionResult::RESULT_NOT_READY) {
 		return execution_result;
 	}
+	if (!inline_pipelines.empty()) {
+		ExecuteInline();
+		inline_pipelines.clear();
+		if (HasError()) {
+			execution_result = PendingExecutionResult::EXECUTION_ERROR;
+			ThrowException();
+		}
+	}
 	// check if there are any incomplete pipelines
 	auto &scheduler = TaskScheduler::GetScheduler(context);
 	while (completed_pipelines < total_pipelines) {
@@ -401,6 +465,7 @@ void Executor::Reset() {
 	union_pipelines.clear();
 	child_pipelines.clear();
 	child_dependencies.clear();
+	inline_pipelines.clear();
 	execution_result = PendingExecutionResult::RESULT_NOT_READY;
 }
 
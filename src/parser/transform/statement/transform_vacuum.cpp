@@ -1,4 +1,5 @@
 #include "duckdb/parser/statement/vacuum_statement.hpp"
+#include "duckdb/parser/tableref/basetableref.hpp"
 #include "duckdb/parser/transformer.hpp"
 
 namespace duckdb {
@@ -6,8 +7,14 @@ namespace duckdb {
 unique_ptr<VacuumStatement> Transformer::TransformVacuum(duckdb_libpgquery::PGNode *node) {
 	auto stmt = reinterpret_cast<duckdb_libpgquery::PGVacuumStmt *>(node);
 	D_ASSERT(stmt);
-	(void)stmt;
 	auto result = make_unique<VacuumStatement>();
+	result->info->vacuum = stmt->options & duckdb_libpgquery::PG_VACOPT_VACUUM;
+	if (stmt->relation) {
+		auto ref = TransformRangeVar(stmt->relation);
+		auto &table = *reinterpret_cast<BaseTableRef *>(ref.get());
+		result->info->schema = table.schema_name;
+		result->info->table = table.table_name;
+	}
 	return result;
 }
 
@@ -1,10 +1,18 @@
 #include "duckdb/planner/binder.hpp"
 #include "duckdb/parser/statement/vacuum_statement.hpp"
 #include "duckdb/planner/operator/logical_simple.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 
 namespace duckdb {
 
 BoundStatement Binder::Bind(VacuumStatement &stmt) {
+	if (!stmt.info->table.empty()) {
+		// check that the table exists, and resolve its schema
+		auto table = Catalog::GetCatalog(context).GetEntry<TableCatalogEntry>(context, stmt.info->schema,
+		                                                                    stmt.info->table);
+		stmt.info->schema = table->schema->name;
+	}
 	BoundStatement result;
 	result.names = {"Success"};
 	result.types = {LogicalType::BOOLEAN};
@@ -4,13 +4,18 @@
 #include "duckdb/common/types/null_value.hpp"
 
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/storage/data_table.hpp"
 #include "duckdb/common/serializer/buffered_serializer.hpp"
 
 namespace duckdb {
 
 TableDataWriter::TableDataWriter(DatabaseInstance &, CheckpointManager &checkpoint_manager, TableCatalogEntry &table,
                                  MetaBlockWriter &meta_writer)
-    : checkpoint_manager(checkpoint_manager), table(table), meta_writer(meta_writer) {
+    : checkpoint_manager(checkpoint_manager), table(*table.storage), meta_writer(&meta_writer) {
+}
+
+TableDataWriter::TableDataWriter(DatabaseInstance &, CheckpointManager &checkpoint_manager, DataTable &table)
+    : checkpoint_manager(checkpoint_manager), table(table), meta_writer(nullptr) {
 }
 
 TableDataWriter::~TableDataWriter() {
@@ -18,11 +23,11 @@ TableDataWriter::~TableDataWriter() {
 
 BlockPointer TableDataWriter::WriteTableData() {
 	// start scanning the table and append the data to the uncompressed segments
-	return table.storage->Checkpoint(*this);
+	return table.Checkpoint(*this);
 }
 
 CompressionType TableDataWriter::GetColumnCompressionType(idx_t i) {
-	return table.columns[i].CompressionType();
+	return table.column_definitions[i].CompressionType();
 }
 
 } // namespace duckdb
@@ -31,7 +31,7 @@ void ReorderTableEntries(vector<TableCatalogEntry *> &tables);
 CheckpointManager::CheckpointManager(DatabaseInstance &db) : db(db) {
 }
 
-void CheckpointManager::CreateCheckpoint() {
+void CheckpointManager::CreateCheckpoint(bool compact_file) {
 	auto &config = DBConfig::GetConfig(db);
 	auto &storage_manager = StorageManager::GetStorageManager(db);
 	if (storage_manager.InMemory()) {
@@ -41,7 +41,7 @@ void CheckpointManager::CreateCheckpoint() {
 	D_ASSERT(!metadata_writer);
 
 	auto &block_manager = BlockManager::GetBlockManager(db);
-	block_manager.StartCheckpoint();
+	block_manager.StartCheckpoint(compact_file);
 
 	//! Set up the writers for the checkpoints
 	metadata_writer = make_unique<MetaBlockWriter>(db);
@@ -22,8 +22,13 @@ unique_ptr<SegmentScanState> ConstantInitScan(ColumnSegment &segment) {
 void ConstantScanFunctionValidity(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, Vector &result) {
 	auto &validity = (ValidityStatistics &)*segment.stats.statistics;
 	if (validity.has_null) {
-		result.SetVectorType(VectorType::CONSTANT_VECTOR);
-		ConstantVector::SetNull(result, true);
+		if (result.GetVectorType() == VectorType::FLAT_VECTOR) {
+			// the data might already have been scanned and updated during a checkpoint: only mark the rows as NULL
+			FlatVector::Validity(result).SetAllInvalid(scan_count);
+		} else {
+			result.SetVectorType(VectorType::CONSTANT_VECTOR);
+			ConstantVector::SetNull(result, true);
+		}
 	}
 }
 
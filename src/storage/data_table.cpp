@@ -6,6 +6,7 @@
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
 #include "duckdb/planner/constraints/list.hpp"
 #include "duckdb/planner/table_filter.hpp"
 #include "duckdb/storage/storage_manager.hpp"
@@ -15,9 +16,14 @@
 #include "duckdb/transaction/transaction_manager.hpp"
 #include "duckdb/storage/checkpoint/table_data_writer.hpp"
 #include "duckdb/storage/table/standard_column_data.hpp"
+#include "duckdb/storage/table/column_checkpoint_state.hpp"
+#include "duckdb/parallel/task_counter.hpp"
 #include "duckdb/planner/expression_binder/check_binder.hpp"
 
 #include "duckdb/common/chrono.hpp"
+#include "duckdb/common/serializer/buffered_serializer.hpp"
+#include "duckdb/storage/checkpoint_manager.hpp"
+#include "duckdb/storage/write_ahead_log.hpp"
 
 namespace duckdb {
 
@@ -70,8 +76,9 @@ DataTable::DataTable(ClientContext &context, DataTable &parent, ColumnDefinition
 	for (auto &column_def : parent.column_definitions) {
 		column_definitions.emplace_back(column_def.Copy());
 	}
-	// prevent any new tuples from being added to the parent
+	// prevent any new tuples from being added to the parent, and wait for any optimistic appends to finish
 	lock_guard<mutex> parent_lock(parent.append_lock);
+	auto optimistic_append_lock = parent.optimistic_append_lock.GetExclusiveLock();
 	// add the new column to this DataTable
 	auto new_column_type = new_column.Type();
 	auto new_column_idx = parent.column_definitions.size();
@@ -118,8 +125,9 @@ DataTable::DataTable(ClientContext &context, DataTable &parent, ColumnDefinition
 
 DataTable::DataTable(ClientContext &context, DataTable &parent, idx_t removed_column)
     : info(parent.info), db(parent.db), total_rows(parent.total_rows.load()), is_root(true) {
-	// prevent any new tuples from being added to the parent
+	// prevent any new tuples from being added to the parent, and wait for any optimistic appends to finish
 	lock_guard<mutex> parent_lock(parent.append_lock);
+	auto optimistic_append_lock = parent.optimistic_append_lock.GetExclusiveLock();
 
 	for (auto &column_def : parent.column_definitions) {
 		column_definitions.emplace_back(column_def.Copy());
@@ -173,8 +181,9 @@ DataTable::DataTable(ClientContext &context, DataTable &parent, idx_t removed_co
 DataTable::DataTable(ClientContext &context, DataTable &parent, idx_t changed_idx, const LogicalType &target_type,
                      vector<column_t> bound_columns, Expression &cast_expr)
     : info(parent.info), db(parent.db), total_rows(parent.total_rows.load()), is_root(true) {
-	// prevent any tuples from being added to the parent
+	// prevent any tuples from being added to the parent, and wait for any optimistic appends to finish
 	lock_guard<mutex> lock(append_lock);
+	auto optimistic_append_lock = parent.optimistic_append_lock.GetExclusiveLock();
 	for (auto &column_def : parent.column_definitions) {
 		column_definitions.emplace_back(column_def.Copy());
 	}
@@ -700,10 +709,45 @@ void DataTable::InitializeAppend(Transaction &transaction, TableAppendState &sta
 	lock_guard<mutex> row_group_lock(row_groups->node_lock);
 	auto last_row_group = (RowGroup *)row_groups->GetLastSegment();
 	D_ASSERT(total_rows == last_row_group->start + last_row_group->count);
+	if (last_row_group->count >= RowGroup::ROW_GROUP_SIZE) {
+		// the last row group is full: start a new one, so the columns of the full row group are left untouched
+		AppendRowGroup(total_rows);
+		last_row_group = (RowGroup *)row_groups->GetLastSegment();
+	}
 	last_row_group->InitializeAppend(transaction, state.row_group_append_state, state.remaining_append_count);
 	total_rows += append_count;
 }
 
+void DataTable::InitializeOptimisticAppend(Transaction &transaction, TableAppendState &state, idx_t append_count) {
+	D_ASSERT(append_count > 0 && append_count % RowGroup::ROW_GROUP_SIZE == 0);
+	lock_guard<mutex> lock(append_lock);
+	if (!is_root) {
+		throw TransactionException("Transaction conflict: adding entries to a table that has been altered!");
+	}
+	state.row_start = total_rows;
+	state.current_row = state.row_start;
+	state.remaining_append_count = append_count;
+
+	// reserve full row groups for the append: the version info marks all of their rows as appended by this
+	// transaction right away, so concurrent appends start new row groups after them
+	lock_guard<mutex> row_group_lock(row_groups->node_lock);
+	auto last_row_group = (RowGroup *)row_groups->GetLastSegment();
+	D_ASSERT(total_rows == last_row_group->start + last_row_group->count);
+	for (idx_t row = 0; row < append_count; row += RowGroup::ROW_GROUP_SIZE) {
+		if (last_row_group->count > 0) {
+			AppendRowGroup(total_rows + row);
+			last_row_group = (RowGroup *)row_groups->GetLastSegment();
+		}
+		// set up the column segments right away: concurrent scans can reach the row group before its rows are appended
+		RowGroupAppendState row_group_state(state);
+		last_row_group->InitializeAppend(row == 0 ? state.row_group_append_state : row_group_state);
+		last_row_group->AppendVersionInfo(transaction, 0, RowGroup::ROW_GROUP_SIZE, transaction.transaction_id);
+	}
+	total_rows += append_count;
+	// the rows are appended after the append lock is released: altering the table has to wait for them
+	state.optimistic_append_lock = optimistic_append_lock.GetSharedLock();
+}
+
 void DataTable::Append(Transaction &transaction, DataChunk &chunk, TableAppendState &state) {
 	D_ASSERT(is_root);
 	D_ASSERT(chunk.ColumnCount() == column_definitions.size());
@@ -717,7 +761,20 @@ void DataTable::Append(Transaction &transaction, DataChunk &chunk, TableAppendSt
 		idx_t append_count =
 		    MinValue<idx_t>(remaining, RowGroup::ROW_GROUP_SIZE - state.row_group_append_state.offset_in_row_group);
 		if (append_count > 0) {
-			current_row_group->Append(state.row_group_append_state, chunk, append_count);
+			if (append_count < remaining) {
+				// the chunk is split over two row groups: nested columns are flattened in place for the appended rows
+				// only, so the first part is appended from a slice to leave the chunk intact for the second part
+				SelectionVector sel(STANDARD_VECTOR_SIZE);
+				for (idx_t i = 0; i < append_count; i++) {
+					sel.set_index(i, i);
+				}
+				DataChunk first_part;
+				first_part.InitializeEmpty(chunk.GetTypes());
+				first_part.Slice(chunk, sel, append_count);
+				current_row_group->Append(state.row_group_append_state, first_part, append_count);
+			} else {
+				current_row_group->Append(state.row_group_append_state, chunk, append_count);
+			}
 			// merge the stats
 			lock_guard<mutex> stats_guard(stats_lock);
 			for (idx_t i = 0; i < column_definitions.size(); i++) {
@@ -738,6 +795,14 @@ void DataTable::Append(Transaction &transaction, DataChunk &chunk, TableAppendSt
 				}
 				chunk.Slice(sel, remaining);
 			}
+			if (state.optimistic_append_lock) {
+				// optimistic append: continue in the next row group reserved by InitializeOptimisticAppend
+				auto next_row_group = (RowGroup *)current_row_group->next.get();
+				next_row_group->InitializeAppend(state.row_group_append_state);
+				// the reserved row group is already counted as full: its rows are appended from the start
+				state.row_group_append_state.offset_in_row_group = 0;
+				continue;
+			}
 			// append a new row_group
 			AppendRowGroup(current_row_group->start + current_row_group->count);
 			// set up the append state for this row_group
@@ -750,6 +815,7 @@ void DataTable::Append(Transaction &transaction, DataChunk &chunk, TableAppendSt
 		}
 	}
 	state.current_row += append_count;
+	lock_guard<mutex> stats_guard(stats_lock);
 	for (idx_t col_idx = 0; col_idx < column_stats.size(); col_idx++) {
 		auto type = chunk.data[col_idx].GetType().InternalType();
 		if (type == PhysicalType::LIST || type == PhysicalType::STRUCT) {
@@ -774,7 +840,10 @@ void DataTable::ScanTableSegment(idx_t row_start, idx_t count, const std::functi
 
 	CreateIndexScanState state;
 
-	idx_t row_start_aligned = row_start / STANDARD_VECTOR_SIZE * STANDARD_VECTOR_SIZE;
+	// the vectors are aligned to the start of their row group, which is not necessarily a multiple of the vector size
+	auto row_group = (RowGroup *)row_groups->GetSegment(row_start);
+	idx_t row_start_aligned =
+	    row_group->start + (row_start - row_group->start) / STANDARD_VECTOR_SIZE * STANDARD_VECTOR_SIZE;
 	InitializeScanWithOffset(state, column_ids, row_start_aligned, row_start + count);
 
 	idx_t current_row = row_start_aligned;
@@ -791,7 +860,7 @@ void DataTable::ScanTableSegment(idx_t row_start, idx_t count, const std::functi
 		idx_t chunk_count = chunk_end - chunk_start;
 		if (chunk_count != chunk.size()) {
 			// need to slice the chunk before insert
-			auto start_in_chunk = chunk_start % STANDARD_VECTOR_SIZE;
+			auto start_in_chunk = chunk_start - current_row;
 			SelectionVector sel(start_in_chunk, chunk_count);
 			chunk.Slice(sel, chunk_count);
 			chunk.Verify();
@@ -804,7 +873,89 @@ void DataTable::ScanTableSegment(idx_t row_start, idx_t count, const std::functi
 
 void DataTable::WriteToLog(WriteAheadLog &log, idx_t row_start, idx_t count) {
 	log.WriteSetTable(info->schema, info->table);
-	ScanTableSegment(row_start, count, [&](DataChunk &chunk) { log.WriteInsert(chunk); });
+	vector<RowGroup *> write_row_groups;
+	if (log.write_row_groups && is_root && info->indexes.Empty()) {
+		// indexes are rebuilt from the inserts in the WAL during replay: only tables without indexes qualify
+		write_row_groups = GetCompleteRowGroups(row_start, count);
+	}
+	if (write_row_groups.empty()) {
+		ScanTableSegment(row_start, count, [&](DataChunk &chunk) { log.WriteInsert(chunk); });
+		return;
+	}
+	// the rows before and after the complete row groups are written to the WAL as usual
+	idx_t row_end = row_start + count;
+	idx_t write_start = write_row_groups[0]->start;
+	idx_t write_end = write_row_groups.back()->start + write_row_groups.back()->count;
+	if (write_start > row_start) {
+		ScanTableSegment(row_start, write_start - row_start, [&](DataChunk &chunk) { log.WriteInsert(chunk); });
+	}
+	WriteRowGroupData(log, write_row_groups);
+	if (row_end > write_end) {
+		ScanTableSegment(write_end, row_end - write_end, [&](DataChunk &chunk) { log.WriteInsert(chunk); });
+	}
+}
+
+vector<RowGroup *> DataTable::GetCompleteRowGroups(idx_t row_start, idx_t count) {
+	vector<RowGroup *> result;
+	idx_t row_end = row_start + count;
+	for (auto row_group = (RowGroup *)row_groups->GetSegment(row_start); row_group;
+	     row_group = (RowGroup *)row_group->next.get()) {
+		if (row_group->start + row_group->count > row_end) {
+			break;
+		}
+		// rewriting a row group drops its updates: row groups with updates are written to the WAL instead
+		bool complete = row_group->start >= row_start && row_group->count == RowGroup::ROW_GROUP_SIZE &&
+		                !row_group->HasUpdates();
+		if (complete) {
+			result.push_back(row_group);
+		} else if (!result.empty()) {
+			break;
+		}
+	}
+	return result;
+}
+
+void DataTable::AppendRowGroupData(Transaction &transaction, Deserializer &source) {
+	auto &block_manager = BlockManager::GetBlockManager(db);
+	auto block_count = source.Read<idx_t>();
+	for (idx_t block_idx = 0; block_idx < block_count; block_idx++) {
+		auto block_id = source.Read<block_id_t>();
+		auto reference_count = source.Read<uint32_t>();
+		block_manager.MarkBlockAsUsed(block_id, reference_count);
+	}
+
+	auto types = GetTypes();
+	lock_guard<mutex> lock(append_lock);
+	idx_t row_start = total_rows;
+	auto row_group_count = source.Read<idx_t>();
+	for (idx_t row_group_idx = 0; row_group_idx < row_group_count; row_group_idx++) {
+		auto row_group = RowGroup::DeserializeColumnData(transaction, *info, types, source);
+		if (row_group->start != total_rows) {
+			throw InternalException("Corrupt WAL: row group data does not start at the end of the table");
+		}
+		lock_guard<mutex> tree_lock(row_groups->node_lock);
+		auto last_row_group = (RowGroup *)row_groups->GetLastSegment();
+		if (last_row_group->count == 0) {
+			// the row groups are appended after the last non-empty row group
+			if (row_groups->nodes.size() == 1) {
+				row_groups->root_node.reset();
+			} else {
+				row_groups->nodes[row_groups->nodes.size() - 2].node->next.reset();
+			}
+			row_groups->nodes.pop_back();
+		}
+		{
+			lock_guard<mutex> stats_guard(stats_lock);
+			for (idx_t i = 0; i < column_definitions.size(); i++) {
+				column_stats[i]->stats->Merge(*row_group->GetStatistics(i));
+			}
+		}
+		total_rows += row_group->count;
+		row_groups->AppendSegment(move(row_group));
+	}
+	if (total_rows > row_start) {
+		transaction.PushAppend(this, row_start, total_rows - row_start);
+	}
 }
 
 void DataTable::CommitAppend(transaction_t commit_id, idx_t row_start, idx_t count) {
@@ -850,15 +1001,26 @@ void DataTable::RevertAppendInternal(idx_t start_row, idx_t count) {
 	lock_guard<mutex> tree_lock(row_groups->node_lock);
 	// find the segment index that the current row belongs to
 	idx_t segment_index = row_groups->GetSegmentIndex(start_row);
-	auto segment = row_groups->nodes[segment_index].node;
-	auto &info = (RowGroup &)*segment;
-
 	// remove any segments AFTER this segment: they should be deleted entirely
-	if (segment_index < row_groups->nodes.size() - 1) {
-		row_groups->nodes.erase(row_groups->nodes.begin() + segment_index + 1, row_groups->nodes.end());
+	// the same holds for this segment if it starts at the first reverted row
+	idx_t remove_index = row_groups->nodes[segment_index].row_start == start_row ? segment_index : segment_index + 1;
+	for (idx_t node_idx = remove_index; node_idx < row_groups->nodes.size(); node_idx++) {
+		// the columns might have been written to the database file by the commit: free their blocks
+		auto &removed_row_group = (RowGroup &)*row_groups->nodes[node_idx].node;
+		removed_row_group.CommitDrop();
+	}
+	row_groups->nodes.erase(row_groups->nodes.begin() + remove_index, row_groups->nodes.end());
+	if (remove_index == 0) {
+		// all row groups were removed: start over with an empty row group
+		row_groups->root_node.reset();
+		AppendRowGroup(start_row);
+		return;
 	}
+	auto &info = (RowGroup &)*row_groups->nodes[remove_index - 1].node;
 	info.next = nullptr;
-	info.RevertAppend(start_row);
+	if (remove_index == segment_index + 1) {
+		info.RevertAppend(start_row);
+	}
 }
 
 void DataTable::RevertAppend(idx_t start_row, idx_t count) {
@@ -1324,20 +1486,247 @@ unique_ptr<BaseStatistics> DataTable::GetStatistics(ClientContext &context, colu
 //===--------------------------------------------------------------------===//
 // Checkpoint
 //===--------------------------------------------------------------------===//
+struct CheckpointColumnResult {
+	unique_ptr<ColumnCheckpointState> state;
+	std::exception_ptr error;
+};
+
+class CheckpointColumnTask : public Task {
+public:
+	CheckpointColumnTask(TaskCounter &counter, TableDataWriter &writer, RowGroup &row_group, idx_t column_idx,
+	                     CheckpointColumnResult &result)
+	    : counter(counter), writer(writer), row_group(row_group), column_idx(column_idx), result(result) {
+	}
+
+	TaskCounter &counter;
+	TableDataWriter &writer;
+	RowGroup &row_group;
+	idx_t column_idx;
+	CheckpointColumnResult &result;
+
+public:
+	TaskExecutionResult Execute(TaskExecutionMode mode) override {
+		try {
+			result.state = row_group.CheckpointColumn(writer, column_idx);
+		} catch (...) {
+			result.error = std::current_exception();
+		}
+		counter.FinishTask();
+		return TaskExecutionResult::TASK_FINISHED;
+	}
+};
+
+//! Analyzes, compresses and writes the data of every column of every row group to disk, each by a separate task.
+//! Returns the checkpoint states, ordered by row group and then by column.
+static vector<unique_ptr<ColumnCheckpointState>> CheckpointColumns(DatabaseInstance &db, TableDataWriter &writer,
+                                                                   const vector<RowGroup *> &row_groups,
+                                                                   idx_t column_count) {
+	vector<CheckpointColumnResult> results(row_groups.size() * column_count);
+	TaskCounter counter(TaskScheduler::GetScheduler(db));
+	for (idx_t row_group_idx = 0; row_group_idx < row_groups.size(); row_group_idx++) {
+		for (idx_t column_idx = 0; column_idx < column_count; column_idx++) {
+			auto &result = results[row_group_idx * column_count + column_idx];
+			counter.AddTask(
+			    make_unique<CheckpointColumnTask>(counter, writer, *row_groups[row_group_idx], column_idx, result));
+		}
+	}
+	counter.Finish();
+	vector<unique_ptr<ColumnCheckpointState>> states;
+	states.reserve(results.size());
+	for (auto &result : results) {
+		if (result.error) {
+			std::rethrow_exception(result.error);
+		}
+		states.push_back(move(result.state));
+	}
+	return states;
+}
+
+void DataTable::Vacuum(double threshold, bool merge_small) {
+	if (!is_root || !info->indexes.Empty()) {
+		// the indexes refer to the rows by their row id: the rows cannot be moved
+		return;
+	}
+	lock_guard<mutex> append_guard(append_lock);
+	lock_guard<mutex> tree_lock(row_groups->node_lock);
+	auto &nodes = row_groups->nodes;
+
+	// find the runs of adjacent row groups that should be compacted
+	vector<idx_t> kept_counts;
+	vector<pair<idx_t, idx_t>> runs;
+	idx_t run_start = 0;
+	idx_t run_rows = 0;
+	bool run_has_deletes = false;
+	auto finish_run = [&](idx_t run_end) {
+		if (run_end == run_start) {
+			return;
+		}
+		// a run is only rewritten if this removes rows, or if it results in fewer row groups
+		idx_t new_row_groups = (run_rows + RowGroup::ROW_GROUP_SIZE - 1) / RowGroup::ROW_GROUP_SIZE;
+		if (run_has_deletes || new_row_groups < run_end - run_start) {
+			runs.emplace_back(run_start, run_end);
+		}
+	};
+	for (idx_t node_idx = 0; node_idx < nodes.size(); node_idx++) {
+		auto &row_group = (RowGroup &)*nodes[node_idx].node;
+		auto kept_count = row_group.GetCheckpointRowCount();
+		kept_counts.push_back(kept_count);
+
+		idx_t deleted_count = row_group.count - kept_count;
+		bool compact = deleted_count > 0 && deleted_count >= threshold * row_group.count;
+		bool merge = merge_small && row_group.count > 0 && row_group.count < RowGroup::ROW_GROUP_SIZE;
+		if (!compact && !merge) {
+			finish_run(node_idx);
+			run_start = node_idx + 1;
+			run_rows = 0;
+			run_has_deletes = false;
+			continue;
+		}
+		run_rows += kept_count;
+		run_has_deletes = run_has_deletes || deleted_count > 0;
+	}
+	finish_run(nodes.size());
+	if (runs.empty()) {
+		return;
+	}
+
+	// copy the rows that are kept in each run into new row groups, starting at the first row of the run
+	auto types = GetTypes();
+	vector<column_t> column_ids;
+	for (idx_t i = 0; i < types.size(); i++) {
+		column_ids.push_back(i);
+	}
+	vector<vector<unique_ptr<RowGroup>>> new_row_groups;
+	for (auto &run : runs) {
+		vector<unique_ptr<RowGroup>> run_row_groups;
+		TableAppendState state;
+		auto &append_state = state.row_group_append_state;
+		auto append_rows = [&](DataChunk &chunk, idx_t count) {
+			idx_t offset = 0;
+			while (offset < count) {
+				if (run_row_groups.empty() || run_row_groups.back()->count >= RowGroup::ROW_GROUP_SIZE) {
+					idx_t start_row = run_row_groups.empty()
+					                      ? nodes[run.first].row_start
+					                      : run_row_groups.back()->start + run_row_groups.back()->count;
+					auto new_row_group = make_unique<RowGroup>(db, *info, start_row, 0);
+					new_row_group->InitializeEmpty(types);
+					new_row_group->InitializeAppend(append_state);
+					run_row_groups.push_back(move(new_row_group));
+				}
+				auto &target = *run_row_groups.back();
+				auto append_count = MinValue<idx_t>(count - offset, RowGroup::ROW_GROUP_SIZE - target.count);
+				if (offset == 0 && append_count == count) {
+					target.Append(append_state, chunk, append_count);
+				} else {
+					SelectionVector sel(offset, append_count);
+					DataChunk part;
+					part.InitializeEmpty(types);
+					part.Slice(chunk, sel, append_count);
+					target.Append(append_state, part, append_count);
+				}
+				target.count += append_count;
+				offset += append_count;
+			}
+		};
+
+		DataChunk chunk;
+		chunk.Initialize(types);
+		SelectionVector sel(STANDARD_VECTOR_SIZE);
+		for (idx_t node_idx = run.first; node_idx < run.second; node_idx++) {
+			auto &row_group = (RowGroup &)*nodes[node_idx].node;
+			if (kept_counts[node_idx] == 0) {
+				continue;
+			}
+			TableScanState scan_state;
+			auto &row_group_scan_state = scan_state.row_group_scan_state;
+			InitializeScanInRowGroup(scan_state, column_ids, nullptr, &row_group, 0, row_group.start + row_group.count);
+			while (true) {
+				auto vector_index = row_group_scan_state.vector_index;
+				chunk.Reset();
+				row_group.ScanCommitted(row_group_scan_state, chunk, TableScanType::TABLE_SCAN_COMMITTED_ROWS);
+				if (chunk.size() == 0) {
+					break;
+				}
+				auto count = row_group.GetCheckpointSelVector(vector_index, sel, chunk.size());
+				if (count == 0) {
+					continue;
+				}
+				if (count < chunk.size()) {
+					chunk.Slice(sel, count);
+				}
+				append_rows(chunk, count);
+			}
+		}
+		new_row_groups.push_back(move(run_row_groups));
+	}
+
+	// rebuild the segment tree: the row groups of the runs are replaced by the new row groups
+	vector<unique_ptr<SegmentBase>> old_row_groups;
+	for (auto node = move(row_groups->root_node); node;) {
+		auto next = move(node->next);
+		old_row_groups.push_back(move(node));
+		node = move(next);
+	}
+	nodes.clear();
+	idx_t run_idx = 0;
+	for (idx_t node_idx = 0; node_idx < old_row_groups.size(); node_idx++) {
+		if (run_idx < runs.size() && node_idx == runs[run_idx].first) {
+			for (auto &new_row_group : new_row_groups[run_idx]) {
+				row_groups->AppendSegment(move(new_row_group));
+			}
+			// the columns of the old row groups might have been written to the database file: free their blocks
+			for (; node_idx < runs[run_idx].second; node_idx++) {
+				((RowGroup &)*old_row_groups[node_idx]).CommitDrop();
+			}
+			node_idx--;
+			run_idx++;
+			continue;
+		}
+		row_groups->AppendSegment(move(old_row_groups[node_idx]));
+	}
+	if (nodes.empty()) {
+		AppendRowGroup(0);
+	}
+	auto last_row_group = (RowGroup *)row_groups->GetLastSegment();
+	total_rows = last_row_group->start + last_row_group->count;
+	// the row groups that were not compacted can still contain deleted rows, and the compacted runs can leave gaps in
+	// the row ids: the cardinality is the number of rows that are kept, not the number of row ids
+	idx_t live_rows = 0;
+	for (auto kept_count : kept_counts) {
+		live_rows += kept_count;
+	}
+	info->cardinality = live_rows;
+}
+
 BlockPointer DataTable::Checkpoint(TableDataWriter &writer) {
+	// compact the row groups from which many rows have been deleted before writing them
+	Vacuum(DBConfig::GetConfig(db).vacuum_threshold, false);
+
 	// checkpoint each individual row group
-	// FIXME: we might want to combine adjacent row groups in case they have had deletions...
 	vector<unique_ptr<BaseStatistics>> global_stats;
 	for (idx_t i = 0; i < column_definitions.size(); i++) {
 		global_stats.push_back(column_stats[i]->stats->Copy());
 	}
 
-	auto row_group = (RowGroup *)row_groups->GetRootSegment();
+	vector<RowGroup *> checkpoint_row_groups;
+	for (auto row_group = (RowGroup *)row_groups->GetRootSegment(); row_group;
+	     row_group = (RowGroup *)row_group->next.get()) {
+		checkpoint_row_groups.push_back(row_group);
+	}
+	// the data of every column of every row group is analyzed, compressed and written to disk by a separate task
+	// the metadata is written afterwards, in order
+	auto column_count = column_definitions.size();
+	auto column_states = CheckpointColumns(db, writer, checkpoint_row_groups, column_count);
+
 	vector<RowGroupPointer> row_group_pointers;
-	while (row_group) {
-		auto pointer = row_group->Checkpoint(writer, global_stats);
+	for (idx_t row_group_idx = 0; row_group_idx < checkpoint_row_groups.size(); row_group_idx++) {
+		vector<unique_ptr<ColumnCheckpointState>> states;
+		states.reserve(column_count);
+		for (idx_t column_idx = 0; column_idx < column_count; column_idx++) {
+			states.push_back(move(column_states[row_group_idx * column_count + column_idx]));
+		}
+		auto pointer = checkpoint_row_groups[row_group_idx]->Checkpoint(writer, global_stats, move(states));
 		row_group_pointers.push_back(move(pointer));
-		row_group = (RowGroup *)row_group->next.get();
 	}
 	// store the current position in the metadata writer
 	// this is where the row groups for this table start
@@ -1355,6 +1744,44 @@ BlockPointer DataTable::Checkpoint(TableDataWriter &writer) {
 	return pointer;
 }
 
+void DataTable::WriteRowGroupData(WriteAheadLog &log, const vector<RowGroup *> &write_row_groups) {
+	auto &block_manager = BlockManager::GetBlockManager(db);
+	// the partial blocks are only shared by the row groups that are written here
+	CheckpointManager checkpoint_manager(db);
+	TableDataWriter writer(db, checkpoint_manager, *this);
+
+	// compress and write the columns to disk, recording the blocks they use
+	vector<unique_ptr<ColumnCheckpointState>> states;
+	block_manager.StartRecordingAllocations();
+	try {
+		states = CheckpointColumns(db, writer, write_row_groups, column_definitions.size());
+		checkpoint_manager.FlushPartialSegments();
+	} catch (...) {
+		block_manager.StopRecordingAllocations();
+		throw;
+	}
+	auto blocks = block_manager.StopRecordingAllocations();
+	// the blocks have to be on disk before the WAL entry that references them
+	block_manager.Sync();
+
+	BufferedSerializer serializer;
+	serializer.Write<idx_t>(blocks.size());
+	for (auto &block : blocks) {
+		serializer.Write<block_id_t>(block.first);
+		serializer.Write<uint32_t>(block.second);
+	}
+	auto column_count = column_definitions.size();
+	serializer.Write<idx_t>(write_row_groups.size());
+	for (idx_t row_group_idx = 0; row_group_idx < write_row_groups.size(); row_group_idx++) {
+		vector<unique_ptr<ColumnCheckpointState>> row_group_states;
+		for (idx_t column_idx = 0; column_idx < column_count; column_idx++) {
+			row_group_states.push_back(move(states[row_group_idx * column_count + column_idx]));
+		}
+		write_row_groups[row_group_idx]->SerializeColumnData(row_group_states, serializer);
+	}
+	log.WriteRowGroupData(serializer);
+}
+
 void DataTable::CommitDropColumn(idx_t index) {
 	auto segment = (RowGroup *)row_groups->GetRootSegment();
 	while (segment) {
@@ -1363,6 +1790,14 @@ void DataTable::CommitDropColumn(idx_t index) {
 	}
 }
 
+void DataTable::MergeUpdates(const unordered_set<ColumnData *> &merge_columns, double threshold) {
+	auto segment = (RowGroup *)row_groups->GetRootSegment();
+	while (segment) {
+		segment->MergeUpdates(merge_columns, threshold);
+		segment = (RowGroup *)segment->next.get();
+	}
+}
+
 idx_t DataTable::GetTotalRows() {
 	return total_rows;
 }
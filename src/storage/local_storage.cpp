@@ -193,7 +193,12 @@ void LocalStorage::Append(DataTable *table, DataChunk &chunk) {
 	storage->collection.Append(chunk);
 	if (storage->active_scans == 0 && storage->collection.Count() >= RowGroup::ROW_GROUP_SIZE * 2) {
 		// flush to base storage
-		Flush(*table, *storage);
+		if (storage->deleted_rows == 0 && storage->indexes.empty() && table->info->indexes.Empty()) {
+			// no rows to skip and no indexes to check: complete row groups can be appended optimistically
+			FlushRowGroups(*table, *storage);
+		} else {
+			Flush(*table, *storage);
+		}
 	}
 }
 
@@ -276,6 +281,17 @@ idx_t LocalStorage::Delete(DataTable *table, Vector &row_ids, idx_t count) {
 	return deleted_count;
 }
 
+template <class T>
+static T CopyUpdateValue(Vector &data_vector, T value) {
+	return value;
+}
+
+template <>
+string_t CopyUpdateValue(Vector &data_vector, string_t value) {
+	// the updated strings only live as long as the chunk of updates: copy them into the heap of the local chunk
+	return StringVector::AddStringOrBlob(data_vector, value);
+}
+
 template <class T>
 static void TemplatedUpdateLoop(Vector &data_vector, Vector &update_vector, Vector &row_ids, idx_t count,
                                 idx_t base_index) {
@@ -291,8 +307,12 @@ static void TemplatedUpdateLoop(Vector &data_vector, Vector &update_vector, Vect
 		auto uidx = udata.sel->get_index(i);
 
 		auto id = ids[i] - base_index;
-		target[id] = updates[uidx];
-		mask.Set(id, udata.validity.RowIsValid(uidx));
+		if (udata.validity.RowIsValid(uidx)) {
+			target[id] = CopyUpdateValue<T>(data_vector, updates[uidx]);
+			mask.SetValid(id);
+		} else {
+			mask.SetInvalid(id);
+		}
 	}
 }
 
@@ -423,6 +443,31 @@ void LocalStorage::Flush(DataTable &table, LocalTableStorage &storage) {
 	transaction.PushAppend(&table, append_state.row_start, append_count);
 }
 
+void LocalStorage::FlushRowGroups(DataTable &table, LocalTableStorage &storage) {
+	D_ASSERT(storage.deleted_rows == 0);
+	idx_t append_count = storage.collection.Count() / RowGroup::ROW_GROUP_SIZE * RowGroup::ROW_GROUP_SIZE;
+	if (append_count == 0) {
+		return;
+	}
+	TableAppendState append_state;
+	table.InitializeOptimisticAppend(transaction, append_state, append_count);
+	// the reserved rows are reverted on rollback even if appending them fails halfway
+	transaction.PushAppend(&table, append_state.row_start, append_count);
+
+	// all chunks but the last one are full: the complete row groups are made up of the first chunks
+	idx_t append_chunks = append_count / STANDARD_VECTOR_SIZE;
+	for (idx_t chunk_idx = 0; chunk_idx < append_chunks; chunk_idx++) {
+		table.Append(transaction, storage.collection.GetChunk(chunk_idx), append_state);
+	}
+	// keep the remaining rows in the local storage
+	ChunkCollection remaining;
+	for (idx_t chunk_idx = append_chunks; chunk_idx < storage.collection.ChunkCount(); chunk_idx++) {
+		remaining.Append(storage.collection.GetChunk(chunk_idx));
+	}
+	storage.collection.Reset();
+	storage.collection.Merge(remaining);
+}
+
 void LocalStorage::Commit(LocalStorage::CommitState &commit_state, Transaction &transaction, WriteAheadLog *log,
                           transaction_t commit_id) {
 	// commit local storage, iterate over all entries in the table storage map
@@ -5,6 +5,7 @@
 #include "duckdb/common/serializer/buffered_deserializer.hpp"
 #include "duckdb/common/serializer/buffered_serializer.hpp"
 #include "duckdb/common/field_writer.hpp"
+#include "duckdb/common/limits.hpp"
 #include "duckdb/storage/meta_block_reader.hpp"
 #include "duckdb/storage/meta_block_writer.hpp"
 #include "duckdb/main/config.hpp"
@@ -85,8 +86,9 @@ T DeserializeHeaderStructure(data_ptr_t ptr) {
 SingleFileBlockManager::SingleFileBlockManager(DatabaseInstance &db, string path_p, bool read_only, bool create_new,
                                                bool use_direct_io)
     : db(db), path(move(path_p)),
-      header_buffer(Allocator::Get(db), FileBufferType::MANAGED_BUFFER, Storage::FILE_HEADER_SIZE), iteration_count(0),
-      read_only(read_only), use_direct_io(use_direct_io) {
+      header_buffer(Allocator::Get(db), FileBufferType::MANAGED_BUFFER, Storage::FILE_HEADER_SIZE),
+      relocate_from(NumericLimits<block_id_t>::Maximum()), iteration_count(0), read_only(read_only),
+      use_direct_io(use_direct_io), recording_allocations(false) {
 	uint8_t flags;
 	FileLockType lock;
 	if (read_only) {
@@ -213,7 +215,17 @@ void SingleFileBlockManager::LoadFreeList() {
 	}
 }
 
-void SingleFileBlockManager::StartCheckpoint() {
+void SingleFileBlockManager::StartCheckpoint(bool compact_file) {
+	lock_guard<mutex> lock(block_lock);
+	relocate_from = NumericLimits<block_id_t>::Maximum();
+	if (compact_file) {
+		// the blocks that are in use fit in the start of the file: the free blocks there can hold the blocks after it
+		relocate_from = max_block - free_list.size();
+	}
+}
+
+bool SingleFileBlockManager::ShouldRelocateBlock(block_id_t block_id) {
+	return block_id >= relocate_from;
 }
 
 bool SingleFileBlockManager::IsRootBlock(block_id_t root) {
@@ -221,6 +233,7 @@ bool SingleFileBlockManager::IsRootBlock(block_id_t root) {
 }
 
 block_id_t SingleFileBlockManager::GetFreeBlockId() {
+	lock_guard<mutex> lock(block_lock);
 	block_id_t block;
 	if (!free_list.empty()) {
 		// free list is non empty
@@ -231,11 +244,52 @@ block_id_t SingleFileBlockManager::GetFreeBlockId() {
 	} else {
 		block = max_block++;
 	}
+	if (recording_allocations) {
+		recorded_allocations.push_back(block);
+	}
 	return block;
 }
 
+void SingleFileBlockManager::MarkBlockAsUsed(block_id_t block_id, uint32_t reference_count) {
+	D_ASSERT(block_id >= 0);
+	lock_guard<mutex> lock(block_lock);
+	if (block_id >= max_block) {
+		// the block is past the end of the file: the blocks in between are free
+		while (max_block < block_id) {
+			free_list.insert(max_block);
+			max_block++;
+		}
+		max_block++;
+	} else {
+		free_list.erase(block_id);
+	}
+	if (reference_count > 1) {
+		multi_use_blocks[block_id] = reference_count;
+	}
+}
+
+void SingleFileBlockManager::StartRecordingAllocations() {
+	lock_guard<mutex> lock(block_lock);
+	D_ASSERT(!recording_allocations);
+	recording_allocations = true;
+	recorded_allocations.clear();
+}
+
+vector<pair<block_id_t, uint32_t>> SingleFileBlockManager::StopRecordingAllocations() {
+	lock_guard<mutex> lock(block_lock);
+	recording_allocations = false;
+	vector<pair<block_id_t, uint32_t>> result;
+	for (auto &block_id : recorded_allocations) {
+		auto entry = multi_use_blocks.find(block_id);
+		result.emplace_back(block_id, entry == multi_use_blocks.end() ? 1 : entry->second);
+	}
+	recorded_allocations.clear();
+	return result;
+}
+
 void SingleFileBlockManager::MarkBlockAsModified(block_id_t block_id) {
 	D_ASSERT(block_id >= 0);
+	lock_guard<mutex> lock(block_lock);
 
 	// check if the block is a multi-use block
 	auto entry = multi_use_blocks.find(block_id);
@@ -253,6 +307,7 @@ void SingleFileBlockManager::MarkBlockAsModified(block_id_t block_id) {
 }
 
 void SingleFileBlockManager::IncreaseBlockReferenceCount(block_id_t block_id) {
+	lock_guard<mutex> lock(block_lock);
 	D_ASSERT(free_list.find(block_id) == free_list.end());
 	auto entry = multi_use_blocks.find(block_id);
 	if (entry != multi_use_blocks.end()) {
@@ -272,7 +327,12 @@ unique_ptr<Block> SingleFileBlockManager::CreateBlock(block_id_t block_id) {
 
 void SingleFileBlockManager::Read(Block &block) {
 	D_ASSERT(block.id >= 0);
-	D_ASSERT(std::find(free_list.begin(), free_list.end(), block.id) == free_list.end());
+#ifdef DEBUG
+	{
+		lock_guard<mutex> lock(block_lock);
+		D_ASSERT(std::find(free_list.begin(), free_list.end(), block.id) == free_list.end());
+	}
+#endif
 	block.ReadAndChecksum(*handle, BLOCK_START + block.id * Storage::BLOCK_ALLOC_SIZE);
 }
 
@@ -344,6 +404,11 @@ void SingleFileBlockManager::WriteHeader(DatabaseHeader header) {
 		free_list.insert(block);
 	}
 	modified_blocks.clear();
+	// the free blocks at the end of the file are not written to the free list: the file is truncated instead
+	while (max_block > 0 && free_list.erase(max_block - 1) > 0) {
+		max_block--;
+	}
+	relocate_from = NumericLimits<block_id_t>::Maximum();
 
 	if (!free_list_blocks.empty()) {
 		// there are blocks to write, either in the free_list or in the modified_blocks
@@ -396,6 +461,15 @@ void SingleFileBlockManager::WriteHeader(DatabaseHeader header) {
 	active_header = 1 - active_header;
 	//! Ensure the header write ends up on disk
 	handle->Sync();
+	// the blocks past the end of the file are no longer referenced by the active header: truncate the file
+	auto file_size = BLOCK_START + max_block * Storage::BLOCK_ALLOC_SIZE;
+	if (handle->GetFileSize() > file_size) {
+		handle->Truncate(file_size);
+	}
+}
+
+void SingleFileBlockManager::Sync() {
+	handle->Sync();
 }
 
 } // namespace duckdb
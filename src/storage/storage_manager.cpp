@@ -127,14 +127,14 @@ void StorageManager::LoadDatabase() {
 	}
 }
 
-void StorageManager::CreateCheckpoint(bool delete_wal, bool force_checkpoint) {
+void StorageManager::CreateCheckpoint(bool delete_wal, bool force_checkpoint, bool compact_file) {
 	if (InMemory() || read_only || !wal.initialized) {
 		return;
 	}
 	if (wal.GetWALSize() > 0 || db.config.force_checkpoint || force_checkpoint) {
 		// we only need to checkpoint if there is anything in the WAL
 		CheckpointManager checkpointer(db);
-		checkpointer.CreateCheckpoint();
+		checkpointer.CreateCheckpoint(compact_file);
 	}
 	if (delete_wal) {
 		wal.Delete();
@@ -69,6 +69,11 @@ idx_t ChunkConstantInfo::GetCommittedSelVector(transaction_t min_start_id, trans
 	return TemplatedGetSelVector<CommittedVersionOperator>(min_start_id, min_transaction_id, sel_vector, max_count);
 }
 
+idx_t ChunkConstantInfo::GetCheckpointSelVector(SelectionVector &sel_vector, idx_t max_count) {
+	return TemplatedGetSelVector<TransactionVersionOperator>(TRANSACTION_ID_START - 1, DConstants::INVALID_INDEX,
+	                                                         sel_vector, max_count);
+}
+
 bool ChunkConstantInfo::Fetch(Transaction &transaction, row_t row) {
 	return UseVersion(transaction, insert_id) && !UseVersion(transaction, delete_id);
 }
@@ -159,6 +164,10 @@ idx_t ChunkVectorInfo::GetCommittedSelVector(transaction_t min_start_id, transac
 	return TemplatedGetSelVector<CommittedVersionOperator>(min_start_id, min_transaction_id, sel_vector, max_count);
 }
 
+idx_t ChunkVectorInfo::GetCheckpointSelVector(SelectionVector &sel_vector, idx_t max_count) {
+	return GetSelVector(TRANSACTION_ID_START - 1, DConstants::INVALID_INDEX, sel_vector, max_count);
+}
+
 idx_t ChunkVectorInfo::GetSelVector(Transaction &transaction, SelectionVector &sel_vector, idx_t max_count) {
 	return GetSelVector(transaction.start_time, transaction.transaction_id, sel_vector, max_count);
 }
@@ -219,9 +228,7 @@ void ChunkVectorInfo::CommitAppend(transaction_t commit_id, idx_t start, idx_t e
 
 void ChunkVectorInfo::Serialize(Serializer &serializer) {
 	SelectionVector sel(STANDARD_VECTOR_SIZE);
-	transaction_t start_time = TRANSACTION_ID_START - 1;
-	transaction_t transaction_id = DConstants::INVALID_INDEX;
-	idx_t count = GetSelVector(start_time, transaction_id, sel, STANDARD_VECTOR_SIZE);
+	idx_t count = GetCheckpointSelVector(sel, STANDARD_VECTOR_SIZE);
 	if (count == STANDARD_VECTOR_SIZE) {
 		// nothing is deleted: skip writing anything
 		serializer.Write<ChunkInfoType>(ChunkInfoType::EMPTY_INFO);
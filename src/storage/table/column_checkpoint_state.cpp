@@ -42,27 +42,40 @@ void ColumnCheckpointState::FlushSegment(unique_ptr<ColumnSegment> segment, idx_
 	block_id_t block_id = INVALID_BLOCK;
 	uint32_t offset_in_block = 0;
 	bool need_to_write = true;
-	PartialBlock *partial_block = nullptr;
-	unique_ptr<PartialBlock> owned_partial_block;
 	if (!block_is_constant) {
 		// non-constant block
 		// if the block is less than 80% full, we consider it a "partial block"
 		// which means we will try to fit it with other blocks
 		if (segment_size <= CheckpointManager::PARTIAL_BLOCK_THRESHOLD) {
 			// the block is a partial block
+			// the partial blocks are shared with the columns that are checkpointed in parallel
+			lock_guard<mutex> partial_guard(checkpoint_manager.partial_block_lock);
 			// check if there is a partial block available we can write to
+			PartialBlock *partial_block = nullptr;
+			unique_ptr<PartialBlock> owned_partial_block;
 			if (checkpoint_manager.GetPartialBlock(segment.get(), segment_size, block_id, offset_in_block,
 			                                       partial_block, owned_partial_block)) {
 				//! there is! increase the reference count of this block
 				block_manager.IncreaseBlockReferenceCount(block_id);
+				// pin the current block
+				auto old_handle = buffer_manager.Pin(segment->block);
+				// pin the new block
+				auto new_handle = buffer_manager.Pin(partial_block->block);
+				// memcpy the contents of the old block to the new block
+				memcpy(new_handle->Ptr() + offset_in_block, old_handle->Ptr(), segment_size);
 			} else {
 				// there isn't: generate a new block for this segment
 				block_id = block_manager.GetFreeBlockId();
 				offset_in_block = 0;
-				need_to_write = false;
 				// now register this block as a partial block
 				checkpoint_manager.RegisterPartialBlock(segment.get(), segment_size, block_id);
 			}
+			// the segment is written to disk as part of the partial block
+			need_to_write = false;
+			if (owned_partial_block) {
+				// the partial block has become full: write it to disk
+				owned_partial_block->FlushToDisk(db);
+			}
 		} else {
 			// full block: get a free block to write to
 			block_id = block_manager.GetFreeBlockId();
@@ -90,21 +103,8 @@ void ColumnCheckpointState::FlushSegment(unique_ptr<ColumnSegment> segment, idx_
 	data_pointer.statistics = segment->stats.statistics->Copy();
 
 	if (need_to_write) {
-		if (partial_block) {
-			// pin the current block
-			auto old_handle = buffer_manager.Pin(segment->block);
-			// pin the new block
-			auto new_handle = buffer_manager.Pin(partial_block->block);
-			// memcpy the contents of the old block to the new block
-			memcpy(new_handle->Ptr() + offset_in_block, old_handle->Ptr(), segment_size);
-		} else {
-			// convert the segment into a persistent segment that points to this block
-			segment->ConvertToPersistent(block_id);
-		}
-	}
-	if (owned_partial_block) {
-		// the partial block has become full: write it to disk
-		owned_partial_block->FlushToDisk(db);
+		// convert the segment into a persistent segment that points to this block
+		segment->ConvertToPersistent(block_id);
 	}
 
 	// append the segment to the new segment tree
@@ -112,19 +112,17 @@ void ColumnCheckpointState::FlushSegment(unique_ptr<ColumnSegment> segment, idx_
 	data_pointers.push_back(move(data_pointer));
 }
 
-void ColumnCheckpointState::FlushToDisk() {
-	auto &meta_writer = writer.GetMetaWriter();
-
-	meta_writer.Write<idx_t>(data_pointers.size());
+void ColumnCheckpointState::WriteDataPointers(Serializer &serializer) {
+	serializer.Write<idx_t>(data_pointers.size());
 	// then write the data pointers themselves
 	for (idx_t k = 0; k < data_pointers.size(); k++) {
 		auto &data_pointer = data_pointers[k];
-		meta_writer.Write<idx_t>(data_pointer.row_start);
-		meta_writer.Write<idx_t>(data_pointer.tuple_count);
-		meta_writer.Write<block_id_t>(data_pointer.block_pointer.block_id);
-		meta_writer.Write<uint32_t>(data_pointer.block_pointer.offset);
-		meta_writer.Write<CompressionType>(data_pointer.compression_type);
-		data_pointer.statistics->Serialize(meta_writer);
+		serializer.Write<idx_t>(data_pointer.row_start);
+		serializer.Write<idx_t>(data_pointer.tuple_count);
+		serializer.Write<block_id_t>(data_pointer.block_pointer.block_id);
+		serializer.Write<uint32_t>(data_pointer.block_pointer.offset);
+		serializer.Write<CompressionType>(data_pointer.compression_type);
+		data_pointer.statistics->Serialize(serializer);
 	}
 }
 
@@ -329,6 +329,90 @@ void ColumnData::AppendTransientSegment(idx_t start_row) {
 	data.AppendSegment(move(new_segment));
 }
 
+bool ColumnData::HasUpdates() {
+	lock_guard<mutex> update_guard(update_lock);
+	return updates != nullptr;
+}
+
+void ColumnData::MergeUpdates(const unordered_set<ColumnData *> &merge_columns, double threshold) {
+	if (merge_columns.find(this) != merge_columns.end()) {
+		MergeColumnUpdates(threshold);
+	}
+}
+
+bool ColumnData::CanMergeUpdates(double threshold) {
+	lock_guard<mutex> update_guard(update_lock);
+	return CanMergeUpdatesInternal(threshold);
+}
+
+bool ColumnData::CanMergeUpdatesInternal(double threshold) {
+	if (!updates) {
+		return false;
+	}
+	auto update_count = updates->GetMergeableUpdateCount();
+	if (update_count == 0) {
+		return false;
+	}
+	idx_t row_count = 0;
+	lock_guard<mutex> tree_lock(data.node_lock);
+	auto root_segment = (ColumnSegment *)data.GetRootSegment();
+	for (auto segment = root_segment; segment; segment = (ColumnSegment *)segment->next.get()) {
+		if (segment->segment_type == ColumnSegmentType::PERSISTENT) {
+			// persistent segments are rewritten together with the updates by the next checkpoint
+			return false;
+		}
+		row_count += segment->count;
+	}
+	return update_count >= threshold * row_count;
+}
+
+void ColumnData::MergeColumnUpdates(double threshold) {
+	lock_guard<mutex> update_guard(update_lock);
+	if (!CanMergeUpdatesInternal(threshold)) {
+		return;
+	}
+	// move the old segments out of the tree, and append their data merged with the updates to new transient segments
+	SegmentTree old_tree;
+	{
+		lock_guard<mutex> tree_lock(data.node_lock);
+		old_tree.Replace(data);
+		data.nodes.clear();
+	}
+	try {
+		bool is_validity = type.id() == LogicalTypeId::VALIDITY;
+		Vector intermediate(is_validity ? LogicalType::BOOLEAN : type, true, is_validity);
+		Vector scan_vector(intermediate.GetType(), nullptr);
+		auto stats = BaseStatistics::CreateEmpty(type, StatisticsType::LOCAL_STATS);
+		ColumnAppendState append_state;
+		ColumnData::InitializeAppend(append_state);
+		auto old_root = (ColumnSegment *)old_tree.GetRootSegment();
+		for (auto segment = old_root; segment; segment = (ColumnSegment *)segment->next.get()) {
+			ColumnScanState scan_state;
+			scan_state.current = segment;
+			segment->InitializeScan(scan_state);
+
+			for (idx_t base_row_index = 0; base_row_index < segment->count; base_row_index += STANDARD_VECTOR_SIZE) {
+				scan_vector.Reference(intermediate);
+
+				idx_t count = MinValue<idx_t>(segment->count - base_row_index, STANDARD_VECTOR_SIZE);
+				scan_state.row_index = segment->start + base_row_index;
+
+				ColumnData::CheckpointScan(segment, scan_state, start, count, scan_vector);
+
+				VectorData vdata;
+				scan_vector.Orrify(count, vdata);
+				ColumnData::AppendData(*stats, append_state, vdata, count);
+			}
+		}
+	} catch (...) {
+		// put the old segments back: the updates are not merged
+		lock_guard<mutex> tree_lock(data.node_lock);
+		data.Replace(old_tree);
+		throw;
+	}
+	updates.reset();
+}
+
 void ColumnData::CommitDropColumn() {
 	auto &block_manager = BlockManager::GetBlockManager(GetDatabase());
 	auto segment = (ColumnSegment *)data.GetRootSegment();
@@ -374,6 +458,9 @@ unique_ptr<ColumnCheckpointState> ColumnData::Checkpoint(RowGroup &row_group, Ta
 
 	// replace the old tree with the new one
 	data.Replace(checkpoint_state->new_tree);
+	// the committed updates have been merged into the rewritten segments: drop them, so the next checkpoint can
+	// reference the segments as-is if they are not modified in the meantime
+	updates.reset();
 
 	return checkpoint_state;
 }
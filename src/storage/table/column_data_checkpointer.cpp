@@ -173,11 +173,17 @@ void ColumnDataCheckpointer::WriteToDisk() {
 }
 
 bool ColumnDataCheckpointer::HasChanges() {
+	auto &block_manager = BlockManager::GetBlockManager(GetDatabase());
 	for (auto segment = (ColumnSegment *)owned_segment.get(); segment; segment = (ColumnSegment *)segment->next.get()) {
 		if (segment->segment_type == ColumnSegmentType::TRANSIENT) {
 			// transient segment: always need to write to disk
 			return true;
 		} else {
+			// persistent segment near the end of the file that is compacted: move it to a free block before it
+			auto block_id = segment->GetBlockId();
+			if (block_id != INVALID_BLOCK && block_manager.ShouldRelocateBlock(block_id)) {
+				return true;
+			}
 			// persistent segment; check if there were any updates or deletions in this segment
 			idx_t start_row_idx = segment->start - row_group.start;
 			idx_t end_row_idx = start_row_idx + segment->count;
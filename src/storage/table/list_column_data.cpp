@@ -277,6 +277,16 @@ void ListColumnData::FetchRow(Transaction &transaction, ColumnFetchState &state,
 	}
 }
 
+bool ListColumnData::HasUpdates() {
+	return ColumnData::HasUpdates() || validity.HasUpdates() || child_column->HasUpdates();
+}
+
+void ListColumnData::MergeUpdates(const unordered_set<ColumnData *> &merge_columns, double threshold) {
+	ColumnData::MergeUpdates(merge_columns, threshold);
+	validity.MergeUpdates(merge_columns, threshold);
+	child_column->MergeUpdates(merge_columns, threshold);
+}
+
 void ListColumnData::CommitDropColumn() {
 	validity.CommitDropColumn();
 	child_column->CommitDropColumn();
@@ -300,10 +310,10 @@ public:
 		return stats;
 	}
 
-	void FlushToDisk() override {
-		ColumnCheckpointState::FlushToDisk();
-		validity_state->FlushToDisk();
-		child_state->FlushToDisk();
+	void WriteDataPointers(Serializer &serializer) override {
+		ColumnCheckpointState::WriteDataPointers(serializer);
+		validity_state->WriteDataPointers(serializer);
+		child_state->WriteDataPointers(serializer);
 	}
 };
 
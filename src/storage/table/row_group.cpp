@@ -62,6 +62,11 @@ void RowGroup::InitializeEmpty(const vector<LogicalType> &types) {
 }
 
 bool RowGroup::InitializeScanWithOffset(RowGroupScanState &state, idx_t vector_offset) {
+	if (vector_offset == 0) {
+		// the rows reserved by an optimistic append are counted before they are written to the columns: scanning from
+		// the start of the row group does not look up any row in the columns
+		return InitializeScan(state);
+	}
 	auto &column_ids = state.parent.column_ids;
 	if (state.parent.table_filters) {
 		if (!CheckZonemap(*state.parent.table_filters, column_ids)) {
@@ -474,6 +479,29 @@ idx_t RowGroup::GetCommittedSelVector(transaction_t start_time, transaction_t tr
 	return info->GetCommittedSelVector(start_time, transaction_id, sel_vector, max_count);
 }
 
+idx_t RowGroup::GetCheckpointSelVector(idx_t vector_idx, SelectionVector &sel_vector, idx_t max_count) {
+	lock_guard<mutex> lock(row_group_lock);
+
+	auto info = GetChunkInfo(vector_idx);
+	if (!info) {
+		return max_count;
+	}
+	return info->GetCheckpointSelVector(sel_vector, max_count);
+}
+
+idx_t RowGroup::GetCheckpointRowCount() {
+	if (!version_info) {
+		return count;
+	}
+	SelectionVector sel(STANDARD_VECTOR_SIZE);
+	idx_t row_count = 0;
+	for (idx_t vector_idx = 0; vector_idx * STANDARD_VECTOR_SIZE < count; vector_idx++) {
+		auto max_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, count - vector_idx * STANDARD_VECTOR_SIZE);
+		row_count += GetCheckpointSelVector(vector_idx, sel, max_count);
+	}
+	return row_count;
+}
+
 bool RowGroup::Fetch(Transaction &transaction, idx_t row) {
 	D_ASSERT(row < this->count);
 	lock_guard<mutex> lock(row_group_lock);
@@ -580,6 +608,13 @@ void RowGroup::RevertAppend(idx_t row_group_start) {
 
 void RowGroup::InitializeAppend(Transaction &transaction, RowGroupAppendState &append_state,
                                 idx_t remaining_append_count) {
+	InitializeAppend(append_state);
+	// append the version info for this row_group
+	idx_t append_count = MinValue<idx_t>(remaining_append_count, RowGroup::ROW_GROUP_SIZE - this->count);
+	AppendVersionInfo(transaction, this->count, append_count, transaction.transaction_id);
+}
+
+void RowGroup::InitializeAppend(RowGroupAppendState &append_state) {
 	append_state.row_group = this;
 	append_state.offset_in_row_group = this->count;
 	// for each column, initialize the append state
@@ -587,9 +622,6 @@ void RowGroup::InitializeAppend(Transaction &transaction, RowGroupAppendState &a
 	for (idx_t i = 0; i < columns.size(); i++) {
 		columns[i]->InitializeAppend(append_state.states[i]);
 	}
-	// append the version info for this row_group
-	idx_t append_count = MinValue<idx_t>(remaining_append_count, RowGroup::ROW_GROUP_SIZE - this->count);
-	AppendVersionInfo(transaction, this->count, append_count, transaction.transaction_id);
 }
 
 void RowGroup::Append(RowGroupAppendState &state, DataChunk &chunk, idx_t append_count) {
@@ -648,22 +680,22 @@ void RowGroup::MergeStatistics(idx_t column_idx, BaseStatistics &other) {
 	stats[column_idx]->statistics->Merge(other);
 }
 
-RowGroupPointer RowGroup::Checkpoint(TableDataWriter &writer, vector<unique_ptr<BaseStatistics>> &global_stats) {
-	vector<unique_ptr<ColumnCheckpointState>> states;
-	states.reserve(columns.size());
-
-	// checkpoint the individual columns of the row group
-	for (idx_t column_idx = 0; column_idx < columns.size(); column_idx++) {
-		auto &column = columns[column_idx];
-		ColumnCheckpointInfo checkpoint_info {writer.GetColumnCompressionType(column_idx)};
-		auto checkpoint_state = column->Checkpoint(*this, writer, checkpoint_info);
-		D_ASSERT(checkpoint_state);
+unique_ptr<ColumnCheckpointState> RowGroup::CheckpointColumn(TableDataWriter &writer, idx_t column_idx) {
+	auto &column = columns[column_idx];
+	ColumnCheckpointInfo checkpoint_info {writer.GetColumnCompressionType(column_idx)};
+	auto checkpoint_state = column->Checkpoint(*this, writer, checkpoint_info);
+	D_ASSERT(checkpoint_state);
+	return checkpoint_state;
+}
 
-		auto stats = checkpoint_state->GetStatistics();
+RowGroupPointer RowGroup::Checkpoint(TableDataWriter &writer, vector<unique_ptr<BaseStatistics>> &global_stats,
+                                     vector<unique_ptr<ColumnCheckpointState>> states) {
+	// merge the statistics of the individual columns into the global statistics
+	for (idx_t column_idx = 0; column_idx < states.size(); column_idx++) {
+		auto stats = states[column_idx]->GetStatistics();
 		D_ASSERT(stats);
 
 		global_stats[column_idx]->Merge(*stats);
-		states.push_back(move(checkpoint_state));
 	}
 
 	// construct the row group pointer and write the column meta data to disk
@@ -680,14 +712,63 @@ RowGroupPointer RowGroup::Checkpoint(TableDataWriter &writer, vector<unique_ptr<
 		row_group_pointer.data_pointers.push_back(pointer);
 		row_group_pointer.statistics.push_back(state->GetStatistics());
 
-		// now flush the actual column data to disk
-		state->FlushToDisk();
+		// now write the data pointers of the column
+		state->WriteDataPointers(meta_writer);
 	}
 	row_group_pointer.versions = version_info;
 	Verify();
 	return row_group_pointer;
 }
 
+void RowGroup::SerializeColumnData(vector<unique_ptr<ColumnCheckpointState>> &states, Serializer &serializer) {
+	D_ASSERT(states.size() == columns.size());
+	serializer.Write<idx_t>(start);
+	serializer.Write<idx_t>(count);
+	for (auto &state : states) {
+		state->GetStatistics()->Serialize(serializer);
+	}
+	for (auto &state : states) {
+		state->WriteDataPointers(serializer);
+	}
+}
+
+unique_ptr<RowGroup> RowGroup::DeserializeColumnData(Transaction &transaction, DataTableInfo &table_info,
+                                                     const vector<LogicalType> &types, Deserializer &source) {
+	auto row_start = source.Read<idx_t>();
+	auto tuple_count = source.Read<idx_t>();
+	if (tuple_count == 0 || tuple_count > RowGroup::ROW_GROUP_SIZE) {
+		throw IOException("Row group has an invalid tuple count. Corrupt file?");
+	}
+	// the count is set when the version info is appended
+	auto row_group = make_unique<RowGroup>(table_info.db, table_info, row_start, 0);
+	for (auto &type : types) {
+		auto stats = BaseStatistics::Deserialize(source, type);
+		auto stats_type = stats->type;
+		row_group->stats.push_back(make_shared<SegmentStatistics>(stats_type, move(stats)));
+	}
+	for (idx_t i = 0; i < types.size(); i++) {
+		row_group->columns.push_back(ColumnData::Deserialize(table_info, i, row_start, source, types[i], nullptr));
+	}
+	row_group->AppendVersionInfo(transaction, 0, tuple_count, transaction.transaction_id);
+	row_group->Verify();
+	return row_group;
+}
+
+bool RowGroup::HasUpdates() {
+	for (auto &column : columns) {
+		if (column->HasUpdates()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void RowGroup::MergeUpdates(const unordered_set<ColumnData *> &merge_columns, double threshold) {
+	for (auto &column : columns) {
+		column->MergeUpdates(merge_columns, threshold);
+	}
+}
+
 void RowGroup::CheckpointDeletes(VersionNode *versions, Serializer &serializer) {
 	if (!versions) {
 		// no version information: write nothing
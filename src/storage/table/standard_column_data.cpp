@@ -145,6 +145,15 @@ void StandardColumnData::FetchRow(Transaction &transaction, ColumnFetchState &st
 	ColumnData::FetchRow(transaction, state, row_id, result, result_idx);
 }
 
+bool StandardColumnData::HasUpdates() {
+	return ColumnData::HasUpdates() || validity.HasUpdates();
+}
+
+void StandardColumnData::MergeUpdates(const unordered_set<ColumnData *> &merge_columns, double threshold) {
+	ColumnData::MergeUpdates(merge_columns, threshold);
+	validity.MergeUpdates(merge_columns, threshold);
+}
+
 void StandardColumnData::CommitDropColumn() {
 	ColumnData::CommitDropColumn();
 	validity.CommitDropColumn();
@@ -164,9 +173,9 @@ public:
 		return stats;
 	}
 
-	void FlushToDisk() override {
-		ColumnCheckpointState::FlushToDisk();
-		validity_state->FlushToDisk();
+	void WriteDataPointers(Serializer &serializer) override {
+		ColumnCheckpointState::WriteDataPointers(serializer);
+		validity_state->WriteDataPointers(serializer);
 	}
 };
 
@@ -177,8 +186,11 @@ unique_ptr<ColumnCheckpointState> StandardColumnData::CreateCheckpointState(RowG
 
 unique_ptr<ColumnCheckpointState> StandardColumnData::Checkpoint(RowGroup &row_group, TableDataWriter &writer,
                                                                  ColumnCheckpointInfo &checkpoint_info) {
-	auto validity_state = validity.Checkpoint(row_group, writer, checkpoint_info);
+	// the base column is checkpointed first: its checkpoint scans the validity, which has to be the original data
+	// checkpointing the validity first would scan its new segments, which might be in a partial block that is
+	// concurrently written to disk by the checkpoint of another column
 	auto base_state = ColumnData::Checkpoint(row_group, writer, checkpoint_info);
+	auto validity_state = validity.Checkpoint(row_group, writer, checkpoint_info);
 	auto &checkpoint_state = (StandardColumnCheckpointState &)*base_state;
 	checkpoint_state.validity_state = move(validity_state);
 	return base_state;
@@ -210,6 +210,25 @@ void StructColumnData::FetchRow(Transaction &transaction, ColumnFetchState &stat
 	}
 }
 
+bool StructColumnData::HasUpdates() {
+	if (validity.HasUpdates()) {
+		return true;
+	}
+	for (auto &sub_column : sub_columns) {
+		if (sub_column->HasUpdates()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void StructColumnData::MergeUpdates(const unordered_set<ColumnData *> &merge_columns, double threshold) {
+	validity.MergeUpdates(merge_columns, threshold);
+	for (auto &sub_column : sub_columns) {
+		sub_column->MergeUpdates(merge_columns, threshold);
+	}
+}
+
 void StructColumnData::CommitDropColumn() {
 	validity.CommitDropColumn();
 	for (auto &sub_column : sub_columns) {
@@ -238,10 +257,10 @@ public:
 		return move(stats);
 	}
 
-	void FlushToDisk() override {
-		validity_state->FlushToDisk();
+	void WriteDataPointers(Serializer &serializer) override {
+		validity_state->WriteDataPointers(serializer);
 		for (auto &state : child_states) {
-			state->FlushToDisk();
+			state->WriteDataPointers(serializer);
 		}
 	}
 };
@@ -44,6 +44,26 @@ void UpdateSegment::ClearUpdates() {
 	heap.Destroy();
 }
 
+idx_t UpdateSegment::GetMergeableUpdateCount() {
+	auto lock_handle = lock.GetSharedLock();
+	if (!root) {
+		return 0;
+	}
+	idx_t update_count = 0;
+	for (idx_t vector_idx = 0; vector_idx < RowGroup::ROW_GROUP_VECTOR_COUNT; vector_idx++) {
+		if (!root->info[vector_idx]) {
+			continue;
+		}
+		auto base_info = root->info[vector_idx]->info.get();
+		if (base_info->next) {
+			// an older version is still required, or the update is not committed yet
+			return 0;
+		}
+		update_count += base_info->N;
+	}
+	return update_count;
+}
+
 //===--------------------------------------------------------------------===//
 // Update Info Helpers
 //===--------------------------------------------------------------------===//
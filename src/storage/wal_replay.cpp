@@ -2,12 +2,17 @@
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/type_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/view_catalog_entry.hpp"
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/printer.hpp"
+#include "duckdb/common/serializer/buffered_deserializer.hpp"
 #include "duckdb/common/serializer/buffered_file_reader.hpp"
 #include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/chunk_collection.hpp"
+#include "duckdb/common/unordered_map.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/connection.hpp"
 #include "duckdb/main/database.hpp"
+#include "duckdb/parallel/task_counter.hpp"
 #include "duckdb/parser/parsed_data/alter_table_info.hpp"
 #include "duckdb/parser/parsed_data/create_schema_info.hpp"
 #include "duckdb/parser/parsed_data/create_view_info.hpp"
@@ -16,14 +21,23 @@
 #include "duckdb/planner/parsed_data/bound_create_table_info.hpp"
 #include "duckdb/storage/data_table.hpp"
 #include "duckdb/storage/write_ahead_log.hpp"
+#include "duckdb/transaction/transaction.hpp"
+
+#include <exception>
 
 namespace duckdb {
 
+typedef unordered_map<TableCatalogEntry *, unique_ptr<ChunkCollection>> replay_inserts_t;
+
 class ReplayState {
+public:
+	//! The maximum amount of rows of consecutive insert-only transactions that are appended and committed together
+	static constexpr const idx_t MAX_BATCH_COUNT = 1048576;
+
 public:
 	ReplayState(DatabaseInstance &db, ClientContext &context, Deserializer &source)
 	    : db(db), context(context), source(source), current_table(nullptr), deserialize_only(false),
-	      checkpoint_id(INVALID_BLOCK) {
+	      checkpoint_id(INVALID_BLOCK), only_inserts(true), batch_count(0) {
 	}
 
 	DatabaseInstance &db;
@@ -32,10 +46,30 @@ public:
 	TableCatalogEntry *current_table;
 	bool deserialize_only;
 	block_id_t checkpoint_id;
+	//! Whether or not the WAL transaction that is being replayed has only inserted data so far
+	bool only_inserts;
+	//! The inserts of the WAL transaction that is being replayed, per table
+	replay_inserts_t transaction_inserts;
+	//! The inserts of the preceding insert-only WAL transactions, per transaction
+	vector<replay_inserts_t> batch_transactions;
+	//! The amount of rows in the batch_transactions
+	idx_t batch_count;
 
 public:
 	void ReplayEntry(WALType entry_type);
 
+	//! Whether or not the entry only inserts data, i.e. can be replayed together with other inserts
+	static bool IsInsertEntry(WALType entry_type);
+	//! Adds the inserts of the WAL transaction that has been replayed to the batch
+	void FinishTransaction();
+	//! Appends the batched inserts to the tables. If that fails, the batched transactions are rolled back and appended
+	//! and committed one at a time instead, so only the failing transaction and the transactions after it are lost.
+	void AppendBatch(Connection &con);
+	//! Appends the inserts of the transactions to the row groups of their tables, the tables are appended to in parallel
+	void AppendInserts(vector<replay_inserts_t> &transactions);
+	//! Rolls back the WAL transaction that failed to replay, the batched transactions preceding it are committed
+	void RollbackTransaction(Connection &con);
+
 private:
 	void ReplayCreateTable();
 	void ReplayDropTable();
@@ -64,6 +98,7 @@ private:
 	void ReplayInsert();
 	void ReplayDelete();
 	void ReplayUpdate();
+	void ReplayRowGroupData();
 	void ReplayCheckpoint();
 };
 
@@ -96,11 +131,10 @@ bool WriteAheadLog::Replay(DatabaseInstance &database, string &path) {
 			}
 		}
 	} catch (std::exception &ex) { // LCOV_EXCL_START
+		// the WAL is torn or corrupt: the transactions preceding the failed entry are still replayed below
 		Printer::Print(StringUtil::Format("Exception in WAL playback during initial read: %s\n", ex.what()));
-		return false;
 	} catch (...) {
 		Printer::Print("Unknown Exception in WAL playback during initial read");
-		return false;
 	} // LCOV_EXCL_STOP
 	initial_reader.reset();
 	if (checkpoint_state.checkpoint_id != INVALID_BLOCK) {
@@ -126,16 +160,38 @@ bool WriteAheadLog::Replay(DatabaseInstance &database, string &path) {
 			// read the current entry
 			WALType entry_type = reader.Read<WALType>();
 			if (entry_type == WALType::WAL_FLUSH) {
+				// check if the file is exhausted
+				bool finished = reader.Finished();
+				// insert-only transactions are appended and committed together with the transactions that follow
+				bool batch_transaction = state.only_inserts;
+				state.FinishTransaction();
+				if (batch_transaction && !finished && state.batch_count < ReplayState::MAX_BATCH_COUNT) {
+					continue;
+				}
 				// flush: commit the current transaction
+				state.AppendBatch(con);
 				con.Commit();
-				// check if the file is exhausted
-				if (reader.Finished()) {
+				if (finished) {
 					// we finished reading the file: break
 					break;
 				}
 				// otherwise we keep on reading
 				con.BeginTransaction();
 			} else {
+				if (!ReplayState::IsInsertEntry(entry_type)) {
+					if (state.only_inserts && !state.batch_transactions.empty()) {
+						// the entry might depend on the batched transactions: commit them first
+						state.AppendBatch(con);
+						con.Commit();
+						con.BeginTransaction();
+					}
+					state.only_inserts = false;
+					// the inserts of this transaction precede the entry
+					vector<replay_inserts_t> preceding_inserts;
+					preceding_inserts.push_back(move(state.transaction_inserts));
+					state.transaction_inserts.clear();
+					state.AppendInserts(preceding_inserts);
+				}
 				// replay the entry
 				state.ReplayEntry(entry_type);
 			}
@@ -144,11 +200,11 @@ bool WriteAheadLog::Replay(DatabaseInstance &database, string &path) {
 		// FIXME: this should report a proper warning in the connection
 		Printer::Print(StringUtil::Format("Exception in WAL playback: %s\n", ex.what()));
 		// exception thrown in WAL replay: rollback
-		con.Rollback();
+		state.RollbackTransaction(con);
 	} catch (...) {
 		Printer::Print("Unknown Exception in WAL playback: %s\n");
 		// exception thrown in WAL replay: rollback
-		con.Rollback();
+		state.RollbackTransaction(con);
 	} // LCOV_EXCL_STOP
 	return false;
 }
@@ -156,6 +212,12 @@ bool WriteAheadLog::Replay(DatabaseInstance &database, string &path) {
 //===--------------------------------------------------------------------===//
 // Replay Entries
 //===--------------------------------------------------------------------===//
+constexpr const idx_t ReplayState::MAX_BATCH_COUNT;
+
+bool ReplayState::IsInsertEntry(WALType entry_type) {
+	return entry_type == WALType::USE_TABLE || entry_type == WALType::INSERT_TUPLE;
+}
+
 void ReplayState::ReplayEntry(WALType entry_type) {
 	switch (entry_type) {
 	case WALType::CREATE_TABLE:
@@ -212,6 +274,9 @@ void ReplayState::ReplayEntry(WALType entry_type) {
 	case WALType::UPDATE_TUPLE:
 		ReplayUpdate();
 		break;
+	case WALType::ROW_GROUP_DATA:
+		ReplayRowGroupData();
+		break;
 	case WALType::CHECKPOINT:
 		ReplayCheckpoint();
 		break;
@@ -465,8 +530,182 @@ void ReplayState::ReplayInsert() {
 		throw Exception("Corrupt WAL: insert without table");
 	}
 
-	// append to the current table
-	current_table->storage->Append(*current_table, context, chunk);
+	if (chunk.ColumnCount() != current_table->StandardColumnCount()) {
+		throw InternalException("Corrupt WAL: mismatch in column count for insert");
+	}
+
+	// the rows are appended directly to the table when the transaction is finished
+	auto &inserts = transaction_inserts[current_table];
+	if (!inserts) {
+		inserts = make_unique<ChunkCollection>();
+	}
+	inserts->Append(chunk);
+}
+
+void ReplayState::FinishTransaction() {
+	if (!transaction_inserts.empty()) {
+		for (auto &entry : transaction_inserts) {
+			batch_count += entry.second->Count();
+		}
+		batch_transactions.push_back(move(transaction_inserts));
+		transaction_inserts.clear();
+	}
+	only_inserts = true;
+}
+
+void ReplayState::AppendBatch(Connection &con) {
+	auto transactions = move(batch_transactions);
+	batch_transactions.clear();
+	batch_count = 0;
+	if (transactions.size() <= 1) {
+		AppendInserts(transactions);
+		return;
+	}
+	try {
+		AppendInserts(transactions);
+		return;
+	} catch (std::exception &ex) {
+		Printer::Print(StringUtil::Format("Exception in WAL playback: %s\n", ex.what()));
+	}
+	// find the failing transaction: the batch only contains insert-only transactions, so rolling back the connection
+	// only reverts the appends of the batch
+	con.Rollback();
+	for (auto &transaction : transactions) {
+		con.BeginTransaction();
+		vector<replay_inserts_t> inserts;
+		inserts.push_back(move(transaction));
+		AppendInserts(inserts);
+		con.Commit();
+	}
+	con.BeginTransaction();
+}
+
+void ReplayState::RollbackTransaction(Connection &con) {
+	// the batched transactions were flushed to the WAL completely, e.g. only the tail of the WAL might be torn
+	// while there are batched transactions, the failed transaction has not been appended to the tables yet
+	if (!batch_transactions.empty()) {
+		try {
+			AppendBatch(con);
+			con.Commit();
+			return;
+		} catch (std::exception &ex) {
+			Printer::Print(StringUtil::Format("Exception in WAL playback: %s\n", ex.what()));
+		}
+	}
+	if (!con.IsAutoCommit()) {
+		con.Rollback();
+	}
+}
+
+//! Appends the rows to the row groups of the table, bypassing the transaction-local storage. Returns the first row id.
+static idx_t ReplayAppend(Transaction &transaction, DataTable &table, const vector<ChunkCollection *> &collections) {
+	idx_t count = 0;
+	for (auto &collection : collections) {
+		count += collection->Count();
+	}
+	TableAppendState append_state;
+	table.InitializeAppend(transaction, append_state, count);
+	for (idx_t collection_idx = 0; collection_idx < collections.size(); collection_idx++) {
+		auto &collection = *collections[collection_idx];
+		for (idx_t chunk_idx = 0; chunk_idx < collection.ChunkCount(); chunk_idx++) {
+			auto &chunk = collection.GetChunk(chunk_idx);
+			if (!table.AppendToIndexes(append_state, chunk, append_state.current_row)) {
+				// revert the append: remove the chunks that were already appended from the indexes
+				row_t current_row = append_state.row_start;
+				for (idx_t revert_idx = 0; revert_idx <= collection_idx; revert_idx++) {
+					auto &revert_collection = *collections[revert_idx];
+					auto revert_count = revert_idx < collection_idx ? revert_collection.ChunkCount() : chunk_idx;
+					for (idx_t revert_chunk_idx = 0; revert_chunk_idx < revert_count; revert_chunk_idx++) {
+						auto &revert_chunk = revert_collection.GetChunk(revert_chunk_idx);
+						table.RemoveFromIndexes(append_state, revert_chunk, current_row);
+						current_row += revert_chunk.size();
+					}
+				}
+				table.RevertAppendInternal(append_state.row_start, count);
+				throw ConstraintException("PRIMARY KEY or UNIQUE constraint violated: duplicated key");
+			}
+			table.Append(transaction, chunk, append_state);
+		}
+	}
+	return append_state.row_start;
+}
+
+struct ReplayTableAppend {
+	DataTable *table;
+	//! The inserts into the table, in the order of the transactions
+	vector<ChunkCollection *> collections;
+	idx_t count;
+	idx_t row_start;
+	bool appended;
+	std::exception_ptr error;
+};
+
+class ReplayAppendTask : public Task {
+public:
+	ReplayAppendTask(TaskCounter &counter, Transaction &transaction, ReplayTableAppend &append)
+	    : counter(counter), transaction(transaction), append(append) {
+	}
+
+	TaskCounter &counter;
+	Transaction &transaction;
+	ReplayTableAppend &append;
+
+public:
+	TaskExecutionResult Execute(TaskExecutionMode mode) override {
+		try {
+			append.row_start = ReplayAppend(transaction, *append.table, append.collections);
+			append.appended = true;
+		} catch (...) {
+			append.error = std::current_exception();
+		}
+		counter.FinishTask();
+		return TaskExecutionResult::TASK_FINISHED;
+	}
+};
+
+void ReplayState::AppendInserts(vector<replay_inserts_t> &transactions) {
+	vector<ReplayTableAppend> appends;
+	unordered_map<TableCatalogEntry *, idx_t> append_indexes;
+	for (auto &inserts : transactions) {
+		for (auto &entry : inserts) {
+			auto append_index = append_indexes.find(entry.first);
+			if (append_index == append_indexes.end()) {
+				ReplayTableAppend append;
+				append.table = entry.first->storage.get();
+				append.count = 0;
+				append.row_start = 0;
+				append.appended = false;
+				append_index = append_indexes.insert(make_pair(entry.first, appends.size())).first;
+				appends.push_back(move(append));
+			}
+			auto &append = appends[append_index->second];
+			append.collections.push_back(entry.second.get());
+			append.count += entry.second->Count();
+		}
+	}
+	if (appends.empty()) {
+		return;
+	}
+
+	// the tables are independent: append to them in parallel, the rows of a table are appended in order
+	auto &transaction = Transaction::GetTransaction(context);
+	TaskCounter counter(TaskScheduler::GetScheduler(db));
+	for (auto &append : appends) {
+		counter.AddTask(make_unique<ReplayAppendTask>(counter, transaction, append));
+	}
+	counter.Finish();
+
+	// register the appends with the transaction, so they are committed or reverted together
+	for (auto &append : appends) {
+		if (append.appended) {
+			transaction.PushAppend(append.table, append.row_start, append.count);
+		}
+	}
+	for (auto &append : appends) {
+		if (append.error) {
+			std::rethrow_exception(append.error);
+		}
+	}
 }
 
 void ReplayState::ReplayDelete() {
@@ -519,6 +758,21 @@ void ReplayState::ReplayUpdate() {
 	current_table->storage->UpdateColumn(*current_table, context, row_ids, column_path, chunk);
 }
 
+void ReplayState::ReplayRowGroupData() {
+	auto size = source.Read<idx_t>();
+	auto data = unique_ptr<data_t[]>(new data_t[size]);
+	source.ReadData(data.get(), size);
+	if (deserialize_only) {
+		return;
+	}
+	if (!current_table) {
+		throw InternalException("Corrupt WAL: row group data without table");
+	}
+	// the blocks of the row groups were written to the database file when the transaction committed
+	BufferedDeserializer row_group_source(data.get(), size);
+	current_table->storage->AppendRowGroupData(Transaction::GetTransaction(context), row_group_source);
+}
+
 void ReplayState::ReplayCheckpoint() {
 	checkpoint_id = source.Read<block_id_t>();
 }
@@ -5,17 +5,25 @@
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/type_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/view_catalog_entry.hpp"
+#include "duckdb/common/serializer/buffered_serializer.hpp"
+#include "duckdb/common/thread.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/parser/parsed_data/alter_table_info.hpp"
+#include <chrono>
 #include <cstring>
 
 namespace duckdb {
 
-WriteAheadLog::WriteAheadLog(DatabaseInstance &database) : initialized(false), skip_writing(false), database(database) {
+WriteAheadLog::WriteAheadLog(DatabaseInstance &database)
+    : initialized(false), skip_writing(false), write_row_groups(false), database(database), sync_running(false),
+      synced_position(0), flushed_position(0) {
 }
 
 void WriteAheadLog::Initialize(string &path) {
 	wal_path = path;
+	// positions are relative to the writer, which starts from scratch
+	synced_position = 0;
+	flushed_position = 0;
 	writer = make_unique<BufferedFileWriter>(database.GetFileSystem(), path.c_str(),
 	                                         FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE |
 	                                             FileFlags::FILE_FLAGS_APPEND);
@@ -41,6 +49,11 @@ void WriteAheadLog::Delete() {
 		return;
 	}
 	initialized = false;
+	{
+		// wait for a running group sync to finish before closing the file
+		unique_lock<mutex> guard(sync_lock);
+		sync_finished.wait(guard, [&] { return !sync_running; });
+	}
 	writer.reset();
 
 	auto &fs = FileSystem::GetFileSystem(database);
@@ -260,6 +273,17 @@ void WriteAheadLog::WriteUpdate(DataChunk &chunk, const vector<column_t> &column
 	chunk.Serialize(*writer);
 }
 
+void WriteAheadLog::WriteRowGroupData(BufferedSerializer &row_group_data) {
+	if (skip_writing) {
+		return;
+	}
+	// the data is written as a blob with a size prefix, so the entry can be skipped without knowing the table
+	auto blob = row_group_data.GetData();
+	writer->Write<WALType>(WALType::ROW_GROUP_DATA);
+	writer->Write<idx_t>(blob.size);
+	writer->WriteData(blob.data.get(), blob.size);
+}
+
 //===--------------------------------------------------------------------===//
 // Write ALTER Statement
 //===--------------------------------------------------------------------===//
@@ -284,4 +308,49 @@ void WriteAheadLog::Flush() {
 	writer->Sync();
 }
 
+idx_t WriteAheadLog::FlushWithoutSync() {
+	D_ASSERT(!skip_writing);
+	writer->Write<WALType>(WALType::WAL_FLUSH);
+	writer->Flush();
+	idx_t position = writer->GetTotalWritten();
+	flushed_position = position;
+	return position;
+}
+
+void WriteAheadLog::GroupSync(idx_t position, idx_t window) {
+	unique_lock<mutex> guard(sync_lock);
+	while (synced_position < position) {
+		if (sync_running) {
+			// another commit is syncing: wait for it, the sync might include our changes
+			sync_finished.wait(guard);
+			continue;
+		}
+		// no sync is running: this commit syncs for the group
+		sync_running = true;
+		guard.unlock();
+		if (window > 0) {
+			// give concurrent commits the chance to write their changes so they can share this sync
+			std::this_thread::sleep_for(std::chrono::microseconds(window));
+		}
+		// everything up to the flushed position has been written to the file before the sync starts
+		idx_t sync_position = flushed_position;
+		string error;
+		try {
+			writer->handle->Sync();
+		} catch (std::exception &ex) {
+			error = ex.what();
+		}
+		guard.lock();
+		sync_running = false;
+		if (error.empty()) {
+			synced_position = MaxValue<idx_t>(synced_position, sync_position);
+		}
+		sync_finished.notify_all();
+		if (!error.empty()) {
+			// the changes are already visible to other transactions: we cannot roll back the commit anymore
+			throw FatalException("Failed to sync the write-ahead log: %s", error);
+		}
+	}
+}
+
 } // namespace duckdb
@@ -6,12 +6,15 @@
 
 #include "duckdb/catalog/catalog.hpp"
 #include "duckdb/catalog/dependency_manager.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/storage/table/column_data.hpp"
 #include "duckdb/storage/table/chunk_info.hpp"
 #include "duckdb/storage/table/update_segment.hpp"
 
 namespace duckdb {
 
-CleanupState::CleanupState() : current_table(nullptr), count(0) {
+CleanupState::CleanupState(unordered_set<ColumnData *> &merge_columns)
+    : merge_columns(merge_columns), current_table(nullptr), count(0) {
 }
 
 CleanupState::~CleanupState() {
@@ -46,6 +49,17 @@ void CleanupState::CleanupUpdate(UpdateInfo *info) {
 	// remove the update info from the update chain
 	// first obtain an exclusive lock on the segment
 	info->segment->CleanupUpdate(info);
+	// the updates are merged by the transaction manager once no transaction is running
+	// the column is only recorded if its updates can be merged: the merge is not scheduled for columns that are not
+	// merged anyway
+	auto &column = info->segment->column_data;
+	if (merge_columns.find(&column) != merge_columns.end()) {
+		return;
+	}
+	auto threshold = DBConfig::GetConfig(column.GetDatabase()).update_merge_threshold;
+	if (column.CanMergeUpdates(threshold)) {
+		merge_columns.insert(&column);
+	}
 }
 
 void CleanupState::CleanupDelete(DeleteInfo *info) {
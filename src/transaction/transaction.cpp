@@ -86,7 +86,8 @@ bool Transaction::AutomaticCheckpoint(DatabaseInstance &db) {
 	return expected_wal_size > config.checkpoint_wal_size;
 }
 
-string Transaction::Commit(DatabaseInstance &db, transaction_t commit_id, bool checkpoint) noexcept {
+string Transaction::Commit(DatabaseInstance &db, transaction_t commit_id, bool checkpoint,
+                           bool write_row_groups) noexcept {
 	this->commit_id = commit_id;
 	auto &storage_manager = StorageManager::GetStorageManager(db);
 	auto log = storage_manager.GetWriteAheadLog();
@@ -109,6 +110,9 @@ string Transaction::Commit(DatabaseInstance &db, transaction_t commit_id, bool c
 			// this saves us a lot of unnecessary writes to disk in the case of large commits
 			log->skip_writing = true;
 		}
+		if (log) {
+			log->write_row_groups = write_row_groups;
+		}
 		storage.Commit(commit_state, *this, log, commit_id);
 		undo_buffer.Commit(iterator_state, log, commit_id);
 		if (log) {
@@ -120,15 +124,22 @@ string Transaction::Commit(DatabaseInstance &db, transaction_t commit_id, bool c
 			if (log->GetTotalWritten() > initial_written) {
 				D_ASSERT(!checkpoint);
 				D_ASSERT(!log->skip_writing);
-				log->Flush();
+				if (DBConfig::GetConfig(db).wal_group_commit_window > 0) {
+					// group commit: the WAL is synced after the transaction lock has been released
+					wal_sync_position = log->FlushWithoutSync();
+				} else {
+					log->Flush();
+				}
 			}
 			log->skip_writing = false;
+			log->write_row_groups = false;
 		}
 		return string();
 	} catch (std::exception &ex) {
 		undo_buffer.RevertCommit(iterator_state, transaction_id);
 		if (log) {
 			log->skip_writing = false;
+			log->write_row_groups = false;
 			if (log->GetTotalWritten() > initial_written) {
 				// remove any entries written into the WAL by truncating it
 				log->Truncate(initial_wal_size);
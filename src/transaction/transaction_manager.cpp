@@ -5,11 +5,18 @@
 #include "duckdb/common/helper.hpp"
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/catalog/dependency_manager.hpp"
+#include "duckdb/storage/data_table.hpp"
 #include "duckdb/storage/storage_manager.hpp"
+#include "duckdb/storage/write_ahead_log.hpp"
 #include "duckdb/transaction/transaction.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/client_data.hpp"
+#include "duckdb/main/config.hpp"
 #include "duckdb/main/connection_manager.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 namespace duckdb {
 
@@ -38,7 +45,9 @@ struct CheckpointLock {
 	}
 };
 
-TransactionManager::TransactionManager(DatabaseInstance &db) : db(db), thread_is_checkpointing(false) {
+TransactionManager::TransactionManager(DatabaseInstance &db)
+    : db(db), thread_is_checkpointing(false), background_failed(false), merge_failed(false),
+      background_scheduled(false), background_merge_scheduled(false), background_stopped(false) {
 	// start timestamp starts at zero
 	current_start_timestamp = 0;
 	// transaction ID starts very high:
@@ -53,6 +62,7 @@ TransactionManager::TransactionManager(DatabaseInstance &db) : db(db), thread_is
 }
 
 TransactionManager::~TransactionManager() {
+	StopBackgroundCheckpoints();
 }
 
 Transaction *TransactionManager::StartTransaction(ClientContext &context) {
@@ -87,17 +97,21 @@ struct ClientLockWrapper {
 	ClientLockWrapper(mutex &client_lock, shared_ptr<ClientContext> connection)
 	    : connection(move(connection)), connection_lock(make_unique<lock_guard<mutex>>(client_lock)) {
 	}
+	//! Wraps a client lock that is already held
+	ClientLockWrapper(mutex &client_lock, shared_ptr<ClientContext> connection, std::adopt_lock_t)
+	    : connection(move(connection)), connection_lock(make_unique<lock_guard<mutex>>(client_lock, std::adopt_lock)) {
+	}
 
 	shared_ptr<ClientContext> connection;
 	unique_ptr<lock_guard<mutex>> connection_lock;
 };
 
-void TransactionManager::LockClients(vector<ClientLockWrapper> &client_locks, ClientContext &context) {
-	auto &connection_manager = ConnectionManager::Get(context);
+void TransactionManager::LockClients(vector<ClientLockWrapper> &client_locks, ClientContext *context) {
+	auto &connection_manager = ConnectionManager::Get(db);
 	client_locks.emplace_back(connection_manager.connections_lock, nullptr);
 	auto connection_list = connection_manager.GetConnectionList();
 	for (auto &con : connection_list) {
-		if (con.get() == &context) {
+		if (con.get() == context) {
 			continue;
 		}
 		auto &context_lock = con->context_lock;
@@ -105,9 +119,39 @@ void TransactionManager::LockClients(vector<ClientLockWrapper> &client_locks, Cl
 	}
 }
 
+bool TransactionManager::TryLockClients(vector<ClientLockWrapper> &client_locks) {
+	auto &connection_manager = ConnectionManager::Get(db);
+	if (!connection_manager.connections_lock.try_lock()) {
+		return false;
+	}
+	client_locks.emplace_back(connection_manager.connections_lock, nullptr, std::adopt_lock);
+	auto connection_list = connection_manager.GetConnectionList();
+	for (auto &con : connection_list) {
+		auto &context_lock = con->context_lock;
+		if (!context_lock.try_lock()) {
+			client_locks.clear();
+			return false;
+		}
+		client_locks.emplace_back(context_lock, move(con), std::adopt_lock);
+	}
+	return true;
+}
+
 void TransactionManager::Checkpoint(ClientContext &context, bool force) {
+	CheckpointInternal(context, force, false, vector<DataTable *>());
+}
+
+void TransactionManager::Vacuum(ClientContext &context, const vector<DataTable *> &tables) {
+	CheckpointInternal(context, false, true, tables);
+}
+
+void TransactionManager::CheckpointInternal(ClientContext &context, bool force, bool vacuum,
+                                            const vector<DataTable *> &vacuum_tables) {
 	auto &storage_manager = StorageManager::GetStorageManager(db);
 	if (storage_manager.InMemory()) {
+		if (!vacuum) {
+			MergeUpdates(context);
+		}
 		return;
 	}
 
@@ -124,7 +168,7 @@ void TransactionManager::Checkpoint(ClientContext &context, bool force) {
 	// this ensures no new queries can be started, and no new connections to the database can be made
 	// to avoid deadlock we release the transaction lock while locking the clients
 	vector<ClientLockWrapper> client_locks;
-	LockClients(client_locks, context);
+	LockClients(client_locks, &context);
 
 	lock = make_unique<lock_guard<mutex>>(transaction_lock);
 	auto current = &Transaction::GetTransaction(context);
@@ -155,8 +199,150 @@ void TransactionManager::Checkpoint(ClientContext &context, bool force) {
 			D_ASSERT(CanCheckpoint(nullptr));
 		}
 	}
+	// no other transaction can observe the tables: the rows of the tables can be moved
+	for (auto &table : vacuum_tables) {
+		table->Vacuum(0, true);
+	}
 	auto &storage = StorageManager::GetStorageManager(context);
-	storage.CreateCheckpoint();
+	storage.CreateCheckpoint(false, vacuum, vacuum);
+	if (vacuum) {
+		// the blocks freed by the first checkpoint can only be reused after its header is written: checkpoint again
+		// to move the metadata written by the first checkpoint toward the start of the file as well
+		storage.CreateCheckpoint(false, true, true);
+	}
+	// the checkpoint has rewritten the columns together with their updates
+	merge_columns.clear();
+	merge_failed = false;
+}
+
+//! The interval after which a background checkpoint is retried when other clients were running queries
+static constexpr const int64_t BACKGROUND_CHECKPOINT_RETRY_MS = 10;
+
+bool TransactionManager::CanCheckpointInBackground() {
+	if (!DBConfig::GetConfig(db).background_checkpoint || background_failed) {
+		return false;
+	}
+	// the user limited the database to a single thread: the checkpoint runs in the committing connection
+	return TaskScheduler::GetScheduler(db).NumberOfThreads() > 1;
+}
+
+void TransactionManager::ScheduleBackgroundTasks(bool checkpoint, bool merge_updates) {
+	lock_guard<mutex> guard(background_lock);
+	if (background_stopped) {
+		return;
+	}
+	background_scheduled = background_scheduled || checkpoint;
+	background_merge_scheduled = background_merge_scheduled || merge_updates;
+	if (!background_thread.joinable()) {
+		// the tasks do not run on the task scheduler: its threads are joined by clients that hold their lock
+		background_thread = thread([this]() { BackgroundLoop(); });
+	}
+	background_signal.notify_one();
+}
+
+void TransactionManager::BackgroundLoop() {
+	unique_lock<mutex> guard(background_lock);
+	while (true) {
+		background_signal.wait(guard,
+		                       [&] { return background_stopped || background_scheduled || background_merge_scheduled; });
+		bool stopped = background_stopped;
+		bool checkpoint = background_scheduled;
+		// merging the updates is of no use once the database is shut down
+		bool merge_updates = background_merge_scheduled && !stopped;
+		if (!checkpoint && !merge_updates) {
+			return;
+		}
+		background_scheduled = false;
+		background_merge_scheduled = false;
+		guard.unlock();
+		bool finished_checkpoint = !checkpoint || TryBackgroundCheckpoint();
+		bool finished_merge = !merge_updates || TryBackgroundMerge();
+		guard.lock();
+		if ((!finished_checkpoint || !finished_merge) && !stopped) {
+			// other clients are running queries: retry after a while
+			background_signal.wait_for(guard, std::chrono::milliseconds(BACKGROUND_CHECKPOINT_RETRY_MS),
+			                           [&] { return background_stopped; });
+			background_scheduled = background_scheduled || !finished_checkpoint;
+			background_merge_scheduled = background_merge_scheduled || !finished_merge;
+		}
+	}
+}
+
+bool TransactionManager::TryBackgroundCheckpoint() {
+	auto &storage_manager = StorageManager::GetStorageManager(db);
+	auto log = storage_manager.GetWriteAheadLog();
+	// check if no other thread is checkpointing right now, and if the WAL was not checkpointed in the meantime
+	auto lock = make_unique<lock_guard<mutex>>(transaction_lock);
+	if (thread_is_checkpointing || !log || log->GetWALSize() == 0) {
+		return true;
+	}
+	// if other transactions are running we give up, the next commit will schedule a new checkpoint
+	if (!CanCheckpoint()) {
+		return true;
+	}
+	CheckpointLock checkpoint_lock(*this);
+	checkpoint_lock.Lock();
+	lock.reset();
+
+	// lock all the clients, but only if none of them is running a query: waiting for a query to finish would block
+	// the clients that are already locked. The clients stay locked until the checkpoint is done, including while the
+	// blocks are written: column checkpoints replace the segment trees in place, which scans cannot run against.
+	vector<ClientLockWrapper> client_locks;
+	if (!TryLockClients(client_locks)) {
+		lock = make_unique<lock_guard<mutex>>(transaction_lock);
+		return false;
+	}
+
+	lock = make_unique<lock_guard<mutex>>(transaction_lock);
+	if (!CanCheckpoint()) {
+		return true;
+	}
+	try {
+		storage_manager.CreateCheckpoint(false, true);
+		merge_columns.clear();
+		merge_failed = false;
+	} catch (...) {
+		// a failed checkpoint leaves the WAL intact: the next automatic checkpoint runs in the committing connection,
+		// which reports the error
+		background_failed = true;
+	}
+	return true;
+}
+
+bool TransactionManager::TryBackgroundMerge() {
+	// lock all the clients first, but only if none of them is running a query: while they are locked, no client can
+	// start a transaction or observe that this thread is merging
+	vector<ClientLockWrapper> client_locks;
+	if (!TryLockClients(client_locks)) {
+		return false;
+	}
+	lock_guard<mutex> lock(transaction_lock);
+	if (thread_is_checkpointing || merge_failed || !active_transactions.empty()) {
+		// a transaction was started in the meantime: its commit schedules the merge again
+		return true;
+	}
+	auto columns = move(merge_columns);
+	merge_columns.clear();
+	try {
+		MergeUpdates(columns, client_locks, nullptr);
+	} catch (...) {
+		// the columns that failed to merge keep their updates: the next CHECKPOINT statement merges them in its own
+		// connection, which reports the error
+		merge_failed = true;
+		merge_columns.insert(columns.begin(), columns.end());
+	}
+	return true;
+}
+
+void TransactionManager::StopBackgroundCheckpoints() {
+	{
+		lock_guard<mutex> guard(background_lock);
+		background_stopped = true;
+	}
+	background_signal.notify_all();
+	if (background_thread.joinable()) {
+		background_thread.join();
+	}
 }
 
 bool TransactionManager::CanCheckpoint(Transaction *current) {
@@ -181,14 +367,20 @@ string TransactionManager::CommitTransaction(ClientContext &context, Transaction
 	CheckpointLock checkpoint_lock(*this);
 	// check if we can checkpoint
 	bool checkpoint = thread_is_checkpointing ? false : CanCheckpoint(transaction);
+	bool background_checkpoint = false;
 	if (checkpoint) {
-		if (transaction->AutomaticCheckpoint(db)) {
+		bool automatic_checkpoint = transaction->AutomaticCheckpoint(db);
+		if (automatic_checkpoint && CanCheckpointInBackground()) {
+			// the checkpoint is scheduled after the commit, the committing connection does not wait for it
+			checkpoint = false;
+			background_checkpoint = true;
+		} else if (automatic_checkpoint) {
 			checkpoint_lock.Lock();
 			// we might be able to checkpoint: lock all clients
 			// to avoid deadlock we release the transaction lock while locking the clients
 			lock.reset();
 
-			LockClients(client_locks, context);
+			LockClients(client_locks, &context);
 
 			lock = make_unique<lock_guard<mutex>>(transaction_lock);
 			checkpoint = CanCheckpoint(transaction);
@@ -200,16 +392,22 @@ string TransactionManager::CommitTransaction(ClientContext &context, Transaction
 			checkpoint = false;
 		}
 	}
+	// if no other transaction can observe the table while we commit, complete row groups can be written to the
+	// database file directly: the commit rewrites the segments of the appended row groups
+	auto &config = DBConfig::GetConfig(db);
+	bool write_row_groups =
+	    !checkpoint && !thread_is_checkpointing && config.direct_row_group_writes && CanCheckpoint(transaction);
 	// obtain a commit id for the transaction
 	transaction_t commit_id = current_start_timestamp++;
 	// commit the UndoBuffer of the transaction
-	string error = transaction->Commit(db, commit_id, checkpoint);
+	string error = transaction->Commit(db, commit_id, checkpoint, write_row_groups);
 	if (!error.empty()) {
 		// commit unsuccessful: rollback the transaction instead
 		checkpoint = false;
 		transaction->commit_id = 0;
 		transaction->Rollback();
 	}
+	idx_t wal_sync_position = error.empty() ? transaction->wal_sync_position : 0;
 	if (!checkpoint) {
 		// we won't checkpoint after all: unlock the clients again
 		checkpoint_lock.Unlock();
@@ -225,10 +423,85 @@ string TransactionManager::CommitTransaction(ClientContext &context, Transaction
 		// checkpoint the database to disk
 		auto &storage_manager = StorageManager::GetStorageManager(db);
 		storage_manager.CreateCheckpoint(false, true);
+		background_failed = false;
+		// the checkpoint has rewritten the columns together with their updates
+		merge_columns.clear();
+		merge_failed = false;
+	}
+	// merging the updates locks all clients: it runs in the background, once none of them is running a query
+	bool merge_updates = !merge_columns.empty() && active_transactions.empty() && !merge_failed;
+	background_checkpoint = background_checkpoint && error.empty();
+	if (background_checkpoint || merge_updates) {
+		ScheduleBackgroundTasks(background_checkpoint, merge_updates);
+	}
+	if (wal_sync_position > 0) {
+		// group commit: sync the WAL after releasing the transaction lock, so concurrent commits can share the sync
+		// the commit is only acknowledged after its changes are durable
+		D_ASSERT(!checkpoint);
+		lock.reset();
+		auto log = StorageManager::GetStorageManager(db).GetWriteAheadLog();
+		log->GroupSync(wal_sync_position, config.wal_group_commit_window);
 	}
 	return error;
 }
 
+void TransactionManager::MergeUpdates(ClientContext &context) {
+	// as for a checkpoint, all other clients are locked while the transaction lock is not held
+	auto lock = make_unique<lock_guard<mutex>>(transaction_lock);
+	if (thread_is_checkpointing) {
+		throw TransactionException("Cannot CHECKPOINT: another thread is checkpointing right now");
+	}
+	CheckpointLock checkpoint_lock(*this);
+	checkpoint_lock.Lock();
+	lock.reset();
+	vector<ClientLockWrapper> client_locks;
+	LockClients(client_locks, &context);
+
+	lock = make_unique<lock_guard<mutex>>(transaction_lock);
+	auto current = &Transaction::GetTransaction(context);
+	for (auto &transaction : active_transactions) {
+		if (transaction.get() != current) {
+			// another transaction might still scan the columns: the updates are merged after a later commit
+			return;
+		}
+	}
+	auto columns = move(merge_columns);
+	merge_columns.clear();
+	try {
+		MergeUpdates(columns, client_locks, &context);
+	} catch (...) {
+		merge_columns.insert(columns.begin(), columns.end());
+		throw;
+	}
+	merge_failed = false;
+}
+
+void TransactionManager::MergeUpdates(const unordered_set<ColumnData *> &columns,
+                                      vector<ClientLockWrapper> &client_locks, ClientContext *context) {
+	if (columns.empty()) {
+		return;
+	}
+	// the columns might have been dropped since their updates were cleaned up: only the tables in the catalog are merged
+	auto threshold = DBConfig::GetConfig(db).update_merge_threshold;
+	auto merge_schema = [&](SchemaCatalogEntry &schema) {
+		schema.Scan(CatalogType::TABLE_ENTRY, [&](CatalogEntry *entry) {
+			if (entry->type == CatalogType::TABLE_ENTRY) {
+				((TableCatalogEntry *)entry)->storage->MergeUpdates(columns, threshold);
+			}
+		});
+	};
+	auto &catalog = Catalog::GetCatalog(db);
+	catalog.schemas->Scan([&](CatalogEntry *entry) { merge_schema((SchemaCatalogEntry &)*entry); });
+	if (context) {
+		merge_schema(*ClientData::Get(*context).temporary_objects);
+	}
+	for (auto &client_lock : client_locks) {
+		if (client_lock.connection) {
+			merge_schema(*ClientData::Get(*client_lock.connection).temporary_objects);
+		}
+	}
+}
+
 void TransactionManager::RollbackTransaction(Transaction *transaction) {
 	// obtain the transaction lock during this function
 	lock_guard<mutex> lock(transaction_lock);
@@ -294,7 +567,8 @@ void TransactionManager::RemoveTransaction(Transaction *transaction) noexcept {
 			// we can only safely do the actual memory cleanup when all the
 			// currently active queries have finished running! (actually,
 			// when all the currently active scans have finished running...)
-			recently_committed_transactions[i]->Cleanup();
+			// the columns with cleaned up updates are recorded: their updates are merged after the lock is released
+			recently_committed_transactions[i]->Cleanup(merge_columns);
 			// store the current highest active query
 			recently_committed_transactions[i]->highest_active_query = current_query_number;
 			// move it to the list of transactions awaiting GC
@@ -149,7 +149,7 @@ idx_t UndoBuffer::EstimatedSize() {
 	return estimated_size;
 }
 
-void UndoBuffer::Cleanup() {
+void UndoBuffer::Cleanup(unordered_set<ColumnData *> &merge_columns) {
 	// garbage collect everything in the Undo Chunk
 	// this should only happen if
 	//  (1) the transaction this UndoBuffer belongs to has successfully
@@ -158,7 +158,7 @@ void UndoBuffer::Cleanup() {
 	//      the chunks)
 	//  (2) there is no active transaction with start_id < commit_id of this
 	//  transaction
-	CleanupState state;
+	CleanupState state(merge_columns);
 	UndoBuffer::IteratorState iterator_state;
 	IterateEntries(iterator_state, [&](UndoFlags type, data_ptr_t data) { state.CleanupEntry(type, data); });
 }
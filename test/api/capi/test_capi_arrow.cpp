@@ -91,6 +91,72 @@ TEST_CASE("Test arrow in C API", "[capi]") {
 		REQUIRE_NO_FAIL(tester.Query("drop table test"));
 	}
 
+	// test results that are collected in parallel
+	{
+		REQUIRE_NO_FAIL(tester.Query("PRAGMA threads=4"));
+		REQUIRE_NO_FAIL(tester.Query("CREATE TABLE big AS SELECT i::BIGINT AS i, CASE WHEN i % 3 = 0 THEN NULL ELSE i "
+		                             "END AS j FROM range(1000000) t(i)"));
+
+		for (auto preserve_order : {true, false}) {
+			REQUIRE_NO_FAIL(tester.Query(preserve_order ? "SET preserve_insertion_order=true"
+			                                            : "SET preserve_insertion_order=false"));
+			REQUIRE(duckdb_query_arrow(tester.connection, "SELECT i, j FROM big WHERE i % 7 <> 0", &arrow_result) ==
+			        DuckDBSuccess);
+			REQUIRE(duckdb_arrow_row_count(arrow_result) == 857142);
+
+			int64_t expected_row = 0;
+			int64_t total_count = 0;
+			int64_t total_sum = 0;
+			int64_t null_count = 0;
+			int64_t batch_count = 0;
+			bool in_order = true;
+			bool correct = true;
+			while (true) {
+				ArrowArray *arrow_array = new ArrowArray();
+				REQUIRE(duckdb_query_arrow_array(arrow_result, (duckdb_arrow_array *)&arrow_array) == DuckDBSuccess);
+				if (arrow_array->length == 0) {
+					delete arrow_array;
+					break;
+				}
+				REQUIRE(arrow_array->n_children == 2);
+				auto i_data = (int64_t *)arrow_array->children[0]->buffers[1];
+				auto j_validity = (uint8_t *)arrow_array->children[1]->buffers[0];
+				auto j_data = (int64_t *)arrow_array->children[1]->buffers[1];
+				for (int64_t row = 0; row < arrow_array->length; row++) {
+					while (expected_row % 7 == 0) {
+						expected_row++;
+					}
+					if (i_data[row] != expected_row++) {
+						in_order = false;
+					}
+					bool j_valid = j_validity && (j_validity[row / 8] & (1 << (row % 8)));
+					if (j_valid != (i_data[row] % 3 != 0) || (j_valid && j_data[row] != i_data[row])) {
+						correct = false;
+					}
+					null_count += !j_valid;
+					total_sum += i_data[row];
+				}
+				total_count += arrow_array->length;
+				batch_count++;
+				arrow_array->release(arrow_array);
+				delete arrow_array;
+			}
+			REQUIRE(total_count == 857142);
+			REQUIRE(total_sum == 428570571429);
+			REQUIRE(null_count == 285714);
+			// the result is smaller than the batch size: the pieces of all scan batches fit in a single record batch
+			REQUIRE(batch_count == 1);
+			REQUIRE(correct);
+			if (preserve_order) {
+				REQUIRE(in_order);
+			}
+			REQUIRE(duckdb_arrow_row_count(arrow_result) == 0);
+			duckdb_destroy_arrow(&arrow_result);
+		}
+		REQUIRE_NO_FAIL(tester.Query("SET preserve_insertion_order=true"));
+		REQUIRE_NO_FAIL(tester.Query("DROP TABLE big"));
+	}
+
 	// test prepare query arrow
 	{
 		REQUIRE(duckdb_prepare(tester.connection, "SELECT CAST($1 AS BIGINT)", &stmt) == DuckDBSuccess);
@@ -114,4 +180,31 @@ TEST_CASE("Test arrow in C API", "[capi]") {
 		duckdb_destroy_arrow(&arrow_result);
 		duckdb_destroy_prepare(&stmt);
 	}
+
+	// test a prepared point lookup: the record batches are converted when the query is not executed inline
+	{
+		REQUIRE_NO_FAIL(tester.Query("CREATE TABLE kv(k INTEGER PRIMARY KEY, v VARCHAR)"));
+		REQUIRE_NO_FAIL(tester.Query("INSERT INTO kv SELECT i, 'v' || i FROM range(10000) t(i)"));
+		REQUIRE(duckdb_prepare(tester.connection, "SELECT * FROM kv WHERE k = $1", &stmt) == DuckDBSuccess);
+		REQUIRE(stmt != nullptr);
+		for (int64_t key : {42, 20000}) {
+			REQUIRE(duckdb_bind_int64(stmt, 1, key) == DuckDBSuccess);
+			REQUIRE(duckdb_execute_prepared_arrow(stmt, &arrow_result) == DuckDBSuccess);
+			idx_t expected_count = key < 10000 ? 1 : 0;
+			REQUIRE(duckdb_arrow_row_count(arrow_result) == expected_count);
+
+			ArrowArray *arrow_array = new ArrowArray();
+			REQUIRE(duckdb_query_arrow_array(arrow_result, (duckdb_arrow_array *)&arrow_array) == DuckDBSuccess);
+			if (expected_count > 0) {
+				REQUIRE(arrow_array->length == 1);
+				REQUIRE(arrow_array->n_children == 2);
+				REQUIRE(((int32_t *)arrow_array->children[0]->buffers[1])[0] == 42);
+				arrow_array->release(arrow_array);
+			}
+			delete arrow_array;
+			duckdb_destroy_arrow(&arrow_result);
+		}
+		duckdb_destroy_prepare(&stmt);
+		REQUIRE_NO_FAIL(tester.Query("DROP TABLE kv"));
+	}
 }
@@ -0,0 +1,163 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "duckdb/common/arrow_wrapper.hpp"
+#include "duckdb/function/table/arrow.hpp"
+#include "duckdb/planner/table_filter.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+//! An arrow stream that hands out the chunks of a number of query results as record batches, one after the other
+struct ArrowScanTestStream {
+	vector<unique_ptr<QueryResult>> results;
+	idx_t result_idx = 0;
+
+	static int GetSchema(ArrowArrayStream *stream, ArrowSchema *out) {
+		auto &state = *((ArrowScanTestStream *)stream->private_data);
+		auto &result = *state.results[0];
+		string timezone_config = "UTC";
+		QueryResult::ToArrowSchema(out, result.types, result.names, timezone_config);
+		return 0;
+	}
+
+	static int GetNext(ArrowArrayStream *stream, ArrowArray *out) {
+		auto &state = *((ArrowScanTestStream *)stream->private_data);
+		while (state.result_idx < state.results.size()) {
+			auto chunk = state.results[state.result_idx]->Fetch();
+			if (chunk && chunk->size() > 0) {
+				chunk->ToArrowArray(out);
+				return 0;
+			}
+			state.result_idx++;
+		}
+		out->release = nullptr;
+		return 0;
+	}
+
+	static void Release(ArrowArrayStream *stream) {
+		stream->release = nullptr;
+		delete (ArrowScanTestStream *)stream->private_data;
+	}
+
+	static const char *GetLastError(ArrowArrayStream *stream) {
+		return nullptr;
+	}
+};
+
+//! Produces arrow streams from queries that run on a separate connection, applying the pushed down projections and
+//! filters to the queries
+struct ArrowScanTestFactory {
+	ArrowScanTestFactory(DuckDB &db, vector<string> queries) : con(db), queries(move(queries)) {
+	}
+
+	Connection con;
+	vector<string> queries;
+	//! The arrow schema refers to the column names of this result
+	unique_ptr<QueryResult> schema_result;
+
+	static unique_ptr<ArrowArrayStreamWrapper>
+	Produce(uintptr_t factory_ptr, pair<unordered_map<idx_t, string>, vector<string>> &project_columns,
+	        TableFilterSet *filters) {
+		auto &factory = *((ArrowScanTestFactory *)factory_ptr);
+		string select_list = "*";
+		if (!project_columns.second.empty()) {
+			select_list = StringUtil::Join(project_columns.second, ", ");
+		}
+		vector<string> conditions;
+		if (filters) {
+			for (auto &entry : filters->filters) {
+				conditions.push_back(entry.second->ToString(project_columns.first[entry.first]));
+			}
+		}
+		auto state = new ArrowScanTestStream();
+		for (auto &query : factory.queries) {
+			auto projected_query = "SELECT " + select_list + " FROM (" + query + ") t";
+			if (!conditions.empty()) {
+				projected_query += " WHERE " + StringUtil::Join(conditions, " AND ");
+			}
+			state->results.push_back(factory.con.Query(projected_query));
+		}
+		auto result = make_unique<ArrowArrayStreamWrapper>();
+		result->arrow_array_stream.private_data = state;
+		result->arrow_array_stream.get_schema = ArrowScanTestStream::GetSchema;
+		result->arrow_array_stream.get_next = ArrowScanTestStream::GetNext;
+		result->arrow_array_stream.release = ArrowScanTestStream::Release;
+		result->arrow_array_stream.get_last_error = ArrowScanTestStream::GetLastError;
+		return result;
+	}
+
+	static void GetSchema(uintptr_t factory_ptr, ArrowSchemaWrapper &schema) {
+		auto &factory = *((ArrowScanTestFactory *)factory_ptr);
+		factory.schema_result = factory.con.Query(factory.queries[0] + " LIMIT 0");
+		string timezone_config = "UTC";
+		QueryResult::ToArrowSchema(&schema.arrow_schema, factory.schema_result->types, factory.schema_result->names,
+		                           timezone_config);
+	}
+};
+
+static void CreateArrowView(Connection &con, ArrowScanTestFactory &factory, const string &name) {
+	vector<Value> params;
+	params.push_back(Value::POINTER((uintptr_t)&factory));
+	params.push_back(Value::POINTER((uintptr_t)&ArrowScanTestFactory::Produce));
+	params.push_back(Value::POINTER((uintptr_t)&ArrowScanTestFactory::GetSchema));
+	params.push_back(Value::UBIGINT(1000000));
+	con.TableFunction("arrow_scan", params)->CreateView(name);
+}
+
+TEST_CASE("Test scanning arrow streams with dictionaries", "[api][arrow]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TYPE color AS ENUM ('red', 'green', 'a color with a long name')"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TYPE size AS ENUM ('small', 'large', 'a size with a long name')"));
+
+	// every record batch comes with its own dictionary
+	ArrowScanTestFactory factory(
+	    db, {"SELECT i, (CASE WHEN i % 3 = 0 THEN 'red' WHEN i % 3 = 1 THEN 'green' ELSE 'a color with a long name' "
+	         "END)::color AS v FROM range(3000) t(i)",
+	         "SELECT i, (CASE WHEN i % 3 = 0 THEN 'small' WHEN i % 3 = 1 THEN NULL ELSE 'a size with a long name' "
+	         "END)::size AS v FROM range(3000, 6000) t(i)"});
+	CreateArrowView(con, factory, "dictionaries");
+
+	result = con.Query("SELECT v, COUNT(*), MIN(i), MAX(i) FROM dictionaries GROUP BY v ORDER BY v NULLS LAST");
+	REQUIRE(CHECK_COLUMN(result, 0,
+	                     {"a color with a long name", "a size with a long name", "green", "red", "small", Value()}));
+	REQUIRE(CHECK_COLUMN(result, 1, {1000, 1000, 1000, 1000, 1000, 1000}));
+	REQUIRE(CHECK_COLUMN(result, 2, {2, 3002, 1, 0, 3000, 3001}));
+	REQUIRE(CHECK_COLUMN(result, 3, {2999, 5999, 2998, 2997, 5997, 5998}));
+
+	// the dictionary values stay valid after the record batch has been scanned
+	result = con.Query("SELECT v FROM dictionaries ORDER BY i DESC LIMIT 3");
+	REQUIRE(CHECK_COLUMN(result, 0, {"a size with a long name", Value(), "small"}));
+
+	// projections and filters are pushed into the stream
+	result = con.Query("SELECT COUNT(v), COUNT(*) FROM dictionaries WHERE i >= 2500");
+	REQUIRE(CHECK_COLUMN(result, 0, {2500}));
+	REQUIRE(CHECK_COLUMN(result, 1, {3500}));
+}
+
+TEST_CASE("Test scanning arrow streams with 32-bit dictionary indices", "[api][arrow]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+
+	// an enum with more than 65536 values uses 32-bit indices
+	string values;
+	for (idx_t i = 0; i < 70000; i++) {
+		values += (i == 0 ? "'v" : ", 'v") + to_string(i) + "'";
+	}
+	REQUIRE_NO_FAIL(con.Query("CREATE TYPE big_enum AS ENUM (" + values + ")"));
+
+	ArrowScanTestFactory factory(db, {"SELECT i, ('v' || (i * 3 % 70000))::big_enum AS v FROM range(20000) t(i)"});
+	CreateArrowView(con, factory, "big_dictionary");
+
+	result = con.Query("SELECT COUNT(*), COUNT(DISTINCT v), SUM(REPLACE(v, 'v', '')::BIGINT) FROM big_dictionary");
+	REQUIRE(CHECK_COLUMN(result, 0, {20000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {20000}));
+	REQUIRE(CHECK_COLUMN(result, 2, {599970000}));
+
+	result = con.Query("SELECT v FROM big_dictionary WHERE i = 12345");
+	REQUIRE(CHECK_COLUMN(result, 0, {"v37035"}));
+}
@@ -0,0 +1,159 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "duckdb/main/plan_cache.hpp"
+
+#include <thread>
+
+using namespace duckdb;
+using namespace std;
+
+TEST_CASE("Test the plan cache", "[api]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+	Connection con2(db);
+	auto &plan_cache = db.instance->GetPlanCache();
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers AS SELECT * FROM range(10) t(i)"));
+
+	// the plan cache is disabled by default
+	REQUIRE_NO_FAIL(con.Query("SELECT SUM(i) FROM integers"));
+	REQUIRE(plan_cache.PlanCount() == 0);
+	REQUIRE_FAIL(con.Query("SET plan_cache_size=-1"));
+	REQUIRE_NO_FAIL(con.Query("SET plan_cache_size=16"));
+
+	// the plan is kept once the query finishes
+	result = con.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {45}));
+	REQUIRE(plan_cache.PlanCount() == 1);
+
+	// other connections reuse the plan for the same query text, regardless of whitespace
+	result = con2.Query("SELECT  SUM(i)\n\tFROM integers;");
+	REQUIRE(CHECK_COLUMN(result, 0, {45}));
+	REQUIRE(plan_cache.PlanCount() == 1);
+	result = con2.Query("SELECT SUM(i) FROM integers WHERE i > 'a b'");
+	REQUIRE_FAIL(result);
+	result = con2.Query("SELECT SUM(i) FROM integers WHERE i > 4");
+	REQUIRE(CHECK_COLUMN(result, 0, {35}));
+	REQUIRE(plan_cache.PlanCount() == 2);
+
+	// a plan is only used by one query at a time
+	auto pending = con.PendingQuery("SELECT SUM(i) FROM integers");
+	REQUIRE(plan_cache.PlanCount() == 1);
+	result = con2.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {45}));
+	result = pending->Execute();
+	REQUIRE(CHECK_COLUMN(result, 0, {45}));
+	REQUIRE(plan_cache.PlanCount() == 3);
+
+	// prepared statements use the cached plans as well
+	auto prepared = con2.Prepare("SELECT SUM(i) FROM integers WHERE i > 4");
+	REQUIRE(plan_cache.PlanCount() == 2);
+	result = prepared->Execute();
+	REQUIRE(CHECK_COLUMN(result, 0, {35}));
+	prepared.reset();
+	REQUIRE(plan_cache.PlanCount() == 3);
+	result = con.Query("SELECT SUM(i) FROM integers WHERE i > $1", 7);
+	REQUIRE(CHECK_COLUMN(result, 0, {17}));
+	result = con2.Query("SELECT SUM(i) FROM integers WHERE i > $1", 8);
+	REQUIRE(CHECK_COLUMN(result, 0, {9}));
+	REQUIRE(plan_cache.PlanCount() == 4);
+
+	// plans that scan anything but tables, or that depend on the connection, are not cached
+	result = con.Query("SELECT SUM(range) FROM range(10)");
+	REQUIRE(CHECK_COLUMN(result, 0, {45}));
+	result = con.Query("SELECT current_query() FROM integers LIMIT 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {"SELECT current_query() FROM integers LIMIT 1"}));
+	REQUIRE(plan_cache.PlanCount() == 4);
+
+	// catalog changes invalidate the cached plans
+	result = con.Query("SELECT * FROM integers ORDER BY i LIMIT 1");
+	REQUIRE(result->ColumnCount() == 1);
+	REQUIRE_NO_FAIL(con.Query("ALTER TABLE integers ADD COLUMN j INTEGER DEFAULT 1"));
+	result = con2.Query("SELECT * FROM integers ORDER BY i LIMIT 1");
+	REQUIRE(CHECK_COLUMN(result, 1, {1}));
+	REQUIRE(plan_cache.PlanCount() == 1);
+
+	// transactions that see an older version of the catalog do not use the cache
+	REQUIRE_NO_FAIL(con2.Query("BEGIN TRANSACTION"));
+	REQUIRE_NO_FAIL(con.Query("ALTER TABLE integers DROP COLUMN j"));
+	result = con.Query("SELECT * FROM integers ORDER BY i LIMIT 1");
+	REQUIRE(result->ColumnCount() == 1);
+	result = con2.Query("SELECT * FROM integers ORDER BY i LIMIT 1");
+	REQUIRE(CHECK_COLUMN(result, 1, {1}));
+	REQUIRE_NO_FAIL(con2.Query("COMMIT"));
+	result = con2.Query("SELECT * FROM integers ORDER BY i LIMIT 1");
+	REQUIRE(result->ColumnCount() == 1);
+
+	// queries that might refer to temporary objects are not cached
+	REQUIRE_NO_FAIL(con2.Query("CREATE TEMPORARY TABLE integers(i INTEGER)"));
+	result = con2.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value()}));
+	result = con.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {45}));
+	result = con2.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value()}));
+	REQUIRE_NO_FAIL(con2.Query("DROP TABLE temp.integers"));
+
+	// the settings of the connection are part of the cache key
+	REQUIRE_NO_FAIL(con.Query("CREATE SCHEMA s"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE s.integers AS SELECT 42 AS i"));
+	result = con.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {45}));
+	REQUIRE_NO_FAIL(con2.Query("SET schema='s'"));
+	result = con2.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {42}));
+	REQUIRE(plan_cache.PlanCount() == 2);
+
+	// dollar-quoted strings and escaped quotes are not normalized: their queries only share plans with the same text
+	result = con.Query("SELECT $$a  b$$ FROM integers LIMIT 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {"a  b"}));
+	result = con.Query("SELECT $$a b$$ FROM integers LIMIT 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {"a b"}));
+	result = con.Query("SELECT E'x\\'  y' FROM integers LIMIT 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {"x'  y"}));
+	result = con.Query("SELECT E'x\\' y' FROM integers LIMIT 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {"x' y"}));
+
+	// the least recently used plans are evicted once the cache is full
+	REQUIRE_NO_FAIL(con.Query("SET plan_cache_size=1"));
+	REQUIRE(plan_cache.PlanCount() == 1);
+	result = con.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {45}));
+	REQUIRE(plan_cache.PlanCount() == 1);
+	REQUIRE_NO_FAIL(con.Query("SET plan_cache_size=0"));
+	REQUIRE(plan_cache.PlanCount() == 0);
+	REQUIRE_NO_FAIL(con.Query("SELECT SUM(i) FROM integers"));
+	REQUIRE(plan_cache.PlanCount() == 0);
+}
+
+static void CachedPlanQueries(DuckDB *db, bool *correct) {
+	Connection con(*db);
+	*correct = true;
+	for (idx_t i = 0; i < 100; i++) {
+		auto result = con.Query("SELECT SUM(i), COUNT(*) FROM integers WHERE i % 2 = 0");
+		if (!CHECK_COLUMN(result, 0, {249500}) || !CHECK_COLUMN(result, 1, {500})) {
+			*correct = false;
+		}
+	}
+}
+
+TEST_CASE("Test concurrent queries using the plan cache", "[api]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("SET plan_cache_size=16"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers AS SELECT * FROM range(1000) t(i)"));
+
+	bool correct[8];
+	thread threads[8];
+	for (idx_t i = 0; i < 8; i++) {
+		threads[i] = thread(CachedPlanQueries, &db, correct + i);
+	}
+	for (idx_t i = 0; i < 8; i++) {
+		threads[i].join();
+	}
+	for (idx_t i = 0; i < 8; i++) {
+		REQUIRE(correct[i]);
+	}
+	REQUIRE(db.instance->GetPlanCache().PlanCount() <= 8);
+}
@@ -112,3 +112,95 @@ TEST_CASE("Concurrent append", "[interquery][.]") {
 	REQUIRE(CHECK_COLUMN(result, 1,
 	                     {Value::BIGINT(3 * CONCURRENT_APPEND_THREAD_COUNT * CONCURRENT_APPEND_INSERT_ELEMENTS)}));
 }
+
+static void commit_group_elements(DuckDB *db, bool *correct, int threadnr) {
+	correct[threadnr] = true;
+	Connection con(*db);
+	for (size_t i = 0; i < CONCURRENT_APPEND_INSERT_ELEMENTS / 10; i++) {
+		// every insert is a separate commit that can share a WAL sync with the other threads
+		if (!con.Query("INSERT INTO integers VALUES (" + to_string(threadnr) + ")")->success) {
+			correct[threadnr] = false;
+		}
+	}
+}
+
+TEST_CASE("Concurrent commits with WAL group commit", "[interquery]") {
+	auto storage_database = TestCreatePath("group_commit_test");
+	DeleteDatabase(storage_database);
+	auto config = GetTestConfig();
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("PRAGMA disable_checkpoint_on_shutdown"));
+		REQUIRE_NO_FAIL(con.Query("PRAGMA wal_autocheckpoint='1TB'"));
+		REQUIRE_NO_FAIL(con.Query("SET wal_group_commit_window=100"));
+		REQUIRE_FAIL(con.Query("SET wal_group_commit_window=-1"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER);"));
+
+		bool correct[CONCURRENT_APPEND_THREAD_COUNT];
+		thread threads[CONCURRENT_APPEND_THREAD_COUNT];
+		for (size_t i = 0; i < CONCURRENT_APPEND_THREAD_COUNT; i++) {
+			threads[i] = thread(commit_group_elements, &db, correct, i);
+		}
+		for (size_t i = 0; i < CONCURRENT_APPEND_THREAD_COUNT; i++) {
+			threads[i].join();
+			REQUIRE(correct[i]);
+		}
+	}
+	// all commits were acknowledged: they have to be replayed from the WAL
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		auto result = con.Query("SELECT COUNT(*), SUM(i) FROM integers");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(CONCURRENT_APPEND_INSERT_ELEMENTS)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(CONCURRENT_APPEND_INSERT_ELEMENTS / 10 * 45)}));
+	}
+	DeleteDatabase(storage_database);
+}
+
+static void insert_row_groups(DuckDB *db, bool *correct, int threadnr) {
+	correct[threadnr] = true;
+	Connection con(*db);
+	con.Query("BEGIN TRANSACTION;");
+	// every insert is big enough to flush complete row groups to the table before the commit
+	for (size_t i = 0; i < 3; i++) {
+		if (!con.Query("INSERT INTO integers SELECT " + to_string(threadnr) + " FROM range(100000)")->success) {
+			correct[threadnr] = false;
+		}
+	}
+	auto result = con.Query("SELECT COUNT(*), SUM(i) FROM integers");
+	if (!CHECK_COLUMN(result, 0, {Value::BIGINT(300000)}) ||
+	    !CHECK_COLUMN(result, 1, {Value::HUGEINT(300000 * threadnr)})) {
+		correct[threadnr] = false;
+	}
+	// odd threads roll back their appends
+	if (!con.Query(threadnr % 2 == 0 ? "COMMIT" : "ROLLBACK")->success) {
+		correct[threadnr] = false;
+	}
+}
+
+TEST_CASE("Concurrent appends of complete row groups", "[interquery]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER);"));
+
+	bool correct[CONCURRENT_APPEND_THREAD_COUNT];
+	thread threads[CONCURRENT_APPEND_THREAD_COUNT];
+	for (size_t i = 0; i < CONCURRENT_APPEND_THREAD_COUNT; i++) {
+		threads[i] = thread(insert_row_groups, &db, correct, i);
+	}
+	for (size_t i = 0; i < CONCURRENT_APPEND_THREAD_COUNT; i++) {
+		threads[i].join();
+	}
+	for (size_t i = 0; i < CONCURRENT_APPEND_THREAD_COUNT; i++) {
+		REQUIRE(correct[i]);
+	}
+
+	// the even threads committed: 0 + 2 + 4 + 6 + 8
+	result = con.Query("SELECT COUNT(*), SUM(i), COUNT(DISTINCT i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(CONCURRENT_APPEND_THREAD_COUNT / 2 * 300000)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(20 * 300000)}));
+	REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(CONCURRENT_APPEND_THREAD_COUNT / 2)}));
+}
@@ -74,3 +74,40 @@ TEST_CASE("Test interleaving of insertions/updates/deletes on multiple tables",
 	}
 	DeleteDatabase(storage_database);
 }
+
+TEST_CASE("Test replaying a WAL that ends in a torn transaction", "[storage]") {
+	auto config = GetTestConfig();
+	unique_ptr<QueryResult> result;
+	auto storage_database = TestCreatePath("storage_test");
+	auto wal_path = storage_database + ".wal";
+
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	{
+		// create a database with insert-only transactions that are only stored in the WAL
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("PRAGMA disable_checkpoint_on_shutdown"));
+		REQUIRE_NO_FAIL(con.Query("PRAGMA wal_autocheckpoint='1TB'"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE test (a INTEGER)"));
+		for (idx_t i = 0; i < 10; i++) {
+			REQUIRE_NO_FAIL(con.Query("INSERT INTO test VALUES (" + to_string(i) + ")"));
+		}
+		REQUIRE_NO_FAIL(con.Query("INSERT INTO test SELECT * FROM range(1000, 2000)"));
+	}
+	{
+		// cut off the end of the last transaction
+		auto fs = FileSystem::CreateLocal();
+		auto handle = fs->OpenFile(wal_path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_WRITE);
+		fs->Truncate(*handle, fs->GetFileSize(*handle) - 16);
+	}
+	{
+		// the transactions preceding the torn transaction are replayed
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		result = con.Query("SELECT COUNT(*), SUM(a) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {10}));
+		REQUIRE(CHECK_COLUMN(result, 1, {45}));
+	}
+	DeleteDatabase(storage_database);
+}
@@ -7,6 +7,8 @@
 #include "duckdb/common/types/interval.hpp"
 #include "duckdb_python/pyresult.hpp"
 #include "duckdb/common/types/uuid.hpp"
+#include "duckdb/parallel/task_counter.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 namespace duckdb {
 
@@ -596,7 +598,32 @@ void ArrayWrapper::Resize(idx_t new_capacity) {
 	mask->Resize(new_capacity);
 }
 
+bool ArrayWrapper::RequiresGIL() const {
+	switch (data->type.id()) {
+	case LogicalTypeId::TIME:
+	case LogicalTypeId::TIME_TZ:
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::JSON:
+	case LogicalTypeId::BLOB:
+	case LogicalTypeId::LIST:
+	case LogicalTypeId::MAP:
+	case LogicalTypeId::STRUCT:
+	case LogicalTypeId::UUID:
+		return true;
+	default:
+		return false;
+	}
+}
+
 void ArrayWrapper::Append(idx_t current_offset, Vector &input, idx_t count) {
+	if (Convert(current_offset, input, count)) {
+		requires_mask = true;
+	}
+	data->count += count;
+	mask->count += count;
+}
+
+bool ArrayWrapper::Convert(idx_t current_offset, Vector &input, idx_t count) {
 	auto dataptr = data->data;
 	auto maskptr = (bool *)mask->data;
 	D_ASSERT(dataptr);
@@ -716,11 +743,7 @@ void ArrayWrapper::Append(idx_t current_offset, Vector &input, idx_t count) {
 	default:
 		throw std::runtime_error("unsupported type " + input.GetType().ToString());
 	}
-	if (may_have_null) {
-		requires_mask = true;
-	}
-	data->count += count;
-	mask->count += count;
+	return may_have_null;
 }
 
 py::object ArrayWrapper::ToArray(idx_t count) const {
@@ -778,4 +801,117 @@ void NumpyResultConversion::Append(DataChunk &chunk) {
 #endif
 }
 
+//! A range of chunks of a single column that does not create Python objects, which is converted by one task
+struct NumpyConversionRange {
+	idx_t col_idx;
+	idx_t chunk_start;
+	idx_t chunk_end;
+	//! Whether or not the converted chunks may contain NULL values
+	bool may_have_null;
+	std::exception_ptr error;
+};
+
+class NumpyConversionTask : public Task {
+public:
+	NumpyConversionTask(TaskCounter &counter, ArrayWrapper &column, ChunkCollection &collection,
+	                    const vector<idx_t> &chunk_offsets, NumpyConversionRange &range)
+	    : counter(counter), column(column), collection(collection), chunk_offsets(chunk_offsets), range(range) {
+	}
+
+	TaskCounter &counter;
+	ArrayWrapper &column;
+	ChunkCollection &collection;
+	const vector<idx_t> &chunk_offsets;
+	NumpyConversionRange &range;
+
+public:
+	TaskExecutionResult Execute(TaskExecutionMode mode) override {
+		try {
+			auto &chunks = collection.Chunks();
+			for (idx_t chunk_idx = range.chunk_start; chunk_idx < range.chunk_end; chunk_idx++) {
+				auto &chunk = *chunks[chunk_idx];
+				if (column.Convert(chunk_offsets[chunk_idx], chunk.data[range.col_idx], chunk.size())) {
+					range.may_have_null = true;
+				}
+			}
+		} catch (...) {
+			range.error = std::current_exception();
+		}
+		counter.FinishTask();
+		return TaskExecutionResult::TASK_FINISHED;
+	}
+};
+
+void NumpyResultConversion::Append(ChunkCollection &collection, TaskScheduler &scheduler) {
+	auto &chunks = collection.Chunks();
+	if (count + collection.Count() > capacity) {
+		Resize(count + collection.Count());
+	}
+	// the offset of every chunk in the arrays
+	vector<idx_t> chunk_offsets;
+	chunk_offsets.reserve(chunks.size());
+	idx_t offset = count;
+	for (auto &chunk : chunks) {
+		chunk_offsets.push_back(offset);
+		offset += chunk->size();
+	}
+	// columns that do not create Python objects are split in tasks, that are converted by the threads of the task
+	// scheduler without holding the GIL
+	vector<NumpyConversionRange> ranges;
+	for (idx_t col_idx = 0; col_idx < owned_data.size(); col_idx++) {
+		if (owned_data[col_idx].RequiresGIL()) {
+			continue;
+		}
+		for (idx_t chunk_idx = 0; chunk_idx < chunks.size(); chunk_idx += NUMPY_CONVERSION_TASK_CHUNKS) {
+			auto chunk_end = MinValue<idx_t>(chunk_idx + NUMPY_CONVERSION_TASK_CHUNKS, chunks.size());
+			ranges.push_back(NumpyConversionRange {col_idx, chunk_idx, chunk_end, false, nullptr});
+		}
+	}
+	TaskCounter counter(scheduler);
+	for (auto &range : ranges) {
+		counter.AddTask(
+		    make_unique<NumpyConversionTask>(counter, owned_data[range.col_idx], collection, chunk_offsets, range));
+	}
+	// the calling thread converts the columns that create Python objects in the meantime
+	std::exception_ptr error;
+	try {
+		for (idx_t col_idx = 0; col_idx < owned_data.size(); col_idx++) {
+			auto &column = owned_data[col_idx];
+			if (!column.RequiresGIL()) {
+				continue;
+			}
+			for (idx_t chunk_idx = 0; chunk_idx < chunks.size(); chunk_idx++) {
+				auto &chunk = *chunks[chunk_idx];
+				if (column.Convert(chunk_offsets[chunk_idx], chunk.data[col_idx], chunk.size())) {
+					column.requires_mask = true;
+				}
+			}
+		}
+	} catch (...) {
+		error = std::current_exception();
+	}
+	{
+		// the remaining tasks do not need the GIL: let other Python threads run while we help with them
+		// the tasks write into the arrays, so we have to wait for them even if the conversion above failed
+		py::gil_scoped_release release;
+		counter.Finish();
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+	for (auto &range : ranges) {
+		if (range.error) {
+			std::rethrow_exception(range.error);
+		}
+		if (range.may_have_null) {
+			owned_data[range.col_idx].requires_mask = true;
+		}
+	}
+	count += collection.Count();
+	for (auto &data : owned_data) {
+		data.data->count = count;
+		data.mask->count = count;
+	}
+}
+
 } // namespace duckdb
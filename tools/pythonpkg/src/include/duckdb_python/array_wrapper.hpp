@@ -12,6 +12,8 @@
 #include "duckdb.hpp"
 
 namespace duckdb {
+class TaskScheduler;
+
 struct RawArrayWrapper {
 	explicit RawArrayWrapper(const LogicalType &type);
 
@@ -37,14 +39,26 @@ public:
 	void Initialize(idx_t capacity);
 	void Resize(idx_t new_capacity);
 	void Append(idx_t current_offset, Vector &input, idx_t count);
+	//! Converts the input into the array at the given offset, without updating the count. Returns whether or not the
+	//! input may contain NULL values. Can be called by multiple threads for disjoint offsets.
+	bool Convert(idx_t current_offset, Vector &input, idx_t count);
+	//! Whether or not the conversion creates Python objects, in which case it has to hold the GIL
+	bool RequiresGIL() const;
 	py::object ToArray(idx_t count) const;
 };
 
 class NumpyResultConversion {
+public:
+	//! The number of chunks of a column that are converted by a single task
+	static constexpr idx_t NUMPY_CONVERSION_TASK_CHUNKS = 50;
+
 public:
 	NumpyResultConversion(vector<LogicalType> &types, idx_t initial_capacity);
 
 	void Append(DataChunk &chunk);
+	//! Converts all chunks of a materialized result. Columns that do not create Python objects are converted by the
+	//! threads of the task scheduler, without holding the GIL.
+	void Append(ChunkCollection &collection, TaskScheduler &scheduler);
 
 	py::object ToArray(idx_t col_idx) {
 		return owned_data[col_idx].ToArray(count);
@@ -44,7 +44,8 @@ struct NumPyArrayWrapper {
 struct PandasColumnBindData {
 	PandasType pandas_type;
 	py::array numpy_col;
-	idx_t numpy_stride;
+	//! The stride of the column in bytes, which is negative if the column is a reversed view
+	py::ssize_t numpy_stride;
 	unique_ptr<NumPyArrayWrapper> mask;
 	// Only for categorical types
 	string internal_categorical_type;
@@ -3,6 +3,7 @@
 #include "duckdb_python/pyresult.hpp"
 #include "duckdb/parser/qualified_name.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/execution/operator/helper/physical_arrow_collector.hpp"
 
 namespace duckdb {
 
@@ -445,11 +446,17 @@ py::object DuckDBPyRelation::Fetchall() {
 	return res->Fetchall();
 }
 
+//! Executes the relation with a result collector that builds the Arrow record batches while the query is executed
+static unique_ptr<QueryResult> ExecuteArrow(Relation &rel, idx_t batch_size) {
+	auto context = rel.context.GetContext();
+	return PhysicalArrowCollector::ExecuteArrow(*context, batch_size, [&]() { return rel.Execute(); });
+}
+
 py::object DuckDBPyRelation::ToArrowTable(idx_t batch_size) {
 	auto res = make_unique<DuckDBPyResult>();
 	{
 		py::gil_scoped_release release;
-		res->result = rel->Execute();
+		res->result = ExecuteArrow(*rel, batch_size);
 	}
 	if (!res->result->success) {
 		throw std::runtime_error(res->result->error);
@@ -461,7 +468,7 @@ py::object DuckDBPyRelation::ToRecordBatch(idx_t batch_size) {
 	auto res = make_unique<DuckDBPyResult>();
 	{
 		py::gil_scoped_release release;
-		res->result = rel->Execute();
+		res->result = ExecuteArrow(*rel, batch_size);
 	}
 	if (!res->result->success) {
 		throw std::runtime_error(res->result->error);
@@ -9,6 +9,9 @@
 #include "duckdb/common/types/time.hpp"
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/common/types/uuid.hpp"
+#include "duckdb/main/arrow_query_result.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb_python/array_wrapper.hpp"
 
 namespace duckdb {
@@ -261,8 +264,14 @@ py::dict DuckDBPyResult::FetchNumpyInternal(bool stream, idx_t vectors_per_chunk
 	NumpyResultConversion conversion(result->types, initial_capacity);
 	if (result->type == QueryResultType::MATERIALIZED_RESULT) {
 		auto &materialized = (MaterializedQueryResult &)*result;
-		for (auto &chunk : materialized.collection.Chunks()) {
-			conversion.Append(*chunk);
+		// the arrays are filled directly from the materialized chunks, using the threads of the database
+		auto context = materialized.context.lock();
+		if (context) {
+			conversion.Append(materialized.collection, TaskScheduler::GetScheduler(*context));
+		} else {
+			for (auto &chunk : materialized.collection.Chunks()) {
+				conversion.Append(*chunk);
+			}
 		}
 		InsertCategory(materialized, categories);
 		materialized.collection.Reset();
@@ -346,6 +355,22 @@ py::object DuckDBPyResult::FetchAllArrowChunks(idx_t chunk_size) {
 
 	py::list batches;
 
+	if (result->type == QueryResultType::ARROW_RESULT) {
+		// the record batches were already built while the query was executed
+		auto &arrow_result = (ArrowQueryResult &)*result;
+		auto batch_import_func = pyarrow_lib_module.attr("RecordBatch").attr("_import_from_c");
+		string timezone_config = QueryResult::GetConfigTimezone(*result);
+		while (true) {
+			auto array = arrow_result.FetchArray();
+			if (!array) {
+				break;
+			}
+			ArrowSchema arrow_schema;
+			QueryResult::ToArrowSchema(&arrow_schema, result->types, result->names, timezone_config);
+			batches.append(batch_import_func((uint64_t)&array->arrow_array, (uint64_t)&arrow_schema));
+		}
+		return std::move(batches);
+	}
 	if (result->type == QueryResultType::STREAM_RESULT) {
 		result = ((StreamQueryResult *)result.get())->Materialize();
 	}
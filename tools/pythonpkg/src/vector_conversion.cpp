@@ -6,41 +6,46 @@
 namespace duckdb {
 
 template <class T>
-void ScanPandasColumn(py::array &numpy_col, idx_t stride, idx_t offset, Vector &out, idx_t count) {
+void ScanPandasColumn(py::array &numpy_col, py::ssize_t stride, idx_t offset, Vector &out, idx_t count) {
 	auto src_ptr = (T *)numpy_col.data();
-	if (stride == sizeof(T)) {
+	if (stride == py::ssize_t(sizeof(T))) {
 		FlatVector::SetData(out, (data_ptr_t)(src_ptr + offset));
 	} else {
+		// the stride can be negative, e.g. for a reversed view of an array
+		auto src_stride = stride / py::ssize_t(sizeof(T));
 		auto tgt_ptr = (T *)FlatVector::GetData(out);
 		for (idx_t i = 0; i < count; i++) {
-			tgt_ptr[i] = src_ptr[stride / sizeof(T) * (i + offset)];
+			tgt_ptr[i] = src_ptr[src_stride * py::ssize_t(i + offset)];
 		}
 	}
 }
 
 template <class T, class V>
-void ScanPandasCategoryTemplated(py::array &column, idx_t offset, Vector &out, idx_t count) {
+void ScanPandasCategoryTemplated(py::array &column, py::ssize_t stride, idx_t offset, Vector &out, idx_t count) {
 	auto src_ptr = (T *)column.data();
+	auto src_stride = stride / py::ssize_t(sizeof(T));
 	auto tgt_ptr = (V *)FlatVector::GetData(out);
 	auto &tgt_mask = FlatVector::Validity(out);
 	for (idx_t i = 0; i < count; i++) {
-		if (src_ptr[i + offset] == -1) {
+		auto code = src_ptr[src_stride * py::ssize_t(i + offset)];
+		if (code == -1) {
 			// Null value
 			tgt_mask.SetInvalid(i);
 		} else {
-			tgt_ptr[i] = src_ptr[i + offset];
+			tgt_ptr[i] = code;
 		}
 	}
 }
 
 template <class T>
-void ScanPandasCategory(py::array &column, idx_t count, idx_t offset, Vector &out, string &src_type) {
+void ScanPandasCategory(py::array &column, py::ssize_t stride, idx_t count, idx_t offset, Vector &out,
+                        string &src_type) {
 	if (src_type == "int8") {
-		ScanPandasCategoryTemplated<int8_t, T>(column, offset, out, count);
+		ScanPandasCategoryTemplated<int8_t, T>(column, stride, offset, out, count);
 	} else if (src_type == "int16") {
-		ScanPandasCategoryTemplated<int16_t, T>(column, offset, out, count);
+		ScanPandasCategoryTemplated<int16_t, T>(column, stride, offset, out, count);
 	} else if (src_type == "int32") {
-		ScanPandasCategoryTemplated<int32_t, T>(column, offset, out, count);
+		ScanPandasCategoryTemplated<int32_t, T>(column, stride, offset, out, count);
 	} else {
 		throw NotImplementedException("The Pandas type " + src_type + " for categorical types is not implemented yet");
 	}
@@ -77,8 +82,8 @@ bool ValueIsNull(double value) {
 }
 
 template <class T>
-void ScanPandasFpColumn(T *src_ptr, idx_t count, idx_t offset, Vector &out) {
-	FlatVector::SetData(out, (data_ptr_t)(src_ptr + offset));
+void ScanPandasFpColumn(py::array &numpy_col, py::ssize_t stride, idx_t count, idx_t offset, Vector &out) {
+	ScanPandasColumn<T>(numpy_col, stride, offset, out, count);
 	auto tgt_ptr = FlatVector::GetData<T>(out);
 	auto &mask = FlatVector::Validity(out);
 	for (idx_t i = 0; i < count; i++) {
@@ -143,18 +148,19 @@ void VectorConversion::NumpyToDuckDB(PandasColumnBindData &bind_data, py::array
 		ScanPandasMasked<int64_t>(bind_data, count, offset, out);
 		break;
 	case PandasType::FLOAT:
-		ScanPandasFpColumn<float>((float *)numpy_col.data(), count, offset, out);
+		ScanPandasFpColumn<float>(numpy_col, bind_data.numpy_stride, count, offset, out);
 		break;
 	case PandasType::DOUBLE:
-		ScanPandasFpColumn<double>((double *)numpy_col.data(), count, offset, out);
+		ScanPandasFpColumn<double>(numpy_col, bind_data.numpy_stride, count, offset, out);
 		break;
 	case PandasType::TIMESTAMP: {
 		auto src_ptr = (int64_t *)numpy_col.data();
+		auto src_stride = bind_data.numpy_stride / py::ssize_t(sizeof(int64_t));
 		auto tgt_ptr = FlatVector::GetData<timestamp_t>(out);
 		auto &mask = FlatVector::Validity(out);
 
 		for (idx_t row = 0; row < count; row++) {
-			auto source_idx = offset + row;
+			auto source_idx = src_stride * py::ssize_t(offset + row);
 			if (src_ptr[source_idx] <= NumericLimits<int64_t>::Minimum()) {
 				// pandas Not a Time (NaT)
 				mask.SetInvalid(row);
@@ -166,11 +172,12 @@ void VectorConversion::NumpyToDuckDB(PandasColumnBindData &bind_data, py::array
 	}
 	case PandasType::INTERVAL: {
 		auto src_ptr = (int64_t *)numpy_col.data();
+		auto src_stride = bind_data.numpy_stride / py::ssize_t(sizeof(int64_t));
 		auto tgt_ptr = FlatVector::GetData<interval_t>(out);
 		auto &mask = FlatVector::Validity(out);
 
 		for (idx_t row = 0; row < count; row++) {
-			auto source_idx = offset + row;
+			auto source_idx = src_stride * py::ssize_t(offset + row);
 			if (src_ptr[source_idx] <= NumericLimits<int64_t>::Minimum()) {
 				// pandas Not a Time (NaT)
 				mask.SetInvalid(row);
@@ -192,11 +199,12 @@ void VectorConversion::NumpyToDuckDB(PandasColumnBindData &bind_data, py::array
 	case PandasType::VARCHAR:
 	case PandasType::OBJECT: {
 		auto src_ptr = (PyObject **)numpy_col.data();
+		auto src_stride = bind_data.numpy_stride / py::ssize_t(sizeof(PyObject *));
 		auto tgt_ptr = FlatVector::GetData<string_t>(out);
 		auto &out_mask = FlatVector::Validity(out);
 		unique_ptr<PythonGILWrapper> gil;
 		for (idx_t row = 0; row < count; row++) {
-			auto source_idx = offset + row;
+			auto source_idx = src_stride * py::ssize_t(offset + row);
 			PyObject *val = src_ptr[source_idx];
 			if (bind_data.pandas_type == PandasType::OBJECT && !PyUnicode_CheckExact(val)) {
 				if (val == Py_None) {
@@ -269,13 +277,16 @@ void VectorConversion::NumpyToDuckDB(PandasColumnBindData &bind_data, py::array
 	case PandasType::CATEGORY: {
 		switch (out.GetType().InternalType()) {
 		case PhysicalType::UINT8:
-			ScanPandasCategory<uint8_t>(numpy_col, count, offset, out, bind_data.internal_categorical_type);
+			ScanPandasCategory<uint8_t>(numpy_col, bind_data.numpy_stride, count, offset, out,
+			                            bind_data.internal_categorical_type);
 			break;
 		case PhysicalType::UINT16:
-			ScanPandasCategory<uint16_t>(numpy_col, count, offset, out, bind_data.internal_categorical_type);
+			ScanPandasCategory<uint16_t>(numpy_col, bind_data.numpy_stride, count, offset, out,
+			                            bind_data.internal_categorical_type);
 			break;
 		case PhysicalType::UINT32:
-			ScanPandasCategory<uint32_t>(numpy_col, count, offset, out, bind_data.internal_categorical_type);
+			ScanPandasCategory<uint32_t>(numpy_col, bind_data.numpy_stride, count, offset, out,
+			                            bind_data.internal_categorical_type);
 			break;
 		default:
 			throw InternalException("Invalid Physical Type for ENUMs");
@@ -412,7 +423,7 @@ void VectorConversion::BindPandas(py::handle df, vector<PandasColumnBindData> &b
 			}
 		}
 		D_ASSERT(py::hasattr(bind_data.numpy_col, "strides"));
-		bind_data.numpy_stride = bind_data.numpy_col.attr("strides").attr("__getitem__")(0).cast<idx_t>();
+		bind_data.numpy_stride = bind_data.numpy_col.attr("strides").attr("__getitem__")(0).cast<py::ssize_t>();
 		return_types.push_back(duckdb_col_type);
 		bind_columns.push_back(move(bind_data));
 	}
@@ -0,0 +1,29 @@
+import duckdb
+import pandas as pd
+import numpy as np
+
+class TestParallelResultConversion(object):
+    def test_parallel_fetchdf(self, duckdb_cursor):
+        con = duckdb.connect()
+        con.execute("PRAGMA threads=4")
+        con.execute("CREATE TYPE mood AS ENUM ('sad', 'ok', 'happy')")
+        con.execute("""CREATE TABLE tbl AS SELECT i, CASE WHEN i % 5 = 0 THEN NULL ELSE i * 0.5 END AS d,
+            (i % 1000)::VARCHAR AS s, (['sad', 'ok', 'happy'])[i % 3 + 1]::mood AS m,
+            TIMESTAMP '2000-01-01' + INTERVAL (i) SECOND AS ts FROM range(300000) t(i)""")
+        df = con.execute("SELECT * FROM tbl ORDER BY i").fetchdf()
+        assert len(df) == 300000
+        assert (df['i'].to_numpy() == np.arange(300000)).all()
+        assert df['d'].isna().sum() == 60000
+        assert df['d'][7] == 3.5
+        assert df['s'][123456] == '456'
+        assert str(df['m'].dtype) == 'category'
+        assert list(df['m'][:3]) == ['sad', 'ok', 'happy']
+        assert df['ts'][299999] == pd.Timestamp('2000-01-04 11:19:59')
+
+    def test_parallel_fetchnumpy(self, duckdb_cursor):
+        con = duckdb.connect()
+        con.execute("PRAGMA threads=4")
+        res = con.execute("SELECT i, CASE WHEN i % 2 = 0 THEN i END AS j FROM range(200000) t(i)").fetchnumpy()
+        assert res['i'].sum() == 19999900000
+        assert res['j'].count() == 100000
+        assert res['j'].sum() == 9999900000
@@ -10,4 +10,35 @@ class TestPandasStride(object):
         con.register('df_view', expected_df)
         output_df = con.execute("SELECT * FROM df_view;").fetchdf()
         pd.testing.assert_frame_equal(expected_df, output_df)
-   
\ No newline at end of file
+   
+    def test_stride_fp(self, duckdb_cursor):
+        expected_df = pd.DataFrame(np.arange(20, dtype='float64').reshape(5, 4), columns=["a", "b", "c", "d"])
+        expected_df.loc[2, 'b'] = np.nan
+        con = duckdb.connect()
+        con.register('df_view', expected_df)
+        output_df = con.execute("SELECT * FROM df_view;").fetchdf()
+        pd.testing.assert_frame_equal(expected_df, output_df)
+        assert con.execute("SELECT COUNT(b), SUM(c) FROM df_view").fetchall() == [(4, 50.0)]
+
+    def test_stride_timestamp(self, duckdb_cursor):
+        expected_df = pd.DataFrame(np.arange(20, dtype='int64').reshape(5, 4).astype('datetime64[s]').astype('datetime64[ns]'), columns=["a", "b", "c", "d"])
+        con = duckdb.connect()
+        con.register('df_view', expected_df)
+        output_df = con.execute("SELECT * FROM df_view;").fetchdf()
+        pd.testing.assert_frame_equal(expected_df, output_df)
+
+    def test_stride_object(self, duckdb_cursor):
+        expected_df = pd.DataFrame(np.array([str(i) for i in range(20)], dtype=object).reshape(5, 4), columns=["a", "b", "c", "d"])
+        con = duckdb.connect()
+        con.register('df_view', expected_df)
+        output_df = con.execute("SELECT * FROM df_view;").fetchdf()
+        pd.testing.assert_frame_equal(expected_df, output_df)
+
+    def test_stride_negative(self, duckdb_cursor):
+        # a reversed view of an array has a negative stride
+        expected_df = pd.DataFrame(np.arange(20, dtype='float64').reshape(5, 4)[::-1], columns=["a", "b", "c", "d"])
+        con = duckdb.connect()
+        con.register('df_view', expected_df)
+        output_df = con.execute("SELECT * FROM df_view;").fetchdf()
+        pd.testing.assert_frame_equal(expected_df.reset_index(drop=True), output_df)
+        assert con.execute("SELECT a FROM df_view LIMIT 1").fetchall() == [(16.0,)]